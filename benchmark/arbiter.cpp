@@ -0,0 +1,238 @@
+#include <disruptorplus/single_threaded_claim_strategy.hpp>
+#include <disruptorplus/spin_wait_strategy.hpp>
+#include <disruptorplus/ring_buffer.hpp>
+#include <disruptorplus/feed_arbiter.hpp>
+#include <disruptorplus/tsc_clock.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace disruptorplus;
+
+namespace
+{
+    struct message
+    {
+        uint64_t m_feedSequence;
+        uint64_t m_payload[7];
+    };
+
+    struct message_feed_sequence
+    {
+        uint64_t operator()(const message& m) const { return m.m_feedSequence; }
+    };
+
+    // Deterministic xorshift64* generator.
+    class random
+    {
+    public:
+
+        explicit random(uint64_t seed)
+        : m_state(seed != 0 ? seed : 0x9E3779B97F4A7C15ull)
+        {}
+
+        uint64_t next()
+        {
+            m_state ^= m_state >> 12;
+            m_state ^= m_state << 25;
+            m_state ^= m_state >> 27;
+            return m_state * 0x2545F4914F6CDD1Dull;
+        }
+
+    private:
+
+        uint64_t m_state;
+
+    };
+
+    typedef single_threaded_claim_strategy<spin_wait_strategy> claim_strategy;
+    typedef feed_arbiter<message, spin_wait_strategy, claim_strategy, message_feed_sequence> arbiter;
+
+    // Whether line (0 or 1) drops the message with feed sequence number i.
+    //
+    // Each line drops messages independently so some are dropped by both.
+    // The last message is never dropped so that the feed has no trailing gap.
+    bool Dropped(int line, uint64_t i, uint64_t dropEvery, uint64_t messageCount)
+    {
+        if (dropEvery == 0 || i + 1 == messageCount)
+        {
+            return false;
+        }
+        random rng(i * 2 + static_cast<uint64_t>(line) + 1);
+        return rng.next() % dropEvery == 0;
+    }
+
+    void PrintHeader()
+    {
+        std::cout << "Window" << ", "
+                  << "DropEvery" << ", "
+                  << "Messages/Sec" << ", "
+                  << "WonA" << ", "
+                  << "WonB" << ", "
+                  << "Duplicates" << ", "
+                  << "GapFills" << ", "
+                  << "Gaps" << ", "
+                  << "Lost" << std::endl;
+    }
+
+    // line A producer, line B producer -> arbiter -> consumer
+    void Run(size_t window, uint64_t dropEvery, size_t bufferSize, uint64_t messageCount)
+    {
+        spin_wait_strategy waitStrategy;
+        claim_strategy lineAClaim(bufferSize, waitStrategy);
+        claim_strategy lineBClaim(bufferSize, waitStrategy);
+        claim_strategy outputClaim(bufferSize, waitStrategy);
+        ring_buffer<message> lineA(bufferSize);
+        ring_buffer<message> lineB(bufferSize);
+        ring_buffer<message> output(bufferSize);
+        sequence_barrier<spin_wait_strategy> consumed(waitStrategy);
+        outputClaim.add_claim_barrier(consumed);
+
+        arbiter arb(waitStrategy, lineA, lineB, outputClaim, output, window);
+        lineAClaim.add_claim_barrier(arb.consumed(arbiter::line_a));
+        lineBClaim.add_claim_barrier(arb.consumed(arbiter::line_b));
+
+        // Messages dropped by both lines are always lost. Others may be
+        // lost too if one line runs more than a window ahead of the other.
+        uint64_t droppedByBoth = 0;
+        for (uint64_t i = 0; i < messageCount; ++i)
+        {
+            if (Dropped(0, i, dropEvery, messageCount) && Dropped(1, i, dropEvery, messageCount))
+            {
+                ++droppedByBoth;
+            }
+        }
+
+        std::atomic<int> producersDone(0);
+        auto produce = [&](int line, claim_strategy& claimStrategy, ring_buffer<message>& buffer)
+        {
+            for (uint64_t i = 0; i < messageCount; ++i)
+            {
+                if (Dropped(line, i, dropEvery, messageCount))
+                {
+                    continue;
+                }
+                const sequence_t seq = claimStrategy.claim_one();
+                buffer[seq].m_feedSequence = i;
+                buffer[seq].m_payload[0] = i * 3;
+                claimStrategy.publish(seq);
+            }
+            ++producersDone;
+        };
+
+        std::atomic<sequence_t> emittedCount(0);
+        bool ordered = true;
+        std::thread consumer([&]()
+        {
+            uint64_t lastFeedSequence = 0;
+            bool first = true;
+            sequence_t nextToRead = 0;
+            for (;;)
+            {
+                const sequence_t available = outputClaim.wait_until_published(nextToRead);
+                do
+                {
+                    const message& m = output[nextToRead];
+                    if ((!first && m.m_feedSequence <= lastFeedSequence) ||
+                        m.m_payload[0] != m.m_feedSequence * 3)
+                    {
+                        ordered = false;
+                    }
+                    first = false;
+                    lastFeedSequence = m.m_feedSequence;
+                } while (nextToRead++ != available);
+                consumed.publish(available);
+                if (lastFeedSequence + 1 == messageCount)
+                {
+                    break;
+                }
+            }
+            emittedCount = nextToRead;
+        });
+
+        const auto start = tsc_clock::now();
+        std::thread producerA(produce, 0, std::ref(lineAClaim), std::ref(lineA));
+        std::thread producerB(produce, 1, std::ref(lineBClaim), std::ref(lineB));
+
+        arb.run(lineAClaim, lineBClaim, messageCount - 1);
+        consumer.join();
+        const auto elapsed = tsc_clock::now_ordered() - start;
+        const double elapsedNS = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+
+        // Read the slower line's trailing duplicates so that it is not left
+        // blocked on a full ring, and so that the line counters add up.
+        while (producersDone.load() < 2)
+        {
+            arb.poll(lineAClaim, lineBClaim);
+        }
+        arb.poll(lineAClaim, lineBClaim);
+        producerA.join();
+        producerB.join();
+
+        const feed_line_statistics& a = arb.statistics(arbiter::line_a);
+        const feed_line_statistics& b = arb.statistics(arbiter::line_b);
+        if (!ordered ||
+            arb.emitted() != emittedCount ||
+            arb.emitted() + arb.lost() != messageCount ||
+            arb.lost() < droppedByBoth ||
+            a.m_won + b.m_won != arb.emitted() ||
+            a.m_won + a.m_duplicates != a.m_received ||
+            b.m_won + b.m_duplicates != b.m_received)
+        {
+            throw std::domain_error("Unexpected test result.");
+        }
+
+        std::cout << window << ", "
+                  << dropEvery << ", "
+                  << static_cast<uint64_t>(messageCount * 1e9 / elapsedNS) << ", "
+                  << a.m_won << ", "
+                  << b.m_won << ", "
+                  << a.m_duplicates + b.m_duplicates << ", "
+                  << a.m_gapFills + b.m_gapFills << ", "
+                  << arb.gaps() << ", "
+                  << arb.lost() << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    // Calibrate the clock so that timestamps read the TSC rather than
+    // steady_clock.
+    disruptorplus::tsc_clock::calibrate();
+
+    const uint64_t messageCount = argc > 1 ? std::max(1, std::atoi(argv[1])) : 10 * 1000 * 1000;
+    const size_t bufferSize = 64 * 1024;
+
+    std::cout << "Feed Arbitration Benchmark" << std::endl
+              << "Usage: arbiter [message-count]" << std::endl
+              << "Message count: " << messageCount << std::endl
+              << "Buffer size: " << bufferSize << std::endl;
+
+    try
+    {
+        PrintHeader();
+
+        for (size_t window : { 1024, 16384 })
+        {
+            for (uint64_t dropEvery : { 0, 10000, 100 })
+            {
+                Run(window, dropEvery, bufferSize, messageCount);
+            }
+        }
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
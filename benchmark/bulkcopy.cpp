@@ -0,0 +1,199 @@
+#include <disruptorplus/single_threaded_claim_strategy.hpp>
+#include <disruptorplus/spin_wait_strategy.hpp>
+#include <disruptorplus/ring_buffer.hpp>
+#include <disruptorplus/streaming_copy.hpp>
+#include <disruptorplus/tsc_clock.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace disruptorplus;
+
+namespace
+{
+    template<size_t Size>
+    struct payload
+    {
+        uint64_t m_words[Size / 8];
+    };
+
+    const char* KernelName(streaming_copy_kernel kernel)
+    {
+        switch (kernel)
+        {
+        case streaming_copy_kernel::avx512: return "avx512";
+        case streaming_copy_kernel::avx2: return "avx2";
+        case streaming_copy_kernel::sse2: return "sse2";
+        default: return "memcpy";
+        }
+    }
+
+    int64_t NowNS()
+    {
+        return tsc_clock::now().time_since_epoch().count();
+    }
+
+    void PrintHeader()
+    {
+        std::cout << "PayloadBytes" << ", "
+                  << "Copy" << ", "
+                  << "Events/Sec" << ", "
+                  << "MB/Sec" << ", "
+                  << "ProducerWorkNS/Batch" << std::endl;
+    }
+
+    // producer (copying batches from a staging area, then doing some work
+    // on its own cached data) -> consumer (which reads every payload)
+    //
+    // ProducerWorkNS/Batch shows how much the copies evicted the
+    // producer's working set.
+    template<size_t Size>
+    void Run(bool streaming, size_t bufferSize, size_t batchSize, size_t workingSetBytes, uint64_t eventCount)
+    {
+        typedef payload<Size> event;
+
+        spin_wait_strategy waitStrategy;
+        single_threaded_claim_strategy<spin_wait_strategy> claimStrategy(bufferSize, waitStrategy);
+        sequence_barrier<spin_wait_strategy> consumed(waitStrategy);
+        claimStrategy.add_claim_barrier(consumed);
+        ring_buffer<event> buffer(bufferSize);
+
+        std::vector<event> staging(batchSize);
+        std::vector<uint64_t> workingSet(workingSetBytes / sizeof(uint64_t), 1);
+
+        const uint64_t batchCount = std::max<uint64_t>(1, eventCount / batchSize);
+        const uint64_t totalEvents = batchCount * batchSize;
+        const sequence_t last = static_cast<sequence_t>(totalEvents - 1);
+        uint64_t sum = 0;
+
+        std::thread consumer([&]()
+        {
+            sequence_t nextToRead = 0;
+            while (difference(nextToRead, last) <= 0)
+            {
+                const sequence_t available = claimStrategy.wait_until_published(nextToRead);
+                do
+                {
+                    const event& e = buffer[nextToRead];
+                    for (size_t i = 0; i < Size / 8; i += 8)
+                    {
+                        sum += e.m_words[i];
+                    }
+                } while (nextToRead++ != available);
+                consumed.publish(available);
+            }
+        });
+
+        int64_t workNS = 0;
+        uint64_t expected = 0;
+        uint64_t workSum = 0;
+        const auto start = tsc_clock::now();
+        for (uint64_t b = 0; b < batchCount; ++b)
+        {
+            for (size_t i = 0; i < batchSize; ++i)
+            {
+                const uint64_t value = b * batchSize + i;
+                for (size_t w = 0; w < Size / 8; w += 8)
+                {
+                    staging[i].m_words[w] = value;
+                }
+                expected += value * (Size / 64);
+            }
+
+            if (streaming)
+            {
+                publish_copy(claimStrategy, buffer, staging.data(), batchSize);
+            }
+            else
+            {
+                size_t copied = 0;
+                while (copied < batchSize)
+                {
+                    const sequence_range range = claimStrategy.claim(batchSize - copied);
+                    for (size_t i = 0; i < range.size(); ++i)
+                    {
+                        std::memcpy(&buffer[range[i]], &staging[copied + i], sizeof(event));
+                    }
+                    claimStrategy.publish(range);
+                    copied += range.size();
+                }
+            }
+
+            const int64_t workStart = NowNS();
+            for (size_t i = 0; i < workingSet.size(); i += 8)
+            {
+                workSum += workingSet[i];
+            }
+            workNS += NowNS() - workStart;
+        }
+
+        consumer.join();
+        const auto elapsed = tsc_clock::now_ordered() - start;
+        const double elapsedNS = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+
+        if (sum != expected || workSum != batchCount * (workingSet.size() / 8))
+        {
+            throw std::domain_error("Unexpected test result.");
+        }
+
+        std::cout << Size << ", "
+                  << (streaming ? KernelName(streaming_copy::kernel()) : "memcpy") << ", "
+                  << static_cast<uint64_t>(totalEvents * 1e9 / elapsedNS) << ", "
+                  << static_cast<uint64_t>(totalEvents * Size * 1e9 / elapsedNS / (1024 * 1024)) << ", "
+                  << workNS / static_cast<int64_t>(batchCount) << std::endl;
+    }
+
+    template<size_t Size>
+    void RunBoth(size_t bufferSize, size_t batchSize, size_t workingSetBytes, uint64_t bytes)
+    {
+        const uint64_t eventCount = std::max<uint64_t>(1, bytes / Size);
+        Run<Size>(false, bufferSize, batchSize, workingSetBytes, eventCount);
+        Run<Size>(true, bufferSize, batchSize, workingSetBytes, eventCount);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    // Calibrate the clock so that timestamps read the TSC rather than
+    // steady_clock.
+    disruptorplus::tsc_clock::calibrate();
+
+    const uint64_t megabytes = argc > 1 ? std::max(1, std::atoi(argv[1])) : 4096;
+    const size_t bufferSize = 4 * 1024;
+    const size_t batchSize = 16;
+    const size_t workingSetBytes = 256 * 1024;
+
+    std::cout << "Bulk Copy Benchmark" << std::endl
+              << "Usage: bulkcopy [megabytes-per-run]" << std::endl
+              << "Megabytes per run: " << megabytes << std::endl
+              << "Buffer size: " << bufferSize << std::endl
+              << "Batch size: " << batchSize << std::endl
+              << "Producer working set: " << workingSetBytes << " bytes" << std::endl
+              << "Streaming kernel: " << KernelName(streaming_copy::kernel()) << std::endl;
+
+    try
+    {
+        PrintHeader();
+
+        const uint64_t bytes = megabytes * 1024 * 1024;
+        RunBoth<256>(bufferSize, batchSize, workingSetBytes, bytes);
+        RunBoth<1024>(bufferSize, batchSize, workingSetBytes, bytes);
+        RunBoth<4096>(bufferSize, batchSize, workingSetBytes, bytes);
+        RunBoth<16384>(bufferSize, batchSize, workingSetBytes, bytes);
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,226 @@
+#include <disruptorplus/single_threaded_claim_strategy.hpp>
+#include <disruptorplus/spin_wait_strategy.hpp>
+#include <disruptorplus/ring_buffer.hpp>
+#include <disruptorplus/prefetch.hpp>
+#include <disruptorplus/tsc_clock.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+using namespace disruptorplus;
+
+namespace
+{
+    struct body
+    {
+        uint64_t m_words[8];
+    };
+
+    struct event
+    {
+        uint64_t m_value;
+        const body* m_body;
+        uint64_t m_padding[6];
+    };
+
+    // Deterministic xorshift64* generator.
+    class random
+    {
+    public:
+
+        explicit random(uint64_t seed)
+        : m_state(seed != 0 ? seed : 0x9E3779B97F4A7C15ull)
+        {}
+
+        uint64_t next()
+        {
+            m_state ^= m_state >> 12;
+            m_state ^= m_state << 25;
+            m_state ^= m_state >> 27;
+            return m_state * 0x2545F4914F6CDD1Dull;
+        }
+
+    private:
+
+        uint64_t m_state;
+
+    };
+
+    // A random permutation of 0 to count - 1.
+    std::vector<uint32_t> ShuffledOrder(size_t count, uint64_t seed)
+    {
+        std::vector<uint32_t> order(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            order[i] = static_cast<uint32_t>(i);
+        }
+        random rng(seed);
+        for (size_t i = count - 1; i > 0; --i)
+        {
+            std::swap(order[i], order[rng.next() % (i + 1)]);
+        }
+        return order;
+    }
+
+    struct body_address
+    {
+        const void* operator()(const event& e) const { return e.m_body; }
+    };
+
+    void PrintHeader()
+    {
+        std::cout << "RingBytes" << ", "
+                  << "Payload" << ", "
+                  << "Prefetch" << ", "
+                  << "Events/Sec" << ", "
+                  << "NS/Event" << std::endl;
+    }
+
+    // Read enough unrelated memory to push the ring out of the caches, as
+    // if the consumer had been busy with something else while the backlog
+    // built up.
+    void EvictCaches(std::vector<uint64_t>& scratch)
+    {
+        uint64_t sum = 0;
+        for (size_t i = 0; i < scratch.size(); i += 8)
+        {
+            sum += scratch[i]++;
+        }
+        volatile uint64_t sink = sum;
+        (void)sink;
+    }
+
+    // producer fills the ring -> consumer drains the backlog
+    //
+    // Both run on one thread so only the consumer's catch-up is timed.
+    void Run(
+        size_t ringBytes,
+        bool indirect,
+        size_t distance,
+        std::vector<uint64_t>& scratch,
+        const std::vector<body>& bodies,
+        const std::vector<uint32_t>& bodyOrder)
+    {
+        const size_t bufferSize = ringBytes / sizeof(event);
+        spin_wait_strategy waitStrategy;
+        single_threaded_claim_strategy<spin_wait_strategy> claimStrategy(bufferSize, waitStrategy);
+        sequence_barrier<spin_wait_strategy> consumed(waitStrategy);
+        claimStrategy.add_claim_barrier(consumed);
+        ring_buffer<event> buffer(bufferSize);
+
+        uint64_t expected = 0;
+        size_t published = 0;
+        while (published < bufferSize)
+        {
+            const sequence_range range = claimStrategy.claim(bufferSize - published);
+            for (size_t i = 0; i < range.size(); ++i)
+            {
+                event& e = buffer[range[i]];
+                e.m_value = published + i;
+                e.m_body = &bodies[bodyOrder[(published + i) % bodyOrder.size()]];
+                expected += indirect ? e.m_body->m_words[0] : e.m_value;
+            }
+            claimStrategy.publish(range);
+            published += range.size();
+        }
+
+        EvictCaches(scratch);
+
+        uint64_t sum = 0;
+        const auto start = tsc_clock::now();
+        sequence_t nextToRead = 0;
+        const sequence_t last = static_cast<sequence_t>(bufferSize - 1);
+        while (difference(nextToRead, last) <= 0)
+        {
+            const sequence_t available = claimStrategy.wait_until_published(nextToRead);
+            if (indirect)
+            {
+                for_each_prefetched(buffer, nextToRead, available,
+                    [&](const event& e) { sum += e.m_body->m_words[0]; },
+                    distance, body_address());
+            }
+            else
+            {
+                for_each_prefetched(buffer, nextToRead, available,
+                    [&](const event& e) { sum += e.m_value; },
+                    distance);
+            }
+            consumed.publish(available);
+            nextToRead = available + 1;
+        }
+        const auto elapsed = tsc_clock::now_ordered() - start;
+        const double elapsedNS = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+
+        if (sum != expected)
+        {
+            throw std::domain_error("Unexpected test result.");
+        }
+
+        std::cout << ringBytes << ", "
+                  << (indirect ? "indirect" : "inline") << ", "
+                  << distance << ", "
+                  << static_cast<uint64_t>(bufferSize * 1e9 / elapsedNS) << ", "
+                  << elapsedNS / bufferSize << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    // Calibrate the clock so that timestamps read the TSC rather than
+    // steady_clock.
+    disruptorplus::tsc_clock::calibrate();
+
+    const size_t maxRingMB = argc > 1 ? std::max(1, std::atoi(argv[1])) : 1024;
+    const size_t minRingBytes = 64 * 1024;
+    const size_t maxRingBytes = maxRingMB * 1024 * 1024;
+    const size_t scratchBytes = 256 * 1024 * 1024;
+    const size_t distances[] = { 0, 8, 32 };
+
+    std::cout << "Catch-up Benchmark" << std::endl
+              << "Usage: catchup [max-ring-megabytes]" << std::endl
+              << "Ring sizes: " << minRingBytes << " to " << maxRingBytes << " bytes" << std::endl
+              << "Event size: " << sizeof(event) << " bytes" << std::endl
+              << "Body size: " << sizeof(body) << " bytes, in random order" << std::endl;
+
+    try
+    {
+        std::vector<uint64_t> scratch(scratchBytes / sizeof(uint64_t), 1);
+
+        // Bodies are shared between runs and visited in a random order so
+        // the hardware prefetchers cannot follow them.
+        const size_t bodyCount = std::max<size_t>(1, maxRingBytes / sizeof(event));
+        std::vector<body> bodies(bodyCount);
+        for (size_t i = 0; i < bodyCount; ++i)
+        {
+            bodies[i].m_words[0] = i;
+        }
+        const std::vector<uint32_t> bodyOrder = ShuffledOrder(bodyCount, 1);
+
+        PrintHeader();
+
+        for (size_t ringBytes = minRingBytes; ringBytes <= maxRingBytes; ringBytes *= 4)
+        {
+            for (bool indirect : { false, true })
+            {
+                for (size_t distance : distances)
+                {
+                    Run(ringBytes, indirect, distance, scratch, bodies, bodyOrder);
+                }
+            }
+        }
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
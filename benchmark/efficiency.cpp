@@ -0,0 +1,192 @@
+#include <disruptorplus/single_threaded_claim_strategy.hpp>
+#include <disruptorplus/blocking_wait_strategy.hpp>
+#include <disruptorplus/spin_wait_strategy.hpp>
+#include <disruptorplus/ring_buffer.hpp>
+#include <disruptorplus/tsc_clock.hpp>
+
+#include "platform.hpp"
+#include "stats.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+
+using namespace disruptorplus;
+
+namespace
+{
+    struct event
+    {
+        int64_t m_publishedNS;
+        bool m_last;
+    };
+
+    int64_t NowNS()
+    {
+        return tsc_clock::now().time_since_epoch().count();
+    }
+
+    // Gaps between events longer than this are slept through rather than
+    // spun so that the producer does not compete with the consumer for CPU
+    // at low offered loads.
+    const tsc_clock::duration producerSpinThreshold = std::chrono::microseconds(50);
+
+    void PrintHeader()
+    {
+        std::cout << "WaitStrategy" << ", "
+                  << "OfferedEvents/Sec" << ", "
+                  << "AchievedEvents/Sec" << ", "
+                  << "ConsumerCPU%" << ", "
+                  << "CPUNS/Event" << ", "
+                  << "VoluntarySwitches" << ", "
+                  << "InvoluntarySwitches" << ", "
+                  << "WakeupP50NS" << ", "
+                  << "WakeupP99NS" << ", "
+                  << "LatencyP50NS" << ", "
+                  << "LatencyP99NS" << ", "
+                  << "LatencyMaxNS" << std::endl;
+    }
+
+    // Publish events at a fixed offered rate for the given duration and
+    // measure how much CPU the consumer thread burns to keep up, how often
+    // it is switched out and how long events wait before it sees them.
+    //
+    // The wake-up latency is measured on the first event of each batch,
+    // which is the event the consumer was waiting for. The latency of
+    // other events in the batch also includes queueing behind it.
+    template<typename WaitStrategy>
+    void RunLoad(const char* name, uint64_t eventsPerSecond, int64_t durationMS, size_t bufferSize)
+    {
+        WaitStrategy waitStrategy;
+        single_threaded_claim_strategy<WaitStrategy> claimStrategy(bufferSize, waitStrategy);
+        sequence_barrier<WaitStrategy> consumed(waitStrategy);
+        claimStrategy.add_claim_barrier(consumed);
+        ring_buffer<event> buffer(bufferSize);
+
+        const uint64_t eventCount = std::max<uint64_t>(1, eventsPerSecond * durationMS / 1000);
+
+        benchmark::histogram wakeupLatency;
+        benchmark::histogram latency;
+        benchmark::thread_usage consumerUsage;
+        uint64_t consumedCount = 0;
+
+        std::thread consumer([&]()
+        {
+            const benchmark::thread_usage usageStart = benchmark::current_thread_usage();
+            sequence_t nextToRead = 0;
+            bool done = false;
+            while (!done)
+            {
+                const sequence_t available = claimStrategy.wait_until_published(nextToRead);
+                const int64_t readNS = NowNS();
+                wakeupLatency.record(readNS - buffer[nextToRead].m_publishedNS);
+                do
+                {
+                    const event& e = buffer[nextToRead];
+                    latency.record(readNS - e.m_publishedNS);
+                    done = done || e.m_last;
+                    ++consumedCount;
+                } while (nextToRead++ != available);
+                consumed.publish(available);
+            }
+            consumerUsage = benchmark::current_thread_usage() - usageStart;
+        });
+
+        // Give the consumer a chance to start waiting.
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+        const double intervalNS = 1e9 / static_cast<double>(eventsPerSecond);
+        const auto start = tsc_clock::now();
+        for (uint64_t i = 0; i < eventCount; ++i)
+        {
+            const auto due = start + tsc_clock::duration(static_cast<int64_t>(i * intervalNS));
+            const auto remaining = due - tsc_clock::now();
+            if (remaining > producerSpinThreshold)
+            {
+                std::this_thread::sleep_for(remaining - producerSpinThreshold);
+            }
+            while (tsc_clock::now() < due)
+            {
+            }
+
+            const sequence_t seq = claimStrategy.claim_one();
+            event& e = buffer[seq];
+            e.m_last = (i + 1 == eventCount);
+            e.m_publishedNS = NowNS();
+            claimStrategy.publish(seq);
+        }
+
+        consumer.join();
+        const auto elapsed = tsc_clock::now_ordered() - start;
+        const double elapsedNS = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+
+        if (consumedCount != eventCount)
+        {
+            throw std::domain_error("Unexpected test result.");
+        }
+
+        std::cout << std::fixed << std::setprecision(1)
+                  << name << ", "
+                  << eventsPerSecond << ", "
+                  << static_cast<uint64_t>(eventCount * 1e9 / elapsedNS) << ", "
+                  << 100.0 * consumerUsage.cpuNS / elapsedNS << ", "
+                  << static_cast<double>(consumerUsage.cpuNS) / eventCount << ", "
+                  << consumerUsage.voluntarySwitches << ", "
+                  << consumerUsage.involuntarySwitches << ", "
+                  << wakeupLatency.percentile(50) << ", "
+                  << wakeupLatency.percentile(99) << ", "
+                  << latency.percentile(50) << ", "
+                  << latency.percentile(99) << ", "
+                  << latency.max() << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    // Calibrate the clock so that timestamps read the TSC rather than
+    // steady_clock.
+    disruptorplus::tsc_clock::calibrate();
+
+    const size_t bufferSize = 64 * 1024;
+    const int64_t durationMS = argc > 1 ? std::max(1, std::atoi(argv[1])) : 1000;
+    const uint64_t offeredLoads[] = {
+        1000,
+        10 * 1000,
+        100 * 1000,
+        1000 * 1000,
+        10 * 1000 * 1000,
+        50 * 1000 * 1000
+    };
+
+    std::cout << "Wait Strategy Efficiency Benchmark" << std::endl
+              << "Usage: efficiency [duration-ms]" << std::endl
+              << "Buffer size: " << bufferSize << std::endl
+              << "Duration per load: " << durationMS << "ms" << std::endl;
+
+    if (!benchmark::platform_supported())
+    {
+        std::cout << "error: per-thread CPU usage is not available on this platform" << std::endl;
+        return 1;
+    }
+
+    try
+    {
+        PrintHeader();
+        for (uint64_t load : offeredLoads)
+        {
+            RunLoad<spin_wait_strategy>("spin_wait_strategy", load, durationMS, bufferSize);
+            RunLoad<blocking_wait_strategy>("blocking_wait_strategy", load, durationMS, bufferSize);
+        }
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,808 @@
+#include <disruptorplus/single_threaded_claim_strategy.hpp>
+#include <disruptorplus/sequence_barrier_group.hpp>
+#include <disruptorplus/blocking_wait_strategy.hpp>
+#include <disruptorplus/spin_wait_strategy.hpp>
+#include <disruptorplus/ring_buffer.hpp>
+#include <disruptorplus/tsc_clock.hpp>
+
+#include "stats.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace disruptorplus;
+
+// A macro benchmark modelled on an exchange's order-entry path:
+//
+//   feed -> decode -> risk[0..N) -> match -> { journal, publish }
+//
+// The feed thread generates a seeded stream of text-encoded orders, the
+// decoder parses them in place, a pool of risk workers each check the
+// orders of the traders they own, the matching engine runs a price-time
+// priority order book in sequence order and the journal and publish
+// stages serialise the results in parallel.
+//
+// All state is a function of the seed so every run produces the same
+// digest, which is checked against a single-threaded reference pass.
+
+namespace
+{
+    enum stage
+    {
+        stage_generated,
+        stage_decoded,
+        stage_risk_checked,
+        stage_matched,
+        stage_journaled,
+        stage_published,
+        stage_count
+    };
+
+    enum risk_result
+    {
+        risk_pending,
+        risk_accepted,
+        risk_rejected_decode,
+        risk_rejected_quantity,
+        risk_rejected_price,
+        risk_rejected_credit
+    };
+
+    struct order
+    {
+        uint64_t m_orderId;
+        uint32_t m_trader;
+        int32_t m_price;
+        uint32_t m_quantity;
+        char m_side;
+    };
+
+    struct event
+    {
+        // Written by the feed.
+        char m_raw[64];
+        uint32_t m_rawLength;
+
+        // Written by the decoder.
+        order m_order;
+
+        // Written by the owning risk worker.
+        uint8_t m_risk;
+
+        // Written by the matching engine.
+        uint32_t m_filledQuantity;
+        uint32_t m_fillCount;
+        bool m_rested;
+
+        // Each stage stamps its own entry when it has finished with the event.
+        int64_t m_stampNS[stage_count];
+    };
+
+    int64_t NowNS()
+    {
+        return tsc_clock::now().time_since_epoch().count();
+    }
+
+    const uint32_t traderCount = 64;
+    const int32_t referencePrice = 10000;
+    const int32_t priceBand = 200;
+    const uint32_t maxQuantity = 1000;
+
+    // Deterministic xorshift64* generator.
+    class random
+    {
+    public:
+
+        explicit random(uint64_t seed)
+        : m_state(seed != 0 ? seed : 0x9E3779B97F4A7C15ull)
+        {}
+
+        uint64_t next()
+        {
+            m_state ^= m_state >> 12;
+            m_state ^= m_state << 25;
+            m_state ^= m_state >> 27;
+            return m_state * 0x2545F4914F6CDD1Dull;
+        }
+
+        uint32_t next(uint32_t bound)
+        {
+            return static_cast<uint32_t>((next() >> 32) % bound);
+        }
+
+    private:
+
+        uint64_t m_state;
+
+    };
+
+    char* AppendUInt(char* out, uint64_t value)
+    {
+        char digits[20];
+        int count = 0;
+        do
+        {
+            digits[count++] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value != 0);
+        while (count > 0)
+        {
+            *out++ = digits[--count];
+        }
+        return out;
+    }
+
+    // Generates a random walk of order flow around the reference price,
+    // text-encoded as "D|orderId|trader|side|price|quantity".
+    class feed_generator
+    {
+    public:
+
+        explicit feed_generator(uint64_t seed)
+        : m_random(seed)
+        , m_mid(referencePrice)
+        , m_nextOrderId(1)
+        {}
+
+        void next(event& e)
+        {
+            if (m_random.next(4) == 0)
+            {
+                m_mid += static_cast<int32_t>(m_random.next(3)) - 1;
+                m_mid = std::max(referencePrice - 150, std::min(referencePrice + 150, m_mid));
+            }
+
+            const bool buy = m_random.next(2) == 0;
+            // Mostly passive, occasionally aggressive, rarely outside the band.
+            int32_t offset = static_cast<int32_t>(m_random.next(12)) - 3;
+            if (m_random.next(1000) == 0)
+            {
+                offset += 2 * priceBand;
+            }
+            const int32_t price = buy ? m_mid - offset : m_mid + offset;
+            const uint32_t quantity = m_random.next(100) == 0
+                ? maxQuantity + 1 + m_random.next(maxQuantity)
+                : 1 + m_random.next(200);
+
+            char* out = e.m_raw;
+            *out++ = 'D';
+            *out++ = '|';
+            out = AppendUInt(out, m_nextOrderId++);
+            *out++ = '|';
+            out = AppendUInt(out, m_random.next(traderCount));
+            *out++ = '|';
+            *out++ = buy ? 'B' : 'S';
+            *out++ = '|';
+            out = AppendUInt(out, static_cast<uint64_t>(price));
+            *out++ = '|';
+            out = AppendUInt(out, quantity);
+            e.m_rawLength = static_cast<uint32_t>(out - e.m_raw);
+        }
+
+    private:
+
+        random m_random;
+        int32_t m_mid;
+        uint64_t m_nextOrderId;
+
+    };
+
+    bool ParseUInt(const char*& in, const char* end, uint64_t& value)
+    {
+        value = 0;
+        const char* start = in;
+        while (in != end && *in >= '0' && *in <= '9')
+        {
+            value = value * 10 + static_cast<uint64_t>(*in++ - '0');
+        }
+        return in != start;
+    }
+
+    bool Expect(const char*& in, const char* end, char c)
+    {
+        if (in == end || *in != c)
+        {
+            return false;
+        }
+        ++in;
+        return true;
+    }
+
+    // Parses e.m_raw into e.m_order. Returns false if the message is malformed.
+    bool Decode(event& e)
+    {
+        std::memset(&e.m_order, 0, sizeof(e.m_order));
+        const char* in = e.m_raw;
+        const char* end = e.m_raw + e.m_rawLength;
+        uint64_t orderId, trader, price, quantity;
+        char side;
+        if (!Expect(in, end, 'D') || !Expect(in, end, '|') ||
+            !ParseUInt(in, end, orderId) || !Expect(in, end, '|') ||
+            !ParseUInt(in, end, trader) || !Expect(in, end, '|') ||
+            in == end || ((side = *in++) != 'B' && side != 'S') || !Expect(in, end, '|') ||
+            !ParseUInt(in, end, price) || !Expect(in, end, '|') ||
+            !ParseUInt(in, end, quantity) || in != end ||
+            trader >= traderCount)
+        {
+            return false;
+        }
+        e.m_order.m_orderId = orderId;
+        e.m_order.m_trader = static_cast<uint32_t>(trader);
+        e.m_order.m_price = static_cast<int32_t>(price);
+        e.m_order.m_quantity = static_cast<uint32_t>(quantity);
+        e.m_order.m_side = side;
+        return true;
+    }
+
+    // Per-trader pre-trade risk state. Credit refills at a fixed rate per
+    // sequence number so the result depends only on the order stream.
+    //
+    // Padded to a cache line as neighbouring traders are owned by
+    // different risk workers.
+    struct trader_risk
+    {
+        int64_t m_credit;
+        sequence_t m_lastSequence;
+        uint64_t m_orderCount;
+        char m_padding[64 - 3 * sizeof(int64_t)];
+    };
+
+    const int64_t maxCredit = 2000;
+    const int64_t creditPerSequence = 8;
+
+    uint8_t CheckRisk(trader_risk& risk, sequence_t seq, const order& o)
+    {
+        if (o.m_quantity > maxQuantity)
+        {
+            return risk_rejected_quantity;
+        }
+        if (o.m_price < referencePrice - priceBand || o.m_price > referencePrice + priceBand)
+        {
+            return risk_rejected_price;
+        }
+
+        const int64_t elapsed = static_cast<int64_t>(seq - risk.m_lastSequence);
+        risk.m_credit = std::min(maxCredit, risk.m_credit + elapsed * creditPerSequence);
+        risk.m_lastSequence = seq;
+        ++risk.m_orderCount;
+
+        if (risk.m_credit < static_cast<int64_t>(o.m_quantity))
+        {
+            return risk_rejected_credit;
+        }
+        risk.m_credit -= o.m_quantity;
+        return risk_accepted;
+    }
+
+    // A price-time priority limit order book over the tradable price band.
+    // Each price level holds a bounded FIFO of resting orders, orders that
+    // would overflow a level are not rested.
+    class order_book
+    {
+    public:
+
+        order_book()
+        : m_bids(levelCount)
+        , m_asks(levelCount)
+        , m_bestBid(-1)
+        , m_bestAsk(levelCount)
+        {}
+
+        void match(event& e)
+        {
+            const order& o = e.m_order;
+            const int level = o.m_price - (referencePrice - priceBand);
+            uint32_t remaining = o.m_quantity;
+            e.m_filledQuantity = 0;
+            e.m_fillCount = 0;
+
+            if (o.m_side == 'B')
+            {
+                while (remaining > 0 && m_bestAsk <= level)
+                {
+                    take(m_asks[m_bestAsk], remaining, e);
+                    while (m_bestAsk < levelCount && m_asks[m_bestAsk].m_count == 0)
+                    {
+                        ++m_bestAsk;
+                    }
+                }
+                e.m_rested = remaining > 0 && rest(m_bids[level], o, remaining);
+                if (e.m_rested && level > m_bestBid)
+                {
+                    m_bestBid = level;
+                }
+            }
+            else
+            {
+                while (remaining > 0 && m_bestBid >= level)
+                {
+                    take(m_bids[m_bestBid], remaining, e);
+                    while (m_bestBid >= 0 && m_bids[m_bestBid].m_count == 0)
+                    {
+                        --m_bestBid;
+                    }
+                }
+                e.m_rested = remaining > 0 && rest(m_asks[level], o, remaining);
+                if (e.m_rested && level < m_bestAsk)
+                {
+                    m_bestAsk = level;
+                }
+            }
+        }
+
+    private:
+
+        static const int levelCount = 2 * priceBand + 1;
+        static const uint32_t levelCapacity = 32;
+
+        struct resting_order
+        {
+            uint64_t m_orderId;
+            uint32_t m_quantity;
+        };
+
+        struct level
+        {
+            level() : m_head(0), m_count(0) {}
+
+            resting_order m_orders[levelCapacity];
+            uint32_t m_head;
+            uint32_t m_count;
+        };
+
+        static void take(level& l, uint32_t& remaining, event& e)
+        {
+            while (remaining > 0 && l.m_count > 0)
+            {
+                resting_order& resting = l.m_orders[l.m_head];
+                const uint32_t fill = std::min(remaining, resting.m_quantity);
+                resting.m_quantity -= fill;
+                remaining -= fill;
+                e.m_filledQuantity += fill;
+                ++e.m_fillCount;
+                if (resting.m_quantity == 0)
+                {
+                    l.m_head = (l.m_head + 1) % levelCapacity;
+                    --l.m_count;
+                }
+            }
+        }
+
+        static bool rest(level& l, const order& o, uint32_t remaining)
+        {
+            if (l.m_count == levelCapacity)
+            {
+                return false;
+            }
+            resting_order& resting = l.m_orders[(l.m_head + l.m_count) % levelCapacity];
+            resting.m_orderId = o.m_orderId;
+            resting.m_quantity = remaining;
+            ++l.m_count;
+            return true;
+        }
+
+        std::vector<level> m_bids;
+        std::vector<level> m_asks;
+        int m_bestBid;
+        int m_bestAsk;
+
+    };
+
+    uint64_t Fnv1a(uint64_t hash, const void* data, size_t size)
+    {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i)
+        {
+            hash = (hash ^ bytes[i]) * 0x100000001B3ull;
+        }
+        return hash;
+    }
+
+    const uint64_t fnvOffsetBasis = 0xCBF29CE484222325ull;
+
+    // Appends a fixed-size binary record per event to an in-memory
+    // circular journal.
+    class journal
+    {
+    public:
+
+        journal()
+        : m_data(new unsigned char[journalBytes])
+        , m_offset(0)
+        , m_hash(fnvOffsetBasis)
+        {}
+
+        void append(const event& e)
+        {
+            record r;
+            std::memset(&r, 0, sizeof(r));
+            r.m_orderId = e.m_order.m_orderId;
+            r.m_trader = e.m_order.m_trader;
+            r.m_price = e.m_order.m_price;
+            r.m_quantity = e.m_order.m_quantity;
+            r.m_filledQuantity = e.m_filledQuantity;
+            r.m_fillCount = e.m_fillCount;
+            r.m_side = e.m_order.m_side;
+            r.m_risk = e.m_risk;
+            r.m_rested = e.m_rested ? 1 : 0;
+
+            std::memcpy(m_data.get() + m_offset, &r, sizeof(r));
+            m_offset = (m_offset + sizeof(r)) % journalBytes;
+            m_hash = Fnv1a(m_hash, &r, sizeof(r));
+        }
+
+        uint64_t hash() const { return m_hash; }
+
+    private:
+
+        struct record
+        {
+            uint64_t m_orderId;
+            uint32_t m_trader;
+            int32_t m_price;
+            uint32_t m_quantity;
+            uint32_t m_filledQuantity;
+            uint32_t m_fillCount;
+            char m_side;
+            uint8_t m_risk;
+            uint8_t m_rested;
+        };
+
+        static const size_t journalBytes = 4096 * sizeof(record);
+
+        std::unique_ptr<unsigned char[]> m_data;
+        size_t m_offset;
+        uint64_t m_hash;
+
+    };
+
+    // Formats a text execution report for each event.
+    class publisher
+    {
+    public:
+
+        publisher()
+        : m_hash(fnvOffsetBasis)
+        , m_acceptedCount(0)
+        , m_fillCount(0)
+        {}
+
+        void publish(const event& e)
+        {
+            char report[128];
+            const int length = std::snprintf(
+                report, sizeof(report),
+                "8=FIX.4.2|35=8|37=%llu|1=%u|54=%c|44=%d|38=%u|14=%u|39=%c|58=%u",
+                static_cast<unsigned long long>(e.m_order.m_orderId),
+                e.m_order.m_trader,
+                e.m_order.m_side,
+                e.m_order.m_price,
+                e.m_order.m_quantity,
+                e.m_filledQuantity,
+                e.m_risk != risk_accepted ? '8' : e.m_filledQuantity == e.m_order.m_quantity ? '2' : e.m_filledQuantity > 0 ? '1' : '0',
+                static_cast<unsigned>(e.m_risk));
+            m_hash = Fnv1a(m_hash, report, static_cast<size_t>(length));
+            if (e.m_risk == risk_accepted)
+            {
+                ++m_acceptedCount;
+            }
+            m_fillCount += e.m_fillCount;
+        }
+
+        uint64_t hash() const { return m_hash; }
+        uint64_t accepted_count() const { return m_acceptedCount; }
+        uint64_t fill_count() const { return m_fillCount; }
+
+    private:
+
+        uint64_t m_hash;
+        uint64_t m_acceptedCount;
+        uint64_t m_fillCount;
+
+    };
+
+    struct run_summary
+    {
+        uint64_t m_digest;
+        uint64_t m_acceptedCount;
+        uint64_t m_fillCount;
+    };
+
+    // Runs every stage in sequence on one thread to produce the digest the
+    // pipelined run must reproduce.
+    run_summary RunReference(uint64_t seed, uint64_t eventCount)
+    {
+        feed_generator feed(seed);
+        std::vector<trader_risk> risk(traderCount, trader_risk());
+        std::unique_ptr<order_book> book(new order_book());
+        journal j;
+        publisher p;
+
+        event e;
+        for (sequence_t seq = 0; seq < eventCount; ++seq)
+        {
+            feed.next(e);
+            e.m_risk = Decode(e)
+                ? CheckRisk(risk[e.m_order.m_trader], seq, e.m_order)
+                : static_cast<uint8_t>(risk_rejected_decode);
+            e.m_filledQuantity = 0;
+            e.m_fillCount = 0;
+            e.m_rested = false;
+            if (e.m_risk == risk_accepted)
+            {
+                book->match(e);
+            }
+            j.append(e);
+            p.publish(e);
+        }
+
+        const run_summary summary = { j.hash() ^ p.hash(), p.accepted_count(), p.fill_count() };
+        return summary;
+    }
+
+    void PrintHeader()
+    {
+        std::cout << "WaitStrategy" << ", "
+                  << "OfferedEvents/Sec" << ", "
+                  << "AchievedEvents/Sec" << ", "
+                  << "Stage" << ", "
+                  << "P50NS" << ", "
+                  << "P99NS" << ", "
+                  << "P99.9NS" << ", "
+                  << "MaxNS" << std::endl;
+    }
+
+    template<typename WaitStrategy>
+    void RunExchange(
+        const char* name,
+        uint64_t seed,
+        uint64_t eventCount,
+        uint64_t eventsPerSecond,
+        int riskWorkerCount,
+        const run_summary& expected)
+    {
+        const size_t bufferSize = 64 * 1024;
+
+        WaitStrategy waitStrategy;
+        single_threaded_claim_strategy<WaitStrategy> claimStrategy(bufferSize, waitStrategy);
+        sequence_barrier<WaitStrategy> decoded(waitStrategy);
+        std::vector<std::unique_ptr<sequence_barrier<WaitStrategy>>> riskChecked(riskWorkerCount);
+        sequence_barrier_group<WaitStrategy> allRiskChecked(waitStrategy);
+        for (auto& barrier : riskChecked)
+        {
+            barrier.reset(new sequence_barrier<WaitStrategy>(waitStrategy));
+            allRiskChecked.add(*barrier);
+        }
+        sequence_barrier<WaitStrategy> matched(waitStrategy);
+        sequence_barrier<WaitStrategy> journaled(waitStrategy);
+        sequence_barrier<WaitStrategy> published(waitStrategy);
+        sequence_barrier_group<WaitStrategy> completed(waitStrategy);
+        completed.add(journaled);
+        completed.add(published);
+        claimStrategy.add_claim_barrier(completed);
+        ring_buffer<event> buffer(bufferSize);
+
+        std::vector<trader_risk> risk(traderCount, trader_risk());
+        std::unique_ptr<order_book> book(new order_book());
+        journal j;
+        publisher p;
+
+        benchmark::histogram stageLatency[stage_count];
+        benchmark::histogram endToEndLatency;
+
+        // Runs a consumer stage over every event, calling handler(seq, event)
+        // for each and stamping the event's completion time for this stage.
+        auto runStage = [&](stage s, std::function<sequence_t(sequence_t)> waitFor,
+                            sequence_barrier<WaitStrategy>& done,
+                            std::function<void(sequence_t, event&)> handler)
+        {
+            return std::thread([&, s, waitFor, handler]()
+            {
+                sequence_t nextToRead = 0;
+                while (nextToRead < eventCount)
+                {
+                    const sequence_t available = waitFor(nextToRead);
+                    do
+                    {
+                        event& e = buffer[nextToRead];
+                        handler(nextToRead, e);
+                        e.m_stampNS[s] = NowNS();
+                    } while (nextToRead++ != available);
+                    done.publish(available);
+                }
+            });
+        };
+
+        std::vector<std::thread> threads;
+
+        threads.push_back(runStage(
+            stage_decoded,
+            [&](sequence_t seq) { return claimStrategy.wait_until_published(seq); },
+            decoded,
+            [&](sequence_t, event& e)
+            {
+                e.m_risk = Decode(e) ? risk_pending : risk_rejected_decode;
+                e.m_filledQuantity = 0;
+                e.m_fillCount = 0;
+                e.m_rested = false;
+            }));
+
+        // Each risk worker owns the traders congruent to its index and skips
+        // other traders' orders. Only the owner stamps the event.
+        for (int worker = 0; worker < riskWorkerCount; ++worker)
+        {
+            auto& done = *riskChecked[worker];
+            threads.emplace_back([&, worker]()
+            {
+                sequence_t nextToRead = 0;
+                while (nextToRead < eventCount)
+                {
+                    const sequence_t available = decoded.wait_until_published(nextToRead);
+                    do
+                    {
+                        event& e = buffer[nextToRead];
+                        if (e.m_risk != risk_rejected_decode
+                            ? static_cast<int>(e.m_order.m_trader % riskWorkerCount) == worker
+                            : worker == 0)
+                        {
+                            if (e.m_risk == risk_pending)
+                            {
+                                e.m_risk = CheckRisk(risk[e.m_order.m_trader], nextToRead, e.m_order);
+                            }
+                            e.m_stampNS[stage_risk_checked] = NowNS();
+                        }
+                    } while (nextToRead++ != available);
+                    done.publish(available);
+                }
+            });
+        }
+
+        threads.push_back(runStage(
+            stage_matched,
+            [&](sequence_t seq) { return allRiskChecked.wait_until_published(seq); },
+            matched,
+            [&](sequence_t, event& e)
+            {
+                if (e.m_risk == risk_accepted)
+                {
+                    book->match(e);
+                }
+            }));
+
+        threads.push_back(runStage(
+            stage_journaled,
+            [&](sequence_t seq) { return matched.wait_until_published(seq); },
+            journaled,
+            [&](sequence_t, event& e)
+            {
+                j.append(e);
+                stageLatency[stage_journaled].record(NowNS() - e.m_stampNS[stage_matched]);
+            }));
+
+        // The publish stage records the latency of every stage that precedes
+        // it, as those stamps are guaranteed visible once the event has been
+        // matched.
+        threads.push_back(runStage(
+            stage_published,
+            [&](sequence_t seq) { return matched.wait_until_published(seq); },
+            published,
+            [&](sequence_t, event& e)
+            {
+                p.publish(e);
+                const int64_t now = NowNS();
+                stageLatency[stage_decoded].record(e.m_stampNS[stage_decoded] - e.m_stampNS[stage_generated]);
+                stageLatency[stage_risk_checked].record(e.m_stampNS[stage_risk_checked] - e.m_stampNS[stage_decoded]);
+                stageLatency[stage_matched].record(e.m_stampNS[stage_matched] - e.m_stampNS[stage_risk_checked]);
+                stageLatency[stage_published].record(now - e.m_stampNS[stage_matched]);
+                endToEndLatency.record(now - e.m_stampNS[stage_generated]);
+            }));
+
+        feed_generator feed(seed);
+        const double intervalNS = eventsPerSecond > 0 ? 1e9 / static_cast<double>(eventsPerSecond) : 0;
+        const auto start = tsc_clock::now();
+        for (uint64_t i = 0; i < eventCount; ++i)
+        {
+            if (intervalNS > 0)
+            {
+                const auto due = start + tsc_clock::duration(static_cast<int64_t>(i * intervalNS));
+                while (tsc_clock::now() < due)
+                {
+                }
+            }
+
+            const sequence_t seq = claimStrategy.claim_one();
+            event& e = buffer[seq];
+            feed.next(e);
+            e.m_stampNS[stage_generated] = NowNS();
+            claimStrategy.publish(seq);
+        }
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        const auto elapsed = tsc_clock::now_ordered() - start;
+        const double elapsedNS = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+
+        if ((j.hash() ^ p.hash()) != expected.m_digest ||
+            p.accepted_count() != expected.m_acceptedCount ||
+            p.fill_count() != expected.m_fillCount)
+        {
+            throw std::domain_error("Unexpected test result.");
+        }
+
+        const char* stageNames[stage_count] = { "feed", "decode", "risk", "match", "journal", "publish" };
+        const uint64_t achieved = static_cast<uint64_t>(eventCount * 1e9 / elapsedNS);
+        auto printStage = [&](const char* stageName, const benchmark::histogram& latency)
+        {
+            std::cout << name << ", "
+                      << eventsPerSecond << ", "
+                      << achieved << ", "
+                      << stageName << ", "
+                      << latency.percentile(50) << ", "
+                      << latency.percentile(99) << ", "
+                      << latency.percentile(99.9) << ", "
+                      << latency.max() << std::endl;
+        };
+        for (int s = stage_decoded; s < stage_count; ++s)
+        {
+            printStage(stageNames[s], stageLatency[s]);
+        }
+        printStage("end-to-end", endToEndLatency);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    // Calibrate the clock so that timestamps read the TSC rather than
+    // steady_clock.
+    disruptorplus::tsc_clock::calibrate();
+
+    const uint64_t eventCount = argc > 1 ? std::max(1, std::atoi(argv[1])) : 2 * 1000 * 1000;
+    const uint64_t pacedEventsPerSecond = argc > 2 ? std::max(1, std::atoi(argv[2])) : 500 * 1000;
+    const int riskWorkerCount = argc > 3 ? std::max(1, std::atoi(argv[3])) : 2;
+    const uint64_t seed = argc > 4 ? std::strtoull(argv[4], nullptr, 0) : 42;
+
+    std::cout << "Exchange Order Path Macro Benchmark" << std::endl
+              << "Usage: exchange [event-count [paced-events-per-sec [risk-workers [seed]]]]" << std::endl
+              << "Event count: " << eventCount << std::endl
+              << "Risk workers: " << riskWorkerCount << std::endl
+              << "Seed: " << seed << std::endl;
+
+    try
+    {
+        const run_summary expected = RunReference(seed, eventCount);
+        std::cout << "Digest: " << std::hex << expected.m_digest << std::dec
+                  << " (accepted " << expected.m_acceptedCount
+                  << ", fills " << expected.m_fillCount << ")" << std::endl;
+
+        PrintHeader();
+
+#define BENCHMARK(WS, RATE) \
+        RunExchange<disruptorplus::WS>(#WS, seed, eventCount, RATE, riskWorkerCount, expected)
+
+        // A rate of zero publishes as fast as the pipeline will accept.
+        BENCHMARK(spin_wait_strategy, 0);
+        BENCHMARK(spin_wait_strategy, pacedEventsPerSecond);
+        BENCHMARK(blocking_wait_strategy, 0);
+        BENCHMARK(blocking_wait_strategy, pacedEventsPerSecond);
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
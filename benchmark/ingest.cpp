@@ -0,0 +1,350 @@
+#include <disruptorplus/single_threaded_claim_strategy.hpp>
+#include <disruptorplus/spin_wait_strategy.hpp>
+#include <disruptorplus/ring_buffer.hpp>
+#include <disruptorplus/tsc_clock.hpp>
+
+#include "platform.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#if defined(__linux__)
+
+#include <disruptorplus/io_message.hpp>
+#include <disruptorplus/slot_reader.hpp>
+#include <disruptorplus/io_uring_source.hpp>
+
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+
+using namespace disruptorplus;
+
+namespace
+{
+    const size_t MessageSize = 256;
+    const size_t SlotCapacity = 4096;
+
+    typedef io_message<SlotCapacity> message;
+
+    enum class reader_kind
+    {
+        copy,
+        vectored,
+        uring
+    };
+
+    const char* ReaderName(reader_kind kind, bool isDatagram)
+    {
+        switch (kind)
+        {
+        case reader_kind::vectored: return isDatagram ? "recvmmsg" : "readv";
+        case reader_kind::uring: return "io_uring";
+        default: return isDatagram ? "recv+copy" : "read+copy";
+        }
+    }
+
+    void PrintHeader()
+    {
+        std::cout << "Transport" << ", "
+                  << "Reader" << ", "
+                  << "Slots/Sec" << ", "
+                  << "MB/Sec" << ", "
+                  << "BytesPerSlot" << ", "
+                  << "Tombstones" << ", "
+                  << "ReaderCpuNS/KB" << std::endl;
+    }
+
+    // Byte i of the stream is i % 251 so that reordering or loss is caught.
+    uint8_t PatternByte(uint64_t position)
+    {
+        return static_cast<uint8_t>(position % 251);
+    }
+
+    void CheckedWrite(int fd, const char* data, size_t size)
+    {
+        while (size > 0)
+        {
+            const ssize_t result = ::write(fd, data, size);
+            if (result < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                throw std::system_error(errno, std::system_category(), "write");
+            }
+            data += result;
+            size -= static_cast<size_t>(result);
+        }
+    }
+
+    // Writes messageCount messages of MessageSize bytes, one write each,
+    // then closes the fd to signal end-of-stream.
+    void Send(int fd, uint64_t messageCount)
+    {
+        char data[MessageSize];
+        uint64_t position = 0;
+        for (uint64_t i = 0; i < messageCount; ++i)
+        {
+            for (size_t j = 0; j < MessageSize; ++j)
+            {
+                data[j] = static_cast<char>(PatternByte(position++));
+            }
+            CheckedWrite(fd, data, MessageSize);
+        }
+        ::close(fd);
+    }
+
+    // reader -> ring -> consumer
+    //
+    // The consumer checks the byte pattern of every non-tombstone slot.
+    void Run(const char* transport, bool isDatagram, int fd, reader_kind kind, size_t bufferSize, uint64_t messageCount)
+    {
+        spin_wait_strategy waitStrategy;
+        single_threaded_claim_strategy<spin_wait_strategy> claimStrategy(bufferSize, waitStrategy);
+        sequence_barrier<spin_wait_strategy> consumed(waitStrategy);
+        claimStrategy.add_claim_barrier(consumed);
+        ring_buffer<message> buffer(bufferSize);
+
+        const uint64_t totalBytes = messageCount * MessageSize;
+        uint64_t tombstones = 0;
+        bool ok = true;
+
+        // Published once the reader is done, as the slot count is not
+        // known up-front for byte streams.
+        sequence_t endSequence = static_cast<sequence_t>(-1);
+        std::atomic<bool> done(false);
+
+        std::thread consumer([&]()
+        {
+            uint64_t position = 0;
+            sequence_t nextToRead = 0;
+            for (;;)
+            {
+                const sequence_t available = claimStrategy.wait_until_published(
+                    nextToRead, std::chrono::milliseconds(1));
+                if (difference(available, nextToRead) < 0)
+                {
+                    if (done.load(std::memory_order_acquire) && nextToRead == endSequence)
+                    {
+                        break;
+                    }
+                    continue;
+                }
+                do
+                {
+                    const message& m = buffer[nextToRead];
+                    if (m.is_tombstone())
+                    {
+                        ++tombstones;
+                        continue;
+                    }
+                    for (uint32_t i = 0; i < m.m_size; ++i)
+                    {
+                        if (static_cast<uint8_t>(m.m_data[i]) != PatternByte(position + i))
+                        {
+                            ok = false;
+                        }
+                    }
+                    position += m.m_size;
+                } while (nextToRead++ != available);
+                consumed.publish(available);
+            }
+            ok = ok && position == totalBytes;
+        });
+
+        const auto start = tsc_clock::now();
+        const benchmark::thread_usage before = benchmark::current_thread_usage();
+        if (kind == reader_kind::copy)
+        {
+            // The baseline reads into a buffer on the stack and copies each
+            // chunk into a claimed slot.
+            char data[64 * 1024];
+            uint64_t received = 0;
+            while (received < totalBytes)
+            {
+                const ssize_t bytes = isDatagram ?
+                    ::recv(fd, data, sizeof(data), 0) :
+                    ::read(fd, data, sizeof(data));
+                if (bytes < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+                    throw std::system_error(errno, std::system_category(), "read");
+                }
+                if (bytes == 0)
+                {
+                    break;
+                }
+                for (ssize_t i = 0; i < bytes; )
+                {
+                    const size_t n = std::min(SlotCapacity, static_cast<size_t>(bytes - i));
+                    const sequence_t seq = claimStrategy.claim_one();
+                    message& m = buffer[seq];
+                    std::memcpy(m.m_data, data + i, n);
+                    m.m_size = static_cast<uint32_t>(n);
+                    claimStrategy.publish(seq);
+                    i += static_cast<ssize_t>(n);
+                }
+                received += static_cast<uint64_t>(bytes);
+            }
+        }
+        else if (kind == reader_kind::vectored)
+        {
+            slot_reader<message, single_threaded_claim_strategy<spin_wait_strategy>> reader(claimStrategy, buffer);
+            if (isDatagram)
+            {
+                for (uint64_t received = 0; received < messageCount; )
+                {
+                    received += reader.receive(fd);
+                }
+            }
+            else
+            {
+                while (!reader.eof())
+                {
+                    reader.read(fd);
+                }
+            }
+            reader.flush();
+        }
+        else
+        {
+            io_uring_source<message, single_threaded_claim_strategy<spin_wait_strategy>> source(claimStrategy, buffer, fd);
+            source.run();
+        }
+        const int64_t readerCpuNS = (benchmark::current_thread_usage() - before).cpuNS;
+
+        endSequence = static_cast<sequence_t>(claimStrategy.last_published() + 1);
+        done.store(true, std::memory_order_release);
+        consumer.join();
+        const auto elapsed = tsc_clock::now_ordered() - start;
+        const double elapsedNS = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+
+        if (!ok)
+        {
+            throw std::domain_error("Unexpected test result.");
+        }
+
+        const uint64_t filledSlots = std::max<uint64_t>(1, endSequence - tombstones);
+        std::cout << transport << ", "
+                  << ReaderName(kind, isDatagram) << ", "
+                  << static_cast<uint64_t>(filledSlots * 1e9 / elapsedNS) << ", "
+                  << static_cast<uint64_t>(totalBytes * 1e9 / elapsedNS / (1024 * 1024)) << ", "
+                  << totalBytes / filledSlots << ", "
+                  << tombstones << ", "
+                  << readerCpuNS * 1024 / static_cast<int64_t>(totalBytes) << std::endl;
+    }
+
+    void RunTransport(bool isDatagram, reader_kind kind, size_t bufferSize, uint64_t messageCount)
+    {
+        int fds[2];
+        if (isDatagram)
+        {
+            if (::socketpair(AF_UNIX, SOCK_DGRAM, 0, fds) != 0)
+            {
+                throw std::system_error(errno, std::system_category(), "socketpair");
+            }
+            // Give the receiver room to batch.
+            const int size = 4 * 1024 * 1024;
+            ::setsockopt(fds[0], SOL_SOCKET, SO_RCVBUF, &size, sizeof(size));
+            ::setsockopt(fds[1], SOL_SOCKET, SO_SNDBUF, &size, sizeof(size));
+        }
+        else
+        {
+            if (::pipe(fds) != 0)
+            {
+                throw std::system_error(errno, std::system_category(), "pipe");
+            }
+            ::fcntl(fds[1], F_SETPIPE_SZ, 1024 * 1024);
+        }
+
+        std::thread sender([&]() { Send(fds[1], messageCount); });
+        try
+        {
+            Run(isDatagram ? "dgram" : "pipe", isDatagram, fds[0], kind, bufferSize, messageCount);
+        }
+        catch (...)
+        {
+            ::close(fds[0]);
+            sender.join();
+            throw;
+        }
+        ::close(fds[0]);
+        sender.join();
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    // Calibrate the clock so that timestamps read the TSC rather than
+    // steady_clock.
+    disruptorplus::tsc_clock::calibrate();
+
+    const uint64_t messageCount = argc > 1 ? std::max(1, std::atoi(argv[1])) : 1000 * 1000;
+    const size_t bufferSize = 4 * 1024;
+
+    std::cout << "Ingest Benchmark" << std::endl
+              << "Usage: ingest [message-count]" << std::endl
+              << "Message count: " << messageCount << " (" << MessageSize << " bytes each)" << std::endl
+              << "Slot capacity: " << SlotCapacity << " bytes" << std::endl
+              << "Buffer size: " << bufferSize << std::endl;
+
+    try
+    {
+        bool uringSupported = true;
+        try
+        {
+            io_uring_queue probe(1);
+        }
+        catch (std::system_error& e)
+        {
+            std::cout << "io_uring unsupported: " << e.what() << std::endl;
+            uringSupported = false;
+        }
+
+        PrintHeader();
+
+        RunTransport(true, reader_kind::copy, bufferSize, messageCount);
+        RunTransport(true, reader_kind::vectored, bufferSize, messageCount);
+        RunTransport(false, reader_kind::copy, bufferSize, messageCount);
+        RunTransport(false, reader_kind::vectored, bufferSize, messageCount);
+        if (uringSupported)
+        {
+            RunTransport(false, reader_kind::uring, bufferSize, messageCount);
+        }
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+#else
+
+int main()
+{
+    std::cout << "Ingest Benchmark" << std::endl
+              << "unsupported: slot readers are only available on Linux" << std::endl;
+    return 0;
+}
+
+#endif
@@ -0,0 +1,330 @@
+#include <disruptorplus/single_threaded_claim_strategy.hpp>
+#include <disruptorplus/multi_threaded_claim_strategy.hpp>
+#include <disruptorplus/blocking_wait_strategy.hpp>
+#include <disruptorplus/spin_wait_strategy.hpp>
+#include <disruptorplus/ring_buffer.hpp>
+#include <disruptorplus/tsc_clock.hpp>
+
+#include "stats.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace disruptorplus;
+
+namespace
+{
+    struct event
+    {
+        int64_t m_publishedNS;
+        bool m_last;
+    };
+
+    int64_t NowNS()
+    {
+        return tsc_clock::now().time_since_epoch().count();
+    }
+
+    // The mix of interference threads to run alongside a measurement.
+    struct interference_config
+    {
+        const char* name;
+
+        // Threads that repeatedly stream through a buffer larger than the
+        // last-level cache, evicting the disruptor's working set.
+        int streamers;
+
+        // Threads that busy-loop, oversubscribing the cores.
+        int spinners;
+
+        // Threads that alternate between short sleeps and short bursts of
+        // work, causing frequent wake-ups and preemption of other threads.
+        int sleepers;
+    };
+
+    // Runs a set of interference threads for the lifetime of the object.
+    class interference
+    {
+    public:
+
+        interference(const interference_config& config, size_t streamBytes)
+        : m_stop(false)
+        {
+            for (int i = 0; i < config.streamers; ++i)
+            {
+                m_threads.emplace_back([this, streamBytes]() { stream(streamBytes); });
+            }
+            for (int i = 0; i < config.spinners; ++i)
+            {
+                m_threads.emplace_back([this]() { spin(); });
+            }
+            for (int i = 0; i < config.sleepers; ++i)
+            {
+                m_threads.emplace_back([this]() { sleep(); });
+            }
+        }
+
+        ~interference()
+        {
+            m_stop.store(true, std::memory_order_relaxed);
+            for (auto& thread : m_threads)
+            {
+                thread.join();
+            }
+        }
+
+    private:
+
+        void stream(size_t streamBytes)
+        {
+            std::unique_ptr<uint8_t[]> data(new uint8_t[streamBytes]);
+            uint8_t value = 0;
+            while (!m_stop.load(std::memory_order_relaxed))
+            {
+                for (size_t i = 0; i < streamBytes; i += 64)
+                {
+                    data[i] += ++value;
+                }
+            }
+        }
+
+        void spin()
+        {
+            volatile uint64_t counter = 0;
+            while (!m_stop.load(std::memory_order_relaxed))
+            {
+                counter = counter + 1;
+            }
+        }
+
+        void sleep()
+        {
+            volatile uint64_t counter = 0;
+            while (!m_stop.load(std::memory_order_relaxed))
+            {
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+                const auto until = tsc_clock::now() + std::chrono::microseconds(50);
+                while (tsc_clock::now() < until)
+                {
+                    counter = counter + 1;
+                }
+            }
+        }
+
+        std::atomic<bool> m_stop;
+        std::vector<std::thread> m_threads;
+
+    };
+
+    // Runs a single producer publishing events at a fixed rate through a
+    // chain of stageCount consumers (stageCount == 1 is the unicast topology)
+    // and returns the distribution of publish-to-last-stage latency.
+    template<typename WaitStrategy, template<typename T> class ClaimStrategy>
+    benchmark::histogram RunTopology(
+        int stageCount,
+        size_t bufferSize,
+        uint64_t eventCount,
+        uint64_t eventsPerSecond)
+    {
+        WaitStrategy waitStrategy;
+        ClaimStrategy<WaitStrategy> claimStrategy(bufferSize, waitStrategy);
+        std::vector<std::unique_ptr<sequence_barrier<WaitStrategy>>> stageBarriers(stageCount);
+        for (int i = 0; i < stageCount; ++i)
+        {
+            stageBarriers[i].reset(new sequence_barrier<WaitStrategy>(waitStrategy));
+        }
+        claimStrategy.add_claim_barrier(*stageBarriers.back());
+        ring_buffer<event> buffer(bufferSize);
+
+        benchmark::histogram latency;
+
+        std::vector<std::thread> stages;
+        for (int stage = 0; stage < stageCount; ++stage)
+        {
+            stages.emplace_back([&, stage]()
+            {
+                const bool lastStage = (stage + 1 == stageCount);
+                auto& barrier = *stageBarriers[stage];
+                sequence_t nextToRead = 0;
+                bool done = false;
+                while (!done)
+                {
+                    const sequence_t available = stage == 0
+                        ? claimStrategy.wait_until_published(nextToRead, nextToRead - 1)
+                        : stageBarriers[stage - 1]->wait_until_published(nextToRead);
+                    const int64_t readNS = lastStage ? NowNS() : 0;
+                    do
+                    {
+                        const event& e = buffer[nextToRead];
+                        if (lastStage)
+                        {
+                            latency.record(readNS - e.m_publishedNS);
+                        }
+                        done = done || e.m_last;
+                    } while (nextToRead++ != available);
+                    barrier.publish(available);
+                }
+            });
+        }
+
+        const double intervalNS = 1e9 / static_cast<double>(eventsPerSecond);
+        const auto start = tsc_clock::now();
+        for (uint64_t i = 0; i < eventCount; ++i)
+        {
+            const auto due = start + tsc_clock::duration(static_cast<int64_t>(i * intervalNS));
+            while (tsc_clock::now() < due)
+            {
+            }
+
+            const sequence_t seq = claimStrategy.claim_one();
+            event& e = buffer[seq];
+            e.m_last = (i + 1 == eventCount);
+            e.m_publishedNS = NowNS();
+            claimStrategy.publish(seq);
+        }
+
+        for (auto& stage : stages)
+        {
+            stage.join();
+        }
+
+        if (latency.count() != eventCount)
+        {
+            throw std::domain_error("Unexpected test result.");
+        }
+
+        return latency;
+    }
+
+    void PrintHeader()
+    {
+        std::cout << "Topology" << ", "
+                  << "ClaimStrategy" << ", "
+                  << "WaitStrategy" << ", "
+                  << "Interference" << ", "
+                  << "P50NS" << ", "
+                  << "P99NS" << ", "
+                  << "P99.99NS" << ", "
+                  << "MaxNS" << ", "
+                  << "P99DeltaNS" << ", "
+                  << "P99.99DeltaNS" << std::endl;
+    }
+
+    // Runs one topology/strategy combination clean and then under each
+    // interference configuration, reporting tail latency relative to the
+    // clean run.
+    template<typename WaitStrategy, template<typename T> class ClaimStrategy>
+    void RunScenarios(
+        const char* topology,
+        int stageCount,
+        const char* claimStrategyName,
+        const char* waitStrategyName,
+        const std::vector<interference_config>& configs,
+        size_t streamBytes,
+        uint64_t eventCount,
+        uint64_t eventsPerSecond)
+    {
+        const size_t bufferSize = 64 * 1024;
+
+        int64_t cleanP99 = 0;
+        int64_t cleanP9999 = 0;
+        for (size_t i = 0; i < configs.size(); ++i)
+        {
+            benchmark::histogram latency;
+            {
+                interference noise(configs[i], streamBytes);
+                latency = RunTopology<WaitStrategy, ClaimStrategy>(stageCount, bufferSize, eventCount, eventsPerSecond);
+            }
+
+            const int64_t p99 = static_cast<int64_t>(latency.percentile(99));
+            const int64_t p9999 = static_cast<int64_t>(latency.percentile(99.99));
+            if (i == 0)
+            {
+                cleanP99 = p99;
+                cleanP9999 = p9999;
+            }
+
+            std::cout << topology << ", "
+                      << claimStrategyName << ", "
+                      << waitStrategyName << ", "
+                      << configs[i].name << ", "
+                      << latency.percentile(50) << ", "
+                      << p99 << ", "
+                      << p9999 << ", "
+                      << latency.max() << ", "
+                      << p99 - cleanP99 << ", "
+                      << p9999 - cleanP9999 << std::endl;
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    // Calibrate the clock so that timestamps read the TSC rather than
+    // steady_clock.
+    disruptorplus::tsc_clock::calibrate();
+
+    const int hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+
+    const int streamers = argc > 1 ? std::atoi(argv[1]) : 1;
+    const int spinners = argc > 2 ? std::atoi(argv[2]) : hardwareThreads;
+    const int sleepers = argc > 3 ? std::atoi(argv[3]) : 2;
+    const uint64_t eventCount = argc > 4 ? std::max(1, std::atoi(argv[4])) : 200 * 1000;
+    const uint64_t eventsPerSecond = 200 * 1000;
+    const size_t streamBytes = 256 * 1024 * 1024;
+
+    std::cout << "Tail Latency Under Interference Benchmark" << std::endl
+              << "Usage: interference [streamers [spinners [sleepers [event-count]]]]" << std::endl
+              << "Streamers: " << streamers << " (" << (streamBytes >> 20) << "MB each)" << std::endl
+              << "Spinners: " << spinners << std::endl
+              << "Sleepers: " << sleepers << std::endl
+              << "Event count: " << eventCount << std::endl
+              << "Offered rate: " << eventsPerSecond << " events/sec" << std::endl;
+
+    std::vector<interference_config> configs;
+    {
+        const interference_config clean = { "clean", 0, 0, 0 };
+        const interference_config llc = { "streamers", streamers, 0, 0 };
+        const interference_config oversubscribed = { "spinners", 0, spinners, 0 };
+        const interference_config preempting = { "sleepers", 0, 0, sleepers };
+        const interference_config all = { "all", streamers, spinners, sleepers };
+        configs.push_back(clean);
+        configs.push_back(llc);
+        configs.push_back(oversubscribed);
+        configs.push_back(preempting);
+        configs.push_back(all);
+    }
+
+    try
+    {
+        PrintHeader();
+
+#define BENCHMARK(TOPOLOGY,STAGES,CS,WS) \
+        RunScenarios<disruptorplus::WS, disruptorplus::CS>( \
+            TOPOLOGY, STAGES, #CS, #WS, configs, streamBytes, eventCount, eventsPerSecond)
+
+        BENCHMARK("unicast", 1, single_threaded_claim_strategy, spin_wait_strategy);
+        BENCHMARK("unicast", 1, single_threaded_claim_strategy, blocking_wait_strategy);
+        BENCHMARK("unicast", 1, multi_threaded_claim_strategy, spin_wait_strategy);
+        BENCHMARK("unicast", 1, multi_threaded_claim_strategy, blocking_wait_strategy);
+        BENCHMARK("pipeline", 3, single_threaded_claim_strategy, spin_wait_strategy);
+        BENCHMARK("pipeline", 3, single_threaded_claim_strategy, blocking_wait_strategy);
+        BENCHMARK("pipeline", 3, multi_threaded_claim_strategy, spin_wait_strategy);
+        BENCHMARK("pipeline", 3, multi_threaded_claim_strategy, blocking_wait_strategy);
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,263 @@
+#include <disruptorplus/single_threaded_claim_strategy.hpp>
+#include <disruptorplus/spin_wait_strategy.hpp>
+#include <disruptorplus/ring_buffer.hpp>
+#include <disruptorplus/journal_writer.hpp>
+#include <disruptorplus/journal_reader.hpp>
+#include <disruptorplus/tsc_clock.hpp>
+
+#include "platform.hpp"
+#include "stats.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using namespace disruptorplus;
+
+namespace
+{
+    struct event
+    {
+        int64_t m_publishedNS;
+        uint64_t m_value;
+        uint64_t m_payload[6];
+    };
+
+    int64_t NowNS()
+    {
+        return tsc_clock::now().time_since_epoch().count();
+    }
+
+    const char* SyncName(journal_sync sync)
+    {
+        switch (sync)
+        {
+        case journal_sync::async: return "async";
+        case journal_sync::sync: return "sync";
+        default: return "none";
+        }
+    }
+
+    void PrintHeader()
+    {
+        std::cout << "Mode" << ", "
+                  << "Sync" << ", "
+                  << "Events/Sec" << ", "
+                  << "MB/Sec" << ", "
+                  << "Batches" << ", "
+                  << "MeanBatch" << ", "
+                  << "CommitP50NS" << ", "
+                  << "CommitP99NS" << ", "
+                  << "CommitMaxNS" << std::endl;
+    }
+
+    double ElapsedNS(tsc_clock::time_point start)
+    {
+        const auto elapsed = tsc_clock::now_ordered() - start;
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+
+    // producer -> journal -> durable consumer
+    //
+    // The consumer gates on the journal's committed barrier, so the commit
+    // latency is the time from publish until an event is known durable.
+    uint64_t RunJournal(
+        const std::string& directory,
+        journal_sync sync,
+        size_t bufferSize,
+        size_t recordsPerSegment,
+        uint64_t eventCount)
+    {
+        spin_wait_strategy waitStrategy;
+        single_threaded_claim_strategy<spin_wait_strategy> claimStrategy(bufferSize, waitStrategy);
+        journal_writer<event, spin_wait_strategy> journal(waitStrategy, directory, recordsPerSegment, sync);
+        sequence_barrier<spin_wait_strategy> consumed(waitStrategy);
+        claimStrategy.add_claim_barrier(consumed);
+        ring_buffer<event> buffer(bufferSize);
+
+        const sequence_t last = static_cast<sequence_t>(eventCount - 1);
+        uint64_t batchCount = 0;
+        benchmark::histogram commitLatency;
+        uint64_t sum = 0;
+
+        std::thread journalThread([&]()
+        {
+            while (journal.next_sequence() <= last)
+            {
+                const sequence_t available = claimStrategy.wait_until_published(journal.next_sequence());
+                journal.append(buffer, available);
+                ++batchCount;
+            }
+        });
+
+        std::thread consumer([&]()
+        {
+            sequence_t nextToRead = 0;
+            while (nextToRead <= last)
+            {
+                const sequence_t available = journal.committed().wait_until_published(nextToRead);
+                const int64_t readNS = NowNS();
+                do
+                {
+                    const event& e = buffer[nextToRead];
+                    commitLatency.record(readNS - e.m_publishedNS);
+                    sum += e.m_value;
+                } while (nextToRead++ != available);
+                consumed.publish(available);
+            }
+        });
+
+        const auto start = tsc_clock::now();
+        for (uint64_t i = 0; i < eventCount; ++i)
+        {
+            const sequence_t seq = claimStrategy.claim_one();
+            event& e = buffer[seq];
+            e.m_value = i;
+            for (auto& word : e.m_payload)
+            {
+                word = i;
+            }
+            e.m_publishedNS = NowNS();
+            claimStrategy.publish(seq);
+        }
+
+        journalThread.join();
+        consumer.join();
+        const double elapsedNS = ElapsedNS(start);
+
+        const uint64_t expectedSum = eventCount * (eventCount - 1) / 2;
+        if (sum != expectedSum)
+        {
+            throw std::domain_error("Unexpected test result.");
+        }
+
+        std::cout << "journal" << ", "
+                  << SyncName(sync) << ", "
+                  << static_cast<uint64_t>(eventCount * 1e9 / elapsedNS) << ", "
+                  << static_cast<uint64_t>(eventCount * sizeof(event) * 1e9 / elapsedNS / (1024 * 1024)) << ", "
+                  << batchCount << ", "
+                  << eventCount / std::max<uint64_t>(1, batchCount) << ", "
+                  << commitLatency.percentile(50) << ", "
+                  << commitLatency.percentile(99) << ", "
+                  << commitLatency.max() << std::endl;
+
+        return expectedSum;
+    }
+
+    // journal -> replay producer -> consumer
+    void RunReplay(const std::string& directory, size_t bufferSize, uint64_t eventCount, uint64_t expectedSum)
+    {
+        journal_reader<event> reader(directory);
+        if (reader.begin_sequence() != 0 || reader.end_sequence() != eventCount)
+        {
+            throw std::domain_error("Unexpected journal contents.");
+        }
+
+        spin_wait_strategy waitStrategy;
+        single_threaded_claim_strategy<spin_wait_strategy> claimStrategy(bufferSize, waitStrategy);
+        sequence_barrier<spin_wait_strategy> consumed(waitStrategy);
+        claimStrategy.add_claim_barrier(consumed);
+        ring_buffer<event> buffer(bufferSize);
+
+        uint64_t sum = 0;
+        uint64_t batchCount = 0;
+        std::thread consumer([&]()
+        {
+            sequence_t nextToRead = 0;
+            uint64_t remaining = eventCount;
+            while (remaining > 0)
+            {
+                const sequence_t available = claimStrategy.wait_until_published(nextToRead);
+                do
+                {
+                    sum += buffer[nextToRead].m_value;
+                    --remaining;
+                } while (nextToRead++ != available);
+                consumed.publish(available);
+                ++batchCount;
+            }
+        });
+
+        const auto start = tsc_clock::now();
+        const uint64_t replayed = reader.replay(claimStrategy, buffer, reader.begin_sequence(), reader.end_sequence());
+        consumer.join();
+        const double elapsedNS = ElapsedNS(start);
+
+        if (replayed != eventCount || sum != expectedSum)
+        {
+            throw std::domain_error("Unexpected test result.");
+        }
+
+        std::cout << "replay" << ", "
+                  << "n/a" << ", "
+                  << static_cast<uint64_t>(eventCount * 1e9 / elapsedNS) << ", "
+                  << static_cast<uint64_t>(eventCount * sizeof(event) * 1e9 / elapsedNS / (1024 * 1024)) << ", "
+                  << batchCount << ", "
+                  << eventCount / std::max<uint64_t>(1, batchCount) << ", "
+                  << "n/a" << ", "
+                  << "n/a" << ", "
+                  << "n/a" << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    // Calibrate the clock so that timestamps read the TSC rather than
+    // steady_clock.
+    disruptorplus::tsc_clock::calibrate();
+
+    const uint64_t eventCount = argc > 1 ? std::max(1, std::atoi(argv[1])) : 1000 * 1000;
+    const std::string parent = argc > 2 ? argv[2] : "/tmp";
+    const size_t bufferSize = 16 * 1024;
+    const size_t recordsPerSegment = 256 * 1024;
+
+    std::cout << "Journal Benchmark" << std::endl
+              << "Usage: journal [event-count [directory]]" << std::endl
+              << "Event count: " << eventCount << " (" << sizeof(event) << " bytes each)" << std::endl
+              << "Records per segment: " << recordsPerSegment << std::endl
+              << "Directory: " << parent << std::endl;
+
+    if (!benchmark::platform_supported())
+    {
+        std::cout << "error: temporary directories are not available on this platform" << std::endl;
+        return 1;
+    }
+
+    try
+    {
+        PrintHeader();
+
+        const journal_sync modes[] = { journal_sync::none, journal_sync::async, journal_sync::sync };
+        for (journal_sync sync : modes)
+        {
+            const std::string directory = benchmark::make_temp_directory(parent);
+            if (directory.empty())
+            {
+                throw std::runtime_error("failed to create a directory in " + parent);
+            }
+
+            try
+            {
+                const uint64_t expectedSum = RunJournal(directory, sync, bufferSize, recordsPerSegment, eventCount);
+                RunReplay(directory, bufferSize, eventCount, expectedSum);
+            }
+            catch (...)
+            {
+                benchmark::remove_directory(directory);
+                throw;
+            }
+            benchmark::remove_directory(directory);
+        }
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
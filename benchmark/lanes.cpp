@@ -0,0 +1,250 @@
+#include <disruptorplus/multi_threaded_claim_strategy.hpp>
+#include <disruptorplus/spin_wait_strategy.hpp>
+#include <disruptorplus/priority_lanes.hpp>
+#include <disruptorplus/tsc_clock.hpp>
+
+#include "stats.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace disruptorplus;
+
+namespace
+{
+    struct event
+    {
+        int64_t m_publishedNS;
+        bool m_urgent;
+        bool m_last;
+    };
+
+    typedef priority_lanes<event, spin_wait_strategy> lanes_type;
+
+    int64_t NowNS()
+    {
+        return tsc_clock::now().time_since_epoch().count();
+    }
+
+    void SpinFor(int64_t ns)
+    {
+        const int64_t until = NowNS() + ns;
+        while (NowNS() < until)
+        {
+        }
+    }
+
+    enum class layout
+    {
+        // Urgent and bulk events share one ring.
+        shared,
+
+        // Separate lanes drained in strict priority order.
+        strict,
+
+        // Separate lanes drained by weight.
+        weighted
+    };
+
+    const char* LayoutName(layout l)
+    {
+        switch (l)
+        {
+        case layout::shared: return "shared";
+        case layout::strict: return "strict";
+        default: return "weighted";
+        }
+    }
+
+    void PrintHeader()
+    {
+        std::cout << "Layout" << ", "
+                  << "BulkProducers" << ", "
+                  << "BulkEvents/Sec" << ", "
+                  << "UrgentEvents" << ", "
+                  << "UrgentLatencyP50NS" << ", "
+                  << "UrgentLatencyP99NS" << ", "
+                  << "UrgentLatencyP99.9NS" << ", "
+                  << "UrgentLatencyMaxNS" << std::endl;
+    }
+
+    // urgent producer (paced) + bulk producers (flat out) -> consumer
+    //
+    // The consumer does a fixed amount of work per event so the bulk
+    // producers keep their lane saturated.
+    void Run(
+        layout l,
+        size_t bulkCount,
+        size_t bufferSize,
+        std::chrono::milliseconds duration,
+        int64_t urgentIntervalNS,
+        int64_t consumerWorkNS)
+    {
+        spin_wait_strategy waitStrategy;
+        std::unique_ptr<lanes_type> lanes;
+        switch (l)
+        {
+        case layout::shared:
+            lanes.reset(new lanes_type(waitStrategy, { bufferSize }));
+            break;
+        case layout::strict:
+            lanes.reset(new lanes_type(waitStrategy, { 1024, bufferSize }));
+            break;
+        case layout::weighted:
+            lanes.reset(new lanes_type(waitStrategy, { 1024, bufferSize }, lane_policy::weighted, { 16, 64 }));
+            break;
+        }
+        const size_t urgentLane = 0;
+        const size_t bulkLane = lanes->lane_count() - 1;
+
+        std::atomic<bool> stop(false);
+        std::vector<uint64_t> bulkEvents(bulkCount, 0);
+        benchmark::histogram urgentLatency;
+        uint64_t urgentCount = 0;
+
+        std::thread consumer([&]()
+        {
+            bool done = false;
+            while (!done)
+            {
+                lanes->process([&](size_t, const event& e)
+                {
+                    if (e.m_last)
+                    {
+                        done = true;
+                    }
+                    else if (e.m_urgent)
+                    {
+                        urgentLatency.record(NowNS() - e.m_publishedNS);
+                    }
+                    SpinFor(consumerWorkNS);
+                });
+            }
+        });
+
+        std::vector<std::thread> bulk;
+        for (size_t b = 0; b < bulkCount; ++b)
+        {
+            bulk.emplace_back([&, b]()
+            {
+                uint64_t count = 0;
+                while (!stop.load(std::memory_order_relaxed))
+                {
+                    const sequence_range range = lanes->claim(bulkLane, 64);
+                    for (size_t i = 0; i < range.size(); ++i)
+                    {
+                        event& e = lanes->buffer(bulkLane)[range[i]];
+                        e.m_publishedNS = NowNS();
+                        e.m_urgent = false;
+                        e.m_last = false;
+                    }
+                    lanes->publish(bulkLane, range);
+                    count += range.size();
+                }
+                bulkEvents[b] = count;
+            });
+        }
+
+        const auto start = tsc_clock::now();
+        const int64_t endNS = NowNS() + std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+        int64_t nextNS = NowNS();
+        while (NowNS() < endNS)
+        {
+            while (NowNS() < nextNS)
+            {
+            }
+            nextNS += urgentIntervalNS;
+
+            event e;
+            e.m_publishedNS = NowNS();
+            e.m_urgent = true;
+            e.m_last = false;
+            lanes->push(urgentLane, e);
+            ++urgentCount;
+        }
+        stop = true;
+        for (auto& producer : bulk)
+        {
+            producer.join();
+        }
+        const auto elapsed = tsc_clock::now_ordered() - start;
+        const double elapsedNS = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+
+        // The last event goes in the lowest lane so that the consumer has
+        // drained everything before it.
+        event last;
+        last.m_publishedNS = NowNS();
+        last.m_urgent = false;
+        last.m_last = true;
+        lanes->push(bulkLane, last);
+        consumer.join();
+
+        if (urgentLatency.count() != urgentCount)
+        {
+            throw std::domain_error("Unexpected test result.");
+        }
+
+        uint64_t totalBulk = 0;
+        for (uint64_t count : bulkEvents)
+        {
+            totalBulk += count;
+        }
+
+        std::cout << LayoutName(l) << ", "
+                  << bulkCount << ", "
+                  << static_cast<uint64_t>(totalBulk * 1e9 / elapsedNS) << ", "
+                  << urgentCount << ", "
+                  << urgentLatency.percentile(50) << ", "
+                  << urgentLatency.percentile(99) << ", "
+                  << urgentLatency.percentile(99.9) << ", "
+                  << urgentLatency.max() << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    // Calibrate the clock so that timestamps read the TSC rather than
+    // steady_clock.
+    disruptorplus::tsc_clock::calibrate();
+
+    const int durationMS = argc > 1 ? std::max(1, std::atoi(argv[1])) : 2000;
+    const size_t bufferSize = 16 * 1024;
+    const int64_t urgentIntervalNS = 20 * 1000;
+    const int64_t consumerWorkNS = 100;
+
+    std::cout << "Priority Lanes Benchmark" << std::endl
+              << "Usage: lanes [milliseconds-per-run]" << std::endl
+              << "Duration: " << durationMS << "ms" << std::endl
+              << "Bulk lane size: " << bufferSize << std::endl
+              << "Urgent interval: " << urgentIntervalNS << "ns" << std::endl
+              << "Consumer work: " << consumerWorkNS << "ns per event" << std::endl;
+
+    try
+    {
+        PrintHeader();
+
+        for (size_t bulkCount : { 1, 2 })
+        {
+            for (layout l : { layout::shared, layout::strict, layout::weighted })
+            {
+                Run(l, bulkCount, bufferSize, std::chrono::milliseconds(durationMS), urgentIntervalNS, consumerWorkNS);
+            }
+        }
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
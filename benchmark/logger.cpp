@@ -0,0 +1,228 @@
+#include <disruptorplus/spin_wait_strategy.hpp>
+#include <disruptorplus/async_logger.hpp>
+#include <disruptorplus/tsc_clock.hpp>
+
+#include "stats.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace disruptorplus;
+
+namespace
+{
+    typedef async_logger<spin_wait_strategy> logger_type;
+
+    enum class mode
+    {
+        // Format with snprintf and write with fwrite on the calling thread.
+        inline_format,
+
+        // async_logger, blocking when full.
+        async_block,
+
+        // async_logger, dropping when full.
+        async_drop
+    };
+
+    const char* ModeName(mode m)
+    {
+        switch (m)
+        {
+        case mode::inline_format: return "inline";
+        case mode::async_block: return "async-block";
+        default: return "async-drop";
+        }
+    }
+
+    int64_t NowNS()
+    {
+        return tsc_clock::now().time_since_epoch().count();
+    }
+
+    void PrintHeader()
+    {
+        std::cout << "Mode" << ", "
+                  << "Producers" << ", "
+                  << "Lines/Sec" << ", "
+                  << "LogP50NS" << ", "
+                  << "LogP99NS" << ", "
+                  << "LogP99.9NS" << ", "
+                  << "LogMaxNS" << ", "
+                  << "Written" << ", "
+                  << "Dropped" << ", "
+                  << "Bytes" << std::endl;
+    }
+
+    // producers -> logger -> background thread -> /dev/null
+    void Run(mode m, size_t producerCount, uint64_t linesPerProducer, size_t bufferSize)
+    {
+        std::FILE* file = std::fopen("/dev/null", "w");
+        if (file == nullptr)
+        {
+            throw std::runtime_error("failed to open /dev/null");
+        }
+
+        spin_wait_strategy waitStrategy;
+        logger_type logger(
+            waitStrategy,
+            bufferSize,
+            m == mode::async_drop ? log_overflow::drop : log_overflow::block);
+
+        std::atomic<bool> producersDone(false);
+        uint64_t written = 0;
+        uint64_t bytes = 0;
+        auto sink = [&](const char* data, size_t size)
+        {
+            std::fwrite(data, 1, size, file);
+            bytes += size;
+        };
+
+        std::thread background;
+        if (m != mode::inline_format)
+        {
+            background = std::thread([&]()
+            {
+                for (;;)
+                {
+                    const bool done = producersDone.load();
+                    const size_t count = logger.poll(sink);
+                    written += count;
+                    if (count == 0)
+                    {
+                        if (done)
+                        {
+                            break;
+                        }
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+
+        std::vector<benchmark::histogram> costs(producerCount);
+        std::vector<uint64_t> inlineBytes(producerCount, 0);
+        std::vector<std::thread> producers;
+        const auto start = tsc_clock::now();
+        for (size_t p = 0; p < producerCount; ++p)
+        {
+            producers.emplace_back([&, p]()
+            {
+                const char* const venue = p % 2 == 0 ? "XLON" : "XNYS";
+                for (uint64_t i = 0; i < linesPerProducer; ++i)
+                {
+                    const int64_t orderId = static_cast<int64_t>(p * linesPerProducer + i);
+                    const uint32_t quantity = static_cast<uint32_t>(i % 1000 + 1);
+                    const double price = 100.0 + static_cast<double>(i % 500) / 100.0;
+
+                    const int64_t before = NowNS();
+                    if (m == mode::inline_format)
+                    {
+                        char line[256];
+                        const int length = std::snprintf(
+                            line, sizeof(line), "%lld INFO  order %lld filled %u @ %g on %s\n",
+                            static_cast<long long>(before), static_cast<long long>(orderId),
+                            quantity, price, venue);
+                        std::fwrite(line, 1, static_cast<size_t>(length), file);
+                        inlineBytes[p] += static_cast<size_t>(length);
+                    }
+                    else
+                    {
+                        logger.log(log_level::info, "order {} filled {} @ {} on {}", orderId, quantity, price, venue);
+                    }
+                    costs[p].record(NowNS() - before);
+                }
+            });
+        }
+        for (auto& producer : producers)
+        {
+            producer.join();
+        }
+        producersDone = true;
+        if (background.joinable())
+        {
+            background.join();
+        }
+        const auto elapsed = tsc_clock::now_ordered() - start;
+        std::fclose(file);
+
+        const uint64_t total = producerCount * linesPerProducer;
+        if (m == mode::inline_format)
+        {
+            written = total;
+            for (uint64_t b : inlineBytes)
+            {
+                bytes += b;
+            }
+        }
+        if (written + logger.dropped() != total ||
+            (m != mode::async_drop && logger.dropped() != 0))
+        {
+            throw std::domain_error("Unexpected test result.");
+        }
+
+        benchmark::histogram cost;
+        for (auto& h : costs)
+        {
+            cost.merge(h);
+        }
+
+        // Throughput counts up to when the last line was written.
+        const double elapsedNS = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+
+        std::cout << ModeName(m) << ", "
+                  << producerCount << ", "
+                  << static_cast<uint64_t>(written * 1e9 / elapsedNS) << ", "
+                  << cost.percentile(50) << ", "
+                  << cost.percentile(99) << ", "
+                  << cost.percentile(99.9) << ", "
+                  << cost.max() << ", "
+                  << written << ", "
+                  << logger.dropped() << ", "
+                  << bytes << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    // Calibrate the clock so that timestamps read the TSC rather than
+    // steady_clock.
+    disruptorplus::tsc_clock::calibrate();
+
+    const uint64_t linesPerProducer = argc > 1 ? std::max(1, std::atoi(argv[1])) : 1000 * 1000;
+    const size_t bufferSize = 64 * 1024;
+
+    std::cout << "Async Logger Benchmark" << std::endl
+              << "Usage: logger [lines-per-producer]" << std::endl
+              << "Lines per producer: " << linesPerProducer << std::endl
+              << "Buffer size: " << bufferSize << " records" << std::endl;
+
+    try
+    {
+        PrintHeader();
+
+        for (size_t producerCount : { 1, 2, 4 })
+        {
+            for (mode m : { mode::inline_format, mode::async_block, mode::async_drop })
+            {
+                Run(m, producerCount, linesPerProducer, bufferSize);
+            }
+        }
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
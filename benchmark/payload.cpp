@@ -0,0 +1,212 @@
+#include <disruptorplus/single_threaded_claim_strategy.hpp>
+#include <disruptorplus/spin_wait_strategy.hpp>
+#include <disruptorplus/ring_buffer.hpp>
+#include <disruptorplus/tsc_clock.hpp>
+
+#include "platform.hpp"
+#include "stats.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+
+using namespace disruptorplus;
+
+namespace
+{
+    // An event of Size bytes laid out with the given alignment.
+    //
+    // Alignment of 8 is the natural alignment of the words in the event
+    // so consecutive slots are packed together and may share cache lines.
+    // Larger alignments round each slot up to a multiple of that size.
+    //
+    // The first word holds the publish timestamp, the remainder is payload.
+    template<size_t Size, size_t Alignment>
+    struct alignas(Alignment) event : aligned_array_allocation<Alignment>
+    {
+        int64_t m_words[Size / sizeof(int64_t)];
+    };
+
+    enum write_pattern
+    {
+        // The producer writes, and the consumer reads, every word of the event.
+        full_overwrite,
+
+        // The producer writes, and the consumer reads, only the timestamp.
+        single_field
+    };
+
+    const char* PatternName(write_pattern pattern)
+    {
+        return pattern == full_overwrite ? "full" : "one-field";
+    }
+
+    void PrintHeader()
+    {
+        std::cout << "EventBytes" << ", "
+                  << "Alignment" << ", "
+                  << "SlotBytes" << ", "
+                  << "SlotsAligned" << ", "
+                  << "WritePattern" << ", "
+                  << "Events/Sec" << ", "
+                  << "MB/Sec" << ", "
+                  << "LatencyP50NS" << ", "
+                  << "LatencyP99NS" << ", "
+                  << "HITM" << std::endl;
+    }
+
+    template<size_t Size, size_t Alignment>
+    void RunLayout(write_pattern pattern, size_t bufferSize, uint64_t eventCount, uint64_t hitmEvent)
+    {
+        typedef event<Size, Alignment> event_type;
+        const size_t wordCount = Size / sizeof(int64_t);
+
+        spin_wait_strategy waitStrategy;
+        single_threaded_claim_strategy<spin_wait_strategy> claimStrategy(bufferSize, waitStrategy);
+        sequence_barrier<spin_wait_strategy> consumed(waitStrategy);
+        claimStrategy.add_claim_barrier(consumed);
+        ring_buffer<event_type> buffer(bufferSize);
+
+        // Sanity check that the slots really are aligned as requested.
+        const bool aligned = (reinterpret_cast<uintptr_t>(&buffer[0]) % Alignment) == 0;
+
+        benchmark::histogram latency;
+        uint64_t checksum = 0;
+
+        benchmark::perf_counter hitm(hitmEvent);
+        hitm.start();
+
+        const auto start = tsc_clock::now();
+
+        std::thread consumer([&]()
+        {
+            uint64_t sum = 0;
+            sequence_t nextToRead = 0;
+            uint64_t remaining = eventCount;
+            while (remaining > 0)
+            {
+                const sequence_t available = claimStrategy.wait_until_published(nextToRead);
+                const int64_t readNS = tsc_clock::now().time_since_epoch().count();
+                do
+                {
+                    const event_type& e = buffer[nextToRead];
+                    latency.record(readNS - e.m_words[0]);
+                    if (pattern == full_overwrite)
+                    {
+                        for (size_t w = 1; w < wordCount; ++w)
+                        {
+                            sum += static_cast<uint64_t>(e.m_words[w]);
+                        }
+                    }
+                    --remaining;
+                } while (nextToRead++ != available);
+                consumed.publish(available);
+            }
+            checksum = sum;
+        });
+
+        for (uint64_t i = 0; i < eventCount; ++i)
+        {
+            const sequence_t seq = claimStrategy.claim_one();
+            event_type& e = buffer[seq];
+            if (pattern == full_overwrite)
+            {
+                for (size_t w = 1; w < wordCount; ++w)
+                {
+                    e.m_words[w] = static_cast<int64_t>(i);
+                }
+            }
+            e.m_words[0] = tsc_clock::now().time_since_epoch().count();
+            claimStrategy.publish(seq);
+        }
+
+        consumer.join();
+
+        const auto elapsed = tsc_clock::now_ordered() - start;
+        const int64_t hitmCount = hitm.stop();
+        const double elapsedNS = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+
+        const uint64_t expected = pattern == full_overwrite
+            ? (wordCount - 1) * ((eventCount * (eventCount - 1)) / 2)
+            : 0;
+        if (checksum != expected)
+        {
+            throw std::domain_error("Unexpected test result.");
+        }
+
+        const double eventsPerSecond = eventCount * 1e9 / elapsedNS;
+
+        std::cout << Size << ", "
+                  << Alignment << ", "
+                  << sizeof(event_type) << ", "
+                  << (aligned ? "yes" : "no") << ", "
+                  << PatternName(pattern) << ", "
+                  << static_cast<uint64_t>(eventsPerSecond) << ", "
+                  << static_cast<uint64_t>(eventsPerSecond * Size / (1024 * 1024)) << ", "
+                  << latency.percentile(50) << ", "
+                  << latency.percentile(99) << ", ";
+        if (hitm.valid())
+        {
+            std::cout << hitmCount << std::endl;
+        }
+        else
+        {
+            std::cout << "n/a" << std::endl;
+        }
+    }
+
+    template<size_t Size>
+    void RunSize(size_t bufferSize, uint64_t eventCount, uint64_t hitmEvent)
+    {
+        RunLayout<Size, 8>(full_overwrite, bufferSize, eventCount, hitmEvent);
+        RunLayout<Size, 8>(single_field, bufferSize, eventCount, hitmEvent);
+        RunLayout<Size, 64>(full_overwrite, bufferSize, eventCount, hitmEvent);
+        RunLayout<Size, 64>(single_field, bufferSize, eventCount, hitmEvent);
+        RunLayout<Size, 128>(full_overwrite, bufferSize, eventCount, hitmEvent);
+        RunLayout<Size, 128>(single_field, bufferSize, eventCount, hitmEvent);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    // Calibrate the clock so that timestamps read the TSC rather than
+    // steady_clock.
+    disruptorplus::tsc_clock::calibrate();
+
+    const size_t bufferSize = 16 * 1024;
+    const uint64_t eventCount = argc > 1 ? std::max(1, std::atoi(argv[1])) : 2 * 1000 * 1000;
+
+    // Default is MEM_LOAD_L3_HIT_RETIRED.XSNP_HITM (event 0xd2, umask 0x04)
+    // on Intel Skylake and later. Pass the raw code for other processors.
+    const uint64_t hitmEvent = argc > 2 ? std::strtoull(argv[2], nullptr, 0) : 0x04d2;
+
+    std::cout << "Payload Size and Slot Layout Benchmark" << std::endl
+              << "Usage: payload [event-count [raw-hitm-event]]" << std::endl
+              << "Buffer size: " << bufferSize << std::endl
+              << "Event count: " << eventCount << std::endl
+              << "HITM event: 0x" << std::hex << hitmEvent << std::dec << std::endl;
+
+    try
+    {
+        PrintHeader();
+        RunSize<8>(bufferSize, eventCount, hitmEvent);
+        RunSize<16>(bufferSize, eventCount, hitmEvent);
+        RunSize<32>(bufferSize, eventCount, hitmEvent);
+        RunSize<64>(bufferSize, eventCount, hitmEvent);
+        RunSize<128>(bufferSize, eventCount, hitmEvent);
+        RunSize<256>(bufferSize, eventCount, hitmEvent);
+        RunSize<512>(bufferSize, eventCount, hitmEvent);
+        RunSize<1024>(bufferSize, eventCount, hitmEvent);
+        RunSize<4096>(bufferSize, eventCount, hitmEvent);
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,664 @@
+#include <disruptorplus/single_threaded_claim_strategy.hpp>
+#include <disruptorplus/multi_threaded_claim_strategy.hpp>
+#include <disruptorplus/sequence_barrier_group.hpp>
+#include <disruptorplus/spin_wait_strategy.hpp>
+#include <disruptorplus/ring_buffer.hpp>
+#include <disruptorplus/tsc_clock.hpp>
+
+#include "platform.hpp"
+#include "stats.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace disruptorplus;
+
+namespace
+{
+    typedef spin_wait_strategy wait_strategy;
+
+    struct event
+    {
+        int64_t m_publishedNS;
+        uint64_t m_value;
+    };
+
+    int64_t NowNS()
+    {
+        return tsc_clock::now().time_since_epoch().count();
+    }
+
+    // How the threads of a topology are placed relative to each other.
+    enum placement_class
+    {
+        // Left to the operating system scheduler.
+        unpinned,
+
+        // Packed onto the SMT siblings of as few cores as possible so
+        // that neighbouring threads share L1/L2.
+        smt,
+
+        // One thread per physical core, all on the same package so
+        // threads share only the L3.
+        same_socket,
+
+        // One thread per physical core, alternating between packages so
+        // neighbouring threads communicate across the socket interconnect.
+        cross_socket
+    };
+
+    const placement_class placementClasses[] = { unpinned, smt, same_socket, cross_socket };
+
+    const char* PlacementName(placement_class placement)
+    {
+        switch (placement)
+        {
+        case smt: return "smt";
+        case same_socket: return "same-socket";
+        case cross_socket: return "cross-socket";
+        default: return "unpinned";
+        }
+    }
+
+    // package -> core -> logical cpus
+    typedef std::map<int, std::map<int, std::vector<int>>> topology_map;
+
+    topology_map BuildTopologyMap(const std::vector<benchmark::cpu_info>& cpus)
+    {
+        topology_map topology;
+        for (const auto& info : cpus)
+        {
+            topology[info.package][info.core].push_back(info.cpu);
+        }
+        return topology;
+    }
+
+    // Select the logical CPUs to pin threadCount threads to for the given
+    // placement class.
+    //
+    // Returns false if the machine does not have enough CPUs of the right
+    // kind. An empty list with a true result means 'do not pin'.
+    bool SelectCpus(
+        const topology_map& topology,
+        placement_class placement,
+        int threadCount,
+        std::vector<int>& cpus)
+    {
+        cpus.clear();
+        switch (placement)
+        {
+        case unpinned:
+            return true;
+
+        case smt:
+            for (const auto& package : topology)
+            {
+                cpus.clear();
+                for (const auto& core : package.second)
+                {
+                    if (core.second.size() < 2)
+                    {
+                        continue;
+                    }
+                    for (int cpu : core.second)
+                    {
+                        if (static_cast<int>(cpus.size()) < threadCount)
+                        {
+                            cpus.push_back(cpu);
+                        }
+                    }
+                }
+                if (static_cast<int>(cpus.size()) == threadCount)
+                {
+                    return true;
+                }
+            }
+            return false;
+
+        case same_socket:
+            for (const auto& package : topology)
+            {
+                cpus.clear();
+                for (const auto& core : package.second)
+                {
+                    if (static_cast<int>(cpus.size()) < threadCount)
+                    {
+                        cpus.push_back(core.second.front());
+                    }
+                }
+                if (static_cast<int>(cpus.size()) == threadCount)
+                {
+                    return true;
+                }
+            }
+            return false;
+
+        case cross_socket:
+        {
+            if (topology.size() < 2)
+            {
+                return false;
+            }
+
+            std::vector<std::vector<int>> packageCpus;
+            for (const auto& package : topology)
+            {
+                packageCpus.push_back(std::vector<int>());
+                for (const auto& core : package.second)
+                {
+                    packageCpus.back().push_back(core.second.front());
+                }
+            }
+
+            for (int i = 0; i < threadCount; ++i)
+            {
+                const std::vector<int>& candidates = packageCpus[i % packageCpus.size()];
+                const size_t index = i / packageCpus.size();
+                if (index >= candidates.size())
+                {
+                    return false;
+                }
+                cpus.push_back(candidates[index]);
+            }
+            return true;
+        }
+        }
+        return false;
+    }
+
+    // Runs a set of threads, each pinned to the CPU at the same index in
+    // the list given to the constructor, starting them all together.
+    class pinned_threads
+    {
+    public:
+
+        explicit pinned_threads(const std::vector<int>& cpus)
+        : m_cpus(cpus)
+        , m_go(false)
+        , m_pinFailed(false)
+        {}
+
+        ~pinned_threads()
+        {
+            m_go.store(true, std::memory_order_release);
+            for (auto& thread : m_threads)
+            {
+                if (thread.joinable())
+                {
+                    thread.join();
+                }
+            }
+        }
+
+        void add(std::function<void()> body)
+        {
+            const int cpu = m_threads.size() < m_cpus.size() ? m_cpus[m_threads.size()] : -1;
+            m_threads.emplace_back([this, cpu, body]()
+            {
+                if (cpu >= 0 && !benchmark::pin_current_thread(cpu))
+                {
+                    m_pinFailed.store(true);
+                }
+                while (!m_go.load(std::memory_order_acquire))
+                {
+                    std::this_thread::yield();
+                }
+                body();
+            });
+        }
+
+        // Release all of the threads. Returns the start time, which is also
+        // visible to the threads through start_time().
+        tsc_clock::time_point start()
+        {
+            m_start = tsc_clock::now();
+            m_go.store(true, std::memory_order_release);
+            return m_start;
+        }
+
+        tsc_clock::time_point start_time() const { return m_start; }
+
+        void join()
+        {
+            for (auto& thread : m_threads)
+            {
+                if (thread.joinable())
+                {
+                    thread.join();
+                }
+            }
+            if (m_pinFailed.load())
+            {
+                throw std::runtime_error("failed to set thread affinity");
+            }
+        }
+
+    private:
+
+        std::vector<int> m_cpus;
+        std::vector<std::thread> m_threads;
+        std::atomic<bool> m_go;
+        std::atomic<bool> m_pinFailed;
+        tsc_clock::time_point m_start;
+
+    };
+
+    struct run_result
+    {
+        uint64_t eventsPerSecond;
+        benchmark::histogram latency;
+    };
+
+    // Publish eventCount events, spacing them intervalNS apart from the
+    // start time if intervalNS is non-zero.
+    template<typename ClaimStrategy>
+    void Produce(
+        ClaimStrategy& claimStrategy,
+        ring_buffer<event>& buffer,
+        uint64_t eventCount,
+        double intervalNS,
+        const pinned_threads& threads)
+    {
+        const auto start = threads.start_time();
+        for (uint64_t i = 0; i < eventCount; ++i)
+        {
+            if (intervalNS > 0)
+            {
+                const auto due = start + tsc_clock::duration(static_cast<int64_t>(i * intervalNS));
+                while (tsc_clock::now() < due)
+                {
+                }
+            }
+
+            const sequence_t seq = claimStrategy.claim_one();
+            event& e = buffer[seq];
+            e.m_value = i;
+            e.m_publishedNS = NowNS();
+            claimStrategy.publish(seq);
+        }
+    }
+
+    // Consume eventCount events, waiting for each batch with waitFor and
+    // marking it processed on the done barrier. If latency is non-null
+    // the publish-to-consume latency of every event is recorded into it.
+    void Consume(
+        std::function<sequence_t(sequence_t)> waitFor,
+        sequence_barrier<wait_strategy>& done,
+        const ring_buffer<event>& buffer,
+        uint64_t eventCount,
+        benchmark::histogram* latency)
+    {
+        sequence_t nextToRead = 0;
+        uint64_t remaining = eventCount;
+        while (remaining > 0)
+        {
+            const sequence_t available = waitFor(nextToRead);
+            const int64_t readNS = latency != nullptr ? NowNS() : 0;
+            do
+            {
+                if (latency != nullptr)
+                {
+                    latency->record(readNS - buffer[nextToRead].m_publishedNS);
+                }
+                --remaining;
+            } while (nextToRead++ != available);
+            done.publish(available);
+        }
+    }
+
+    uint64_t EventsPerSecond(uint64_t eventCount, tsc_clock::time_point start)
+    {
+        const auto elapsed = tsc_clock::now_ordered() - start;
+        const double elapsedNS = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        return static_cast<uint64_t>(eventCount * 1e9 / elapsedNS);
+    }
+
+    void CheckCount(const benchmark::histogram& latency, uint64_t expected)
+    {
+        if (latency.count() != expected)
+        {
+            throw std::domain_error("Unexpected test result.");
+        }
+    }
+
+    // producer -> consumer
+    run_result RunUnicast(const std::vector<int>& cpus, size_t bufferSize, uint64_t eventCount, double intervalNS)
+    {
+        wait_strategy waitStrategy;
+        single_threaded_claim_strategy<wait_strategy> claimStrategy(bufferSize, waitStrategy);
+        sequence_barrier<wait_strategy> consumed(waitStrategy);
+        claimStrategy.add_claim_barrier(consumed);
+        ring_buffer<event> buffer(bufferSize);
+
+        run_result result;
+        pinned_threads threads(cpus);
+        threads.add([&]() { Produce(claimStrategy, buffer, eventCount, intervalNS, threads); });
+        threads.add([&]()
+        {
+            Consume([&](sequence_t s) { return claimStrategy.wait_until_published(s); },
+                    consumed, buffer, eventCount, &result.latency);
+        });
+        const auto start = threads.start();
+        threads.join();
+        result.eventsPerSecond = EventsPerSecond(eventCount, start);
+        CheckCount(result.latency, eventCount);
+        return result;
+    }
+
+    // producer -> stage 1 -> stage 2 -> stage 3
+    run_result RunPipeline(const std::vector<int>& cpus, size_t bufferSize, uint64_t eventCount, double intervalNS)
+    {
+        wait_strategy waitStrategy;
+        single_threaded_claim_strategy<wait_strategy> claimStrategy(bufferSize, waitStrategy);
+        sequence_barrier<wait_strategy> stage1(waitStrategy);
+        sequence_barrier<wait_strategy> stage2(waitStrategy);
+        sequence_barrier<wait_strategy> stage3(waitStrategy);
+        claimStrategy.add_claim_barrier(stage3);
+        ring_buffer<event> buffer(bufferSize);
+
+        run_result result;
+        pinned_threads threads(cpus);
+        threads.add([&]() { Produce(claimStrategy, buffer, eventCount, intervalNS, threads); });
+        threads.add([&]()
+        {
+            Consume([&](sequence_t s) { return claimStrategy.wait_until_published(s); },
+                    stage1, buffer, eventCount, nullptr);
+        });
+        threads.add([&]()
+        {
+            Consume([&](sequence_t s) { return stage1.wait_until_published(s); },
+                    stage2, buffer, eventCount, nullptr);
+        });
+        threads.add([&]()
+        {
+            Consume([&](sequence_t s) { return stage2.wait_until_published(s); },
+                    stage3, buffer, eventCount, &result.latency);
+        });
+        const auto start = threads.start();
+        threads.join();
+        result.eventsPerSecond = EventsPerSecond(eventCount, start);
+        CheckCount(result.latency, eventCount);
+        return result;
+    }
+
+    // producer -> { consumer 1, consumer 2, consumer 3 }
+    run_result RunMulticast(const std::vector<int>& cpus, size_t bufferSize, uint64_t eventCount, double intervalNS)
+    {
+        wait_strategy waitStrategy;
+        single_threaded_claim_strategy<wait_strategy> claimStrategy(bufferSize, waitStrategy);
+        sequence_barrier<wait_strategy> consumed1(waitStrategy);
+        sequence_barrier<wait_strategy> consumed2(waitStrategy);
+        sequence_barrier<wait_strategy> consumed3(waitStrategy);
+        sequence_barrier_group<wait_strategy> consumed(waitStrategy);
+        consumed.add(consumed1);
+        consumed.add(consumed2);
+        consumed.add(consumed3);
+        claimStrategy.add_claim_barrier(consumed);
+        ring_buffer<event> buffer(bufferSize);
+
+        run_result result;
+        benchmark::histogram latencies[3];
+        sequence_barrier<wait_strategy>* barriers[3] = { &consumed1, &consumed2, &consumed3 };
+        pinned_threads threads(cpus);
+        threads.add([&]() { Produce(claimStrategy, buffer, eventCount, intervalNS, threads); });
+        for (int i = 0; i < 3; ++i)
+        {
+            threads.add([&, i]()
+            {
+                Consume([&](sequence_t s) { return claimStrategy.wait_until_published(s); },
+                        *barriers[i], buffer, eventCount, &latencies[i]);
+            });
+        }
+        const auto start = threads.start();
+        threads.join();
+        result.eventsPerSecond = EventsPerSecond(eventCount, start);
+        for (const auto& latency : latencies)
+        {
+            result.latency.merge(latency);
+        }
+        CheckCount(result.latency, 3 * eventCount);
+        return result;
+    }
+
+    // producer -> { stage 1a, stage 1b } -> stage 2
+    run_result RunDiamond(const std::vector<int>& cpus, size_t bufferSize, uint64_t eventCount, double intervalNS)
+    {
+        wait_strategy waitStrategy;
+        single_threaded_claim_strategy<wait_strategy> claimStrategy(bufferSize, waitStrategy);
+        sequence_barrier<wait_strategy> stage1a(waitStrategy);
+        sequence_barrier<wait_strategy> stage1b(waitStrategy);
+        sequence_barrier<wait_strategy> stage2(waitStrategy);
+        sequence_barrier_group<wait_strategy> stage1(waitStrategy);
+        stage1.add(stage1a);
+        stage1.add(stage1b);
+        claimStrategy.add_claim_barrier(stage2);
+        ring_buffer<event> buffer(bufferSize);
+
+        run_result result;
+        pinned_threads threads(cpus);
+        threads.add([&]() { Produce(claimStrategy, buffer, eventCount, intervalNS, threads); });
+        threads.add([&]()
+        {
+            Consume([&](sequence_t s) { return claimStrategy.wait_until_published(s); },
+                    stage1a, buffer, eventCount, nullptr);
+        });
+        threads.add([&]()
+        {
+            Consume([&](sequence_t s) { return claimStrategy.wait_until_published(s); },
+                    stage1b, buffer, eventCount, nullptr);
+        });
+        threads.add([&]()
+        {
+            Consume([&](sequence_t s) { return stage1.wait_until_published(s); },
+                    stage2, buffer, eventCount, &result.latency);
+        });
+        const auto start = threads.start();
+        threads.join();
+        result.eventsPerSecond = EventsPerSecond(eventCount, start);
+        CheckCount(result.latency, eventCount);
+        return result;
+    }
+
+    // { producer 1, producer 2, producer 3 } -> consumer
+    run_result RunSequencer(const std::vector<int>& cpus, size_t bufferSize, uint64_t eventCount, double intervalNS)
+    {
+        const int producerCount = 3;
+        const uint64_t perProducer = std::max<uint64_t>(1, eventCount / producerCount);
+        const uint64_t totalCount = perProducer * producerCount;
+
+        wait_strategy waitStrategy;
+        multi_threaded_claim_strategy<wait_strategy> claimStrategy(bufferSize, waitStrategy);
+        sequence_barrier<wait_strategy> consumed(waitStrategy);
+        claimStrategy.add_claim_barrier(consumed);
+        ring_buffer<event> buffer(bufferSize);
+
+        run_result result;
+        pinned_threads threads(cpus);
+        for (int i = 0; i < producerCount; ++i)
+        {
+            threads.add([&]() { Produce(claimStrategy, buffer, perProducer, intervalNS * producerCount, threads); });
+        }
+        threads.add([&]()
+        {
+            Consume([&](sequence_t s) { return claimStrategy.wait_until_published(s, s - 1); },
+                    consumed, buffer, totalCount, &result.latency);
+        });
+        const auto start = threads.start();
+        threads.join();
+        result.eventsPerSecond = EventsPerSecond(totalCount, start);
+        CheckCount(result.latency, totalCount);
+        return result;
+    }
+
+    struct topology
+    {
+        const char* name;
+        int threadCount;
+        run_result (*run)(const std::vector<int>&, size_t, uint64_t, double);
+    };
+
+    struct cell
+    {
+        bool available;
+        uint64_t eventsPerSecond;
+        int64_t latencyP50;
+        int64_t latencyP99;
+    };
+
+    void PrintCpus(const std::vector<int>& cpus)
+    {
+        for (size_t i = 0; i < cpus.size(); ++i)
+        {
+            std::cout << (i == 0 ? "" : " ") << cpus[i];
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    // Calibrate the clock so that timestamps read the TSC rather than
+    // steady_clock.
+    disruptorplus::tsc_clock::calibrate();
+
+    const size_t bufferSize = 64 * 1024;
+    const uint64_t throughputEvents = argc > 1 ? std::max(1, std::atoi(argv[1])) : 10 * 1000 * 1000;
+    const uint64_t latencyEvents = argc > 2 ? std::max(1, std::atoi(argv[2])) : 100 * 1000;
+    const uint64_t latencyEventsPerSecond = 100 * 1000;
+
+    std::cout << "Thread Placement Benchmark" << std::endl
+              << "Usage: placement [throughput-event-count [latency-event-count]]" << std::endl
+              << "Buffer size: " << bufferSize << std::endl
+              << "Throughput events: " << throughputEvents << " (unpaced)" << std::endl
+              << "Latency events: " << latencyEvents << " (at " << latencyEventsPerSecond << " events/sec)" << std::endl;
+
+    if (!benchmark::platform_supported())
+    {
+        std::cout << "error: CPU topology is not available on this platform" << std::endl;
+        return 1;
+    }
+
+    const std::vector<topology> topologies = {
+        { "unicast", 2, &RunUnicast },
+        { "pipeline", 4, &RunPipeline },
+        { "diamond", 4, &RunDiamond },
+        { "multicast", 4, &RunMulticast },
+        { "sequencer", 4, &RunSequencer }
+    };
+
+    try
+    {
+        const topology_map cpuTopology = BuildTopologyMap(benchmark::cpu_topology());
+
+        std::cout << "Packages: " << cpuTopology.size() << std::endl;
+        for (placement_class placement : placementClasses)
+        {
+            std::vector<int> cpus;
+            std::cout << "  " << PlacementName(placement) << ": ";
+            if (placement == unpinned)
+            {
+                std::cout << "not pinned";
+            }
+            for (int threadCount : { 2, 4 })
+            {
+                if (placement == unpinned)
+                {
+                    break;
+                }
+                std::cout << (threadCount == 2 ? "" : ", ") << threadCount << " threads -> ";
+                if (SelectCpus(cpuTopology, placement, threadCount, cpus))
+                {
+                    PrintCpus(cpus);
+                }
+                else
+                {
+                    std::cout << "n/a";
+                }
+            }
+            std::cout << std::endl;
+        }
+
+        std::vector<std::vector<cell>> matrix;
+        for (const topology& t : topologies)
+        {
+            matrix.push_back(std::vector<cell>());
+            for (placement_class placement : placementClasses)
+            {
+                cell c = { false, 0, 0, 0 };
+                std::vector<int> cpus;
+                if (SelectCpus(cpuTopology, placement, t.threadCount, cpus))
+                {
+                    c.available = true;
+                    c.eventsPerSecond = t.run(cpus, bufferSize, throughputEvents, 0).eventsPerSecond;
+                    const run_result paced = t.run(cpus, bufferSize, latencyEvents, 1e9 / latencyEventsPerSecond);
+                    c.latencyP50 = static_cast<int64_t>(paced.latency.percentile(50));
+                    c.latencyP99 = static_cast<int64_t>(paced.latency.percentile(99));
+                }
+                matrix.back().push_back(c);
+            }
+        }
+
+        std::cout << std::endl << "Throughput (events/sec)" << std::endl << "Topology";
+        for (placement_class placement : placementClasses)
+        {
+            std::cout << ", " << PlacementName(placement);
+        }
+        std::cout << std::endl;
+        for (size_t i = 0; i < topologies.size(); ++i)
+        {
+            std::cout << topologies[i].name;
+            for (const cell& c : matrix[i])
+            {
+                std::cout << ", ";
+                if (c.available)
+                {
+                    std::cout << c.eventsPerSecond;
+                }
+                else
+                {
+                    std::cout << "n/a";
+                }
+            }
+            std::cout << std::endl;
+        }
+
+        std::cout << std::endl << "Latency P50/P99 (ns)" << std::endl << "Topology";
+        for (placement_class placement : placementClasses)
+        {
+            std::cout << ", " << PlacementName(placement);
+        }
+        std::cout << std::endl;
+        for (size_t i = 0; i < topologies.size(); ++i)
+        {
+            std::cout << topologies[i].name;
+            for (const cell& c : matrix[i])
+            {
+                std::cout << ", ";
+                if (c.available)
+                {
+                    std::cout << c.latencyP50 << "/" << c.latencyP99;
+                }
+                else
+                {
+                    std::cout << "n/a";
+                }
+            }
+            std::cout << std::endl;
+        }
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
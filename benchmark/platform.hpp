@@ -0,0 +1,342 @@
+#ifndef DISRUPTORPLUS_BENCHMARK_PLATFORM_HPP_INCLUDED
+#define DISRUPTORPLUS_BENCHMARK_PLATFORM_HPP_INCLUDED
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+# include <dirent.h>
+# include <linux/perf_event.h>
+# include <sched.h>
+# include <stdlib.h>
+# include <sys/ioctl.h>
+# include <sys/resource.h>
+# include <sys/syscall.h>
+# include <time.h>
+# include <unistd.h>
+# include <cstring>
+# include <fstream>
+# include <sstream>
+#endif
+
+/// \file
+/// \brief
+/// Operating system specific helpers shared by the benchmark programs.
+///
+/// These are only implemented for Linux. On other platforms the queries
+/// report that they are unsupported and return zeroes.
+
+namespace benchmark
+{
+    /// \brief
+    /// Resource usage of the calling thread.
+    struct thread_usage
+    {
+        /// CPU time consumed by the thread in nanoseconds (user + system).
+        int64_t cpuNS;
+
+        /// Number of times the thread blocked and gave up the CPU.
+        int64_t voluntarySwitches;
+
+        /// Number of times the thread was preempted.
+        int64_t involuntarySwitches;
+    };
+
+    /// \brief
+    /// Query whether the helpers in this file are implemented on this platform.
+    inline bool platform_supported()
+    {
+#if defined(__linux__)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /// \brief
+    /// Sample the resource usage of the calling thread.
+    ///
+    /// Take one sample before and one after the region of interest and
+    /// subtract them.
+    inline thread_usage current_thread_usage()
+    {
+        thread_usage usage = { 0, 0, 0 };
+#if defined(__linux__)
+        timespec cpu;
+        if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu) == 0)
+        {
+            usage.cpuNS = static_cast<int64_t>(cpu.tv_sec) * 1000000000 + cpu.tv_nsec;
+        }
+        rusage ru;
+        if (getrusage(RUSAGE_THREAD, &ru) == 0)
+        {
+            usage.voluntarySwitches = ru.ru_nvcsw;
+            usage.involuntarySwitches = ru.ru_nivcsw;
+        }
+#endif
+        return usage;
+    }
+
+    inline thread_usage operator-(const thread_usage& a, const thread_usage& b)
+    {
+        thread_usage result = {
+            a.cpuNS - b.cpuNS,
+            a.voluntarySwitches - b.voluntarySwitches,
+            a.involuntarySwitches - b.involuntarySwitches
+        };
+        return result;
+    }
+
+    /// \brief
+    /// The operating system identifier of the calling thread, or zero if
+    /// not supported.
+    inline int64_t current_thread_id()
+    {
+#if defined(__linux__)
+        return static_cast<int64_t>(syscall(SYS_gettid));
+#else
+        return 0;
+#endif
+    }
+
+    /// \brief
+    /// Query whether a thread of this process is currently blocked in the
+    /// kernel (ie. parked rather than running or runnable).
+    ///
+    /// \param threadId
+    /// A thread identifier returned by current_thread_id().
+    inline bool is_thread_sleeping(int64_t threadId)
+    {
+#if defined(__linux__)
+        std::ostringstream path;
+        path << "/proc/self/task/" << threadId << "/stat";
+        std::ifstream file(path.str().c_str());
+        std::string stat;
+        std::getline(file, stat);
+
+        // Format is "tid (comm) state ...", comm may contain spaces or parentheses.
+        const std::string::size_type commEnd = stat.rfind(')');
+        if (commEnd == std::string::npos || commEnd + 2 >= stat.size())
+        {
+            return false;
+        }
+        const char state = stat[commEnd + 2];
+        return state == 'S' || state == 'D';
+#else
+        (void)threadId;
+        return false;
+#endif
+    }
+
+    /// \brief
+    /// Location of a logical CPU in the machine's topology.
+    struct cpu_info
+    {
+        /// The logical CPU number, as used for thread affinity.
+        int cpu;
+
+        /// Identifier of the physical core. Logical CPUs with the same
+        /// package and core are SMT siblings sharing L1/L2.
+        int core;
+
+        /// Identifier of the physical package (socket).
+        int package;
+    };
+
+    /// \brief
+    /// Enumerate the online logical CPUs from /sys/devices/system/cpu.
+    ///
+    /// Returns an empty list if the topology could not be read.
+    inline std::vector<cpu_info> cpu_topology()
+    {
+        std::vector<cpu_info> cpus;
+#if defined(__linux__)
+        // The online list is a comma-separated list of ranges, eg. "0-3,6".
+        std::ifstream online("/sys/devices/system/cpu/online");
+        std::string ranges;
+        std::getline(online, ranges);
+        std::istringstream rangeStream(ranges);
+        std::string range;
+        while (std::getline(rangeStream, range, ','))
+        {
+            int first = 0;
+            int last = 0;
+            char dash = 0;
+            std::istringstream parse(range);
+            if (!(parse >> first))
+            {
+                continue;
+            }
+            last = (parse >> dash >> last) ? last : first;
+
+            for (int cpu = first; cpu <= last; ++cpu)
+            {
+                std::ostringstream path;
+                path << "/sys/devices/system/cpu/cpu" << cpu << "/topology/";
+                std::ifstream coreFile((path.str() + "core_id").c_str());
+                std::ifstream packageFile((path.str() + "physical_package_id").c_str());
+                cpu_info info = { cpu, 0, 0 };
+                if (coreFile >> info.core && packageFile >> info.package)
+                {
+                    cpus.push_back(info);
+                }
+            }
+        }
+#endif
+        return cpus;
+    }
+
+    /// \brief
+    /// Restrict the calling thread to run only on the given logical CPU.
+    ///
+    /// \return
+    /// \c true if the affinity was set.
+    inline bool pin_current_thread(int cpu)
+    {
+#if defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+        (void)cpu;
+        return false;
+#endif
+    }
+
+    /// \brief
+    /// Create a new, uniquely named directory under \p parent.
+    ///
+    /// \return
+    /// The path of the directory, or an empty string on failure.
+    inline std::string make_temp_directory(const std::string& parent)
+    {
+#if defined(__linux__)
+        std::string path = parent + "/disruptorplus-XXXXXX";
+        if (mkdtemp(&path[0]) != nullptr)
+        {
+            return path;
+        }
+#else
+        (void)parent;
+#endif
+        return std::string();
+    }
+
+    /// \brief
+    /// Remove a directory and the regular files directly inside it.
+    inline void remove_directory(const std::string& path)
+    {
+#if defined(__linux__)
+        if (DIR* dir = opendir(path.c_str()))
+        {
+            while (const dirent* entry = readdir(dir))
+            {
+                const std::string name = entry->d_name;
+                if (name != "." && name != "..")
+                {
+                    unlink((path + "/" + name).c_str());
+                }
+            }
+            closedir(dir);
+        }
+        rmdir(path.c_str());
+#else
+        (void)path;
+#endif
+    }
+
+    /// \brief
+    /// A hardware performance counter counting events across the calling
+    /// thread and any threads it subsequently creates.
+    ///
+    /// Counts from child threads are only accumulated once those threads
+    /// have exited, so join all threads before calling stop().
+    ///
+    /// Opening the counter can fail (eg. unsupported event, insufficient
+    /// permissions or running in a virtual machine) in which case valid()
+    /// returns \c false and stop() returns zero.
+    class perf_counter
+    {
+    public:
+
+        /// \brief
+        /// Open a counter for a raw, model-specific event code.
+        ///
+        /// \param rawConfig
+        /// The event code in the format expected by PERF_TYPE_RAW,
+        /// ie. <tt>(umask << 8) | event</tt> on x86.
+        explicit perf_counter(uint64_t rawConfig)
+        : m_fd(-1)
+        {
+#if defined(__linux__)
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_RAW;
+            attr.config = rawConfig;
+            attr.disabled = 1;
+            attr.inherit = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            m_fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#else
+            (void)rawConfig;
+#endif
+        }
+
+        ~perf_counter()
+        {
+#if defined(__linux__)
+            if (m_fd >= 0)
+            {
+                close(m_fd);
+            }
+#endif
+        }
+
+        bool valid() const { return m_fd >= 0; }
+
+        /// \brief
+        /// Reset the count to zero and start counting.
+        void start()
+        {
+#if defined(__linux__)
+            if (m_fd >= 0)
+            {
+                ioctl(m_fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(m_fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+#endif
+        }
+
+        /// \brief
+        /// Stop counting and return the count since start().
+        int64_t stop()
+        {
+            int64_t count = 0;
+#if defined(__linux__)
+            if (m_fd >= 0)
+            {
+                ioctl(m_fd, PERF_EVENT_IOC_DISABLE, 0);
+                if (read(m_fd, &count, sizeof(count)) != sizeof(count))
+                {
+                    count = 0;
+                }
+            }
+#endif
+            return count;
+        }
+
+    private:
+
+        // Disable copy-construction
+        perf_counter(const perf_counter&);
+
+        int m_fd;
+
+    };
+}
+
+#endif
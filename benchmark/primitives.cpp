@@ -0,0 +1,441 @@
+#include <disruptorplus/single_threaded_claim_strategy.hpp>
+#include <disruptorplus/multi_threaded_claim_strategy.hpp>
+#include <disruptorplus/blocking_wait_strategy.hpp>
+#include <disruptorplus/spin_wait_strategy.hpp>
+#include <disruptorplus/spin_wait.hpp>
+#include <disruptorplus/sequence.hpp>
+#include <disruptorplus/config.hpp>
+#include <disruptorplus/tsc_clock.hpp>
+
+#include "stats.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace disruptorplus;
+
+namespace
+{
+    struct options
+    {
+        // Number of timed samples taken for each measurement.
+        size_t sampleCount;
+
+        // Target duration of each sample in nanoseconds.
+        int64_t sampleTimeNS;
+
+        // Only run measurements whose name contains this string.
+        std::string filter;
+    };
+
+    // Prevents the compiler from discarding computed results.
+    volatile uint64_t g_sink;
+
+    // A sequence on its own cache-line, as it would be in a sequence_barrier.
+    struct padded_sequence
+    {
+        std::atomic<sequence_t> value;
+        uint8_t pad[PaddingSize - sizeof(sequence_t)];
+    };
+
+    // A sequence value that is always far enough ahead that claims
+    // gated on it never block, isolating the cost of the claim itself.
+    const sequence_t neverBlocks = static_cast<sequence_t>(1) << 62;
+
+    int64_t ElapsedNS(tsc_clock::time_point start, tsc_clock::time_point end)
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    }
+
+    void PrintHeader()
+    {
+        std::cout << "Primitive" << ", "
+                  << "Parameter" << ", "
+                  << "Samples" << ", "
+                  << "MedianNS/Op" << ", "
+                  << "MinNS/Op" << ", "
+                  << "MeanNS/Op" << ", "
+                  << "CI95NS/Op" << ", "
+                  << "MADNS/Op" << std::endl;
+    }
+
+    void PrintSummary(const std::string& name, const std::string& parameter, const benchmark::summary& s)
+    {
+        std::cout << std::fixed << std::setprecision(2)
+                  << name << ", "
+                  << parameter << ", "
+                  << s.count << ", "
+                  << s.median << ", "
+                  << s.min << ", "
+                  << s.mean << ", "
+                  << s.ci95 << ", "
+                  << s.mad << std::endl;
+    }
+
+    // Measure the cost of an operation.
+    //
+    // The body is called with an iteration count and must return the elapsed
+    // time in nanoseconds for performing that many iterations. Each iteration
+    // is taken to perform opsPerIteration operations.
+    //
+    // The iteration count is first scaled up until a single sample takes
+    // roughly options::sampleTimeNS, then one warm-up sample is discarded
+    // before options::sampleCount samples are taken.
+    void Measure(
+        const options& opts,
+        const std::string& name,
+        const std::string& parameter,
+        uint64_t opsPerIteration,
+        const std::function<int64_t(uint64_t)>& body)
+    {
+        if (name.find(opts.filter) == std::string::npos)
+        {
+            return;
+        }
+
+        uint64_t iterations = 1;
+        for (;;)
+        {
+            const int64_t elapsed = body(iterations);
+            if (elapsed >= opts.sampleTimeNS / 10 || iterations >= (uint64_t(1) << 40))
+            {
+                const double scale = static_cast<double>(opts.sampleTimeNS) / std::max<int64_t>(elapsed, 1);
+                iterations = std::max<uint64_t>(1, static_cast<uint64_t>(iterations * scale));
+                break;
+            }
+            iterations *= 2;
+        }
+
+        body(iterations);
+
+        std::vector<double> samples;
+        samples.reserve(opts.sampleCount);
+        for (size_t i = 0; i < opts.sampleCount; ++i)
+        {
+            const int64_t elapsed = body(iterations);
+            samples.push_back(static_cast<double>(elapsed) / static_cast<double>(iterations * opsPerIteration));
+        }
+
+        PrintSummary(name, parameter, benchmark::summarise(samples));
+    }
+
+    std::string Param(const char* key, uint64_t value)
+    {
+        std::ostringstream s;
+        s << key << "=" << value;
+        return s.str();
+    }
+
+    void MinimumSequence(const options& opts)
+    {
+        for (size_t count = 1; count <= 512; count *= 2)
+        {
+            std::unique_ptr<padded_sequence[]> storage(new padded_sequence[count]);
+            std::vector<const std::atomic<sequence_t>*> sequences(count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                storage[i].value.store(1000 + i, std::memory_order_relaxed);
+                sequences[i] = &storage[i].value;
+            }
+
+            Measure(opts, "minimum_sequence", Param("count", count), 1, [&](uint64_t iterations) -> int64_t
+            {
+                uint64_t sum = 0;
+                const auto start = tsc_clock::now();
+                for (uint64_t i = 0; i < iterations; ++i)
+                {
+                    sum += minimum_sequence(count, sequences.data());
+                }
+                const auto end = tsc_clock::now_ordered();
+                g_sink = sum;
+                return ElapsedNS(start, end);
+            });
+
+            // All sequences satisfy the minimum so there is no short-circuit.
+            Measure(opts, "minimum_sequence_after", Param("count", count), 1, [&](uint64_t iterations) -> int64_t
+            {
+                uint64_t sum = 0;
+                const auto start = tsc_clock::now();
+                for (uint64_t i = 0; i < iterations; ++i)
+                {
+                    sum += minimum_sequence_after(1000, count, sequences.data());
+                }
+                const auto end = tsc_clock::now_ordered();
+                g_sink = sum;
+                return ElapsedNS(start, end);
+            });
+        }
+    }
+
+    // Measures the aggregate cost per slot claimed when producerCount threads
+    // concurrently claim slots. Claims are never published and never block,
+    // so this isolates contention on the shared claim counter.
+    void ClaimContention(const options& opts)
+    {
+        typedef spin_wait_strategy wait_strategy;
+
+        const size_t batchSizes[] = { 1, 8, 64 };
+
+        for (size_t producerCount = 1; producerCount <= 64; producerCount *= 2)
+        {
+            for (size_t batchSize : batchSizes)
+            {
+                const std::string name = batchSize == 1 ? "claim_one" : "claim(" + std::to_string(batchSize) + ")";
+                Measure(opts, name, Param("producers", producerCount), producerCount * batchSize, [&](uint64_t iterations) -> int64_t
+                {
+                    wait_strategy waitStrategy;
+                    multi_threaded_claim_strategy<wait_strategy> claimStrategy(1024, waitStrategy);
+                    sequence_barrier<wait_strategy> consumed(waitStrategy);
+                    consumed.publish(neverBlocks);
+                    claimStrategy.add_claim_barrier(consumed);
+
+                    std::atomic<size_t> readyCount(0);
+                    std::atomic<bool> go(false);
+                    std::vector<std::thread> producers;
+                    producers.reserve(producerCount);
+                    for (size_t p = 0; p < producerCount; ++p)
+                    {
+                        producers.emplace_back([&]()
+                        {
+                            readyCount.fetch_add(1);
+                            while (!go.load(std::memory_order_acquire))
+                            {
+                                std::this_thread::yield();
+                            }
+                            uint64_t sum = 0;
+                            for (uint64_t i = 0; i < iterations; ++i)
+                            {
+                                if (batchSize == 1)
+                                {
+                                    sum += claimStrategy.claim_one();
+                                }
+                                else
+                                {
+                                    sum += claimStrategy.claim(batchSize).first();
+                                }
+                            }
+                            g_sink = sum;
+                        });
+                    }
+
+                    while (readyCount.load() != producerCount)
+                    {
+                        std::this_thread::yield();
+                    }
+
+                    const auto start = tsc_clock::now();
+                    go.store(true, std::memory_order_release);
+                    for (auto& producer : producers)
+                    {
+                        producer.join();
+                    }
+                    const auto end = tsc_clock::now_ordered();
+                    return ElapsedNS(start, end);
+                });
+            }
+        }
+    }
+
+    // Measures publish(range) for a given range size. Slots are claimed in
+    // large chunks outside of the timed region and then published in ranges
+    // of the requested size.
+    template<typename WaitStrategy>
+    void PublishRange(const options& opts, const char* name)
+    {
+        const size_t bufferSize = 64 * 1024;
+
+        for (size_t rangeSize = 1; rangeSize <= 1024; rangeSize *= 4)
+        {
+            Measure(opts, name, Param("range", rangeSize), rangeSize, [&](uint64_t iterations) -> int64_t
+            {
+                WaitStrategy waitStrategy;
+                multi_threaded_claim_strategy<WaitStrategy> claimStrategy(bufferSize, waitStrategy);
+                sequence_barrier<WaitStrategy> consumed(waitStrategy);
+                consumed.publish(neverBlocks);
+                claimStrategy.add_claim_barrier(consumed);
+
+                const uint64_t rangesPerChunk = (bufferSize / 2) / rangeSize;
+                int64_t elapsed = 0;
+                uint64_t remaining = iterations;
+                while (remaining > 0)
+                {
+                    const uint64_t rangeCount = std::min(remaining, rangesPerChunk);
+                    const sequence_range chunk = claimStrategy.claim(static_cast<size_t>(rangeCount * rangeSize));
+
+                    const auto start = tsc_clock::now();
+                    for (uint64_t i = 0; i < rangeCount; ++i)
+                    {
+                        claimStrategy.publish(sequence_range(chunk[static_cast<size_t>(i * rangeSize)], rangeSize));
+                    }
+                    const auto end = tsc_clock::now_ordered();
+
+                    elapsed += ElapsedNS(start, end);
+                    remaining -= rangeCount;
+                }
+                return elapsed;
+            });
+        }
+    }
+
+    // Measures how quickly a reader can scan forward through published slots.
+    void LastPublishedAfter(const options& opts)
+    {
+        typedef spin_wait_strategy wait_strategy;
+
+        for (size_t bufferSize = 1024; bufferSize <= 1024 * 1024; bufferSize *= 32)
+        {
+            Measure(opts, "last_published_after", Param("buffer", bufferSize), bufferSize, [&](uint64_t iterations) -> int64_t
+            {
+                wait_strategy waitStrategy;
+                multi_threaded_claim_strategy<wait_strategy> claimStrategy(bufferSize, waitStrategy);
+                sequence_barrier<wait_strategy> consumed(waitStrategy);
+                consumed.publish(neverBlocks);
+                claimStrategy.add_claim_barrier(consumed);
+
+                int64_t elapsed = 0;
+                for (uint64_t i = 0; i < iterations; ++i)
+                {
+                    const sequence_range range = claimStrategy.claim(bufferSize);
+                    claimStrategy.publish(range);
+
+                    const auto start = tsc_clock::now();
+                    const sequence_t last = claimStrategy.last_published_after(range.first() - 1);
+                    const auto end = tsc_clock::now_ordered();
+
+                    if (last != range.last())
+                    {
+                        throw std::domain_error("Unexpected test result.");
+                    }
+                    elapsed += ElapsedNS(start, end);
+                }
+                return elapsed;
+            });
+        }
+    }
+
+    // Measures the duration of each successive call to spin_wait::spin_once(),
+    // which corresponds to the phases of its back-off.
+    void SpinOnce(const options& opts)
+    {
+        const char* name = "spin_wait::spin_once";
+        if (std::string(name).find(opts.filter) == std::string::npos)
+        {
+            return;
+        }
+
+        const size_t phaseCount = 30;
+        std::vector<std::vector<double>> samples(phaseCount);
+        for (size_t run = 0; run < opts.sampleCount; ++run)
+        {
+            spin_wait spinner;
+            for (size_t phase = 0; phase < phaseCount; ++phase)
+            {
+                const auto start = tsc_clock::now();
+                spinner.spin_once();
+                const auto end = tsc_clock::now_ordered();
+                samples[phase].push_back(static_cast<double>(ElapsedNS(start, end)));
+            }
+        }
+
+        for (size_t phase = 0; phase < phaseCount; ++phase)
+        {
+            PrintSummary(name, Param("call", phase), benchmark::summarise(samples[phase]));
+        }
+    }
+
+    // Measures signal_all_when_blocking() with waiterCount threads parked
+    // on a barrier that is not published until the measurement completes.
+    template<typename WaitStrategy>
+    void SignalAllWhenBlocking(const options& opts, const char* name)
+    {
+        for (size_t waiterCount = 0; waiterCount <= 4; waiterCount = waiterCount == 0 ? 1 : waiterCount * 4)
+        {
+            Measure(opts, name, Param("waiters", waiterCount), 1, [&](uint64_t iterations) -> int64_t
+            {
+                WaitStrategy waitStrategy;
+                sequence_barrier<WaitStrategy> neverPublished(waitStrategy);
+
+                std::vector<std::thread> waiters;
+                for (size_t w = 0; w < waiterCount; ++w)
+                {
+                    waiters.emplace_back([&]()
+                    {
+                        neverPublished.wait_until_published(0);
+                    });
+                }
+
+                // Give the waiters time to block.
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+                const auto start = tsc_clock::now();
+                for (uint64_t i = 0; i < iterations; ++i)
+                {
+                    waitStrategy.signal_all_when_blocking();
+                }
+                const auto end = tsc_clock::now_ordered();
+
+                neverPublished.publish(0);
+                for (auto& waiter : waiters)
+                {
+                    waiter.join();
+                }
+
+                return ElapsedNS(start, end);
+            });
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    // Calibrate the clock so that timestamps read the TSC rather than
+    // steady_clock.
+    disruptorplus::tsc_clock::calibrate();
+
+    options opts;
+    opts.sampleCount = 21;
+    opts.sampleTimeNS = 5 * 1000 * 1000;
+    opts.filter = argc > 1 ? argv[1] : "";
+    if (argc > 2)
+    {
+        opts.sampleCount = std::max(1, std::atoi(argv[2]));
+    }
+
+    std::cout << "Primitive Microbenchmarks" << std::endl
+              << "Usage: primitives [filter [sample-count]]" << std::endl
+              << "Sample count: " << opts.sampleCount << std::endl
+              << "Sample time: " << opts.sampleTimeNS / 1000 << "us" << std::endl
+              << "TSC clock: " << (tsc_clock::is_tsc() ? "yes" : "no (steady_clock)") << std::endl;
+
+    try
+    {
+        PrintHeader();
+        MinimumSequence(opts);
+        ClaimContention(opts);
+        PublishRange<spin_wait_strategy>(opts, "publish(range)/spin_wait_strategy");
+        PublishRange<blocking_wait_strategy>(opts, "publish(range)/blocking_wait_strategy");
+        LastPublishedAfter(opts);
+        SpinOnce(opts);
+        SignalAllWhenBlocking<spin_wait_strategy>(opts, "signal_all_when_blocking/spin_wait_strategy");
+        SignalAllWhenBlocking<blocking_wait_strategy>(opts, "signal_all_when_blocking/blocking_wait_strategy");
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
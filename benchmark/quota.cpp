@@ -0,0 +1,232 @@
+#include <disruptorplus/multi_threaded_claim_strategy.hpp>
+#include <disruptorplus/spin_wait_strategy.hpp>
+#include <disruptorplus/ring_buffer.hpp>
+#include <disruptorplus/producer_quota.hpp>
+#include <disruptorplus/tsc_clock.hpp>
+
+#include "stats.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace disruptorplus;
+
+namespace
+{
+    struct event
+    {
+        int64_t m_publishedNS;
+        uint32_t m_producer;
+        bool m_last;
+    };
+
+    typedef multi_threaded_claim_strategy<spin_wait_strategy> claim_strategy;
+
+    int64_t NowNS()
+    {
+        return tsc_clock::now().time_since_epoch().count();
+    }
+
+    void SpinFor(int64_t ns)
+    {
+        const int64_t until = NowNS() + ns;
+        while (NowNS() < until)
+        {
+        }
+    }
+
+    void PrintHeader()
+    {
+        std::cout << "Quotas" << ", "
+                  << "BulkProducers" << ", "
+                  << "BulkQuota" << ", "
+                  << "BulkEvents/Sec" << ", "
+                  << "CriticalClaimP99NS" << ", "
+                  << "CriticalClaimMaxNS" << ", "
+                  << "CriticalLatencyP50NS" << ", "
+                  << "CriticalLatencyP99NS" << ", "
+                  << "CriticalLatencyMaxNS" << std::endl;
+    }
+
+    // critical producer (paced) + bulk producers (flat out) -> slow consumer
+    //
+    // Producer 0 is latency-critical. Without quotas the bulk producers
+    // keep the ring full so the critical producer waits both to claim and
+    // behind a full ring of bulk events. With quotas the bulk producers
+    // share a quarter of the ring.
+    void Run(
+        bool quotas,
+        size_t bulkCount,
+        size_t bufferSize,
+        std::chrono::milliseconds duration,
+        int64_t criticalIntervalNS,
+        int64_t consumerWorkNS)
+    {
+        spin_wait_strategy waitStrategy;
+        claim_strategy claimStrategy(bufferSize, waitStrategy);
+        sequence_barrier<spin_wait_strategy> consumed(waitStrategy);
+        claimStrategy.add_claim_barrier(consumed);
+        ring_buffer<event> buffer(bufferSize);
+
+        // The bulk producers get one share each of 4 * bulkCount; the
+        // critical producer gets the remaining three quarters.
+        const size_t totalWeight = 4 * bulkCount;
+        const size_t bulkQuota = fair_share_quota(bufferSize, 1, totalWeight);
+        const size_t criticalQuota = fair_share_quota(bufferSize, totalWeight - bulkCount, totalWeight);
+
+        std::atomic<bool> stop(false);
+        std::vector<uint64_t> bulkEvents(bulkCount, 0);
+        benchmark::histogram criticalClaim;
+        benchmark::histogram criticalLatency;
+
+        std::thread consumer([&]()
+        {
+            sequence_t nextToRead = 0;
+            bool done = false;
+            while (!done)
+            {
+                const sequence_t available = claimStrategy.wait_until_published(nextToRead, nextToRead - 1);
+                do
+                {
+                    const event& e = buffer[nextToRead];
+                    if (e.m_last)
+                    {
+                        done = true;
+                    }
+                    else if (e.m_producer == 0)
+                    {
+                        criticalLatency.record(NowNS() - e.m_publishedNS);
+                    }
+                    SpinFor(consumerWorkNS);
+                } while (nextToRead++ != available);
+                consumed.publish(available);
+            }
+        });
+
+        std::vector<std::thread> bulk;
+        for (size_t b = 0; b < bulkCount; ++b)
+        {
+            bulk.emplace_back([&, b]()
+            {
+                producer_quota<spin_wait_strategy> quota(claimStrategy, bulkQuota);
+                uint64_t count = 0;
+                while (!stop.load(std::memory_order_relaxed))
+                {
+                    const sequence_range range = quotas ? quota.claim(64) : claimStrategy.claim(64);
+                    for (size_t i = 0; i < range.size(); ++i)
+                    {
+                        event& e = buffer[range[i]];
+                        e.m_publishedNS = NowNS();
+                        e.m_producer = static_cast<uint32_t>(b + 1);
+                        e.m_last = false;
+                    }
+                    claimStrategy.publish(range);
+                    count += range.size();
+                }
+                bulkEvents[b] = count;
+            });
+        }
+
+        const auto start = tsc_clock::now();
+        {
+            producer_quota<spin_wait_strategy> quota(claimStrategy, criticalQuota);
+            const int64_t endNS = NowNS() + std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+            int64_t nextNS = NowNS();
+            while (NowNS() < endNS)
+            {
+                while (NowNS() < nextNS)
+                {
+                }
+                nextNS += criticalIntervalNS;
+
+                const int64_t claimStart = NowNS();
+                const sequence_t seq = quotas ? quota.claim_one() : claimStrategy.claim_one();
+                criticalClaim.record(NowNS() - claimStart);
+                event& e = buffer[seq];
+                e.m_publishedNS = NowNS();
+                e.m_producer = 0;
+                e.m_last = false;
+                claimStrategy.publish(seq);
+            }
+        }
+        stop = true;
+        for (auto& producer : bulk)
+        {
+            producer.join();
+        }
+        const auto elapsed = tsc_clock::now_ordered() - start;
+        const double elapsedNS = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+
+        const sequence_t seq = claimStrategy.claim_one();
+        buffer[seq].m_last = true;
+        claimStrategy.publish(seq);
+        consumer.join();
+
+        if (criticalLatency.count() != criticalClaim.count())
+        {
+            throw std::domain_error("Unexpected test result.");
+        }
+
+        uint64_t totalBulk = 0;
+        for (uint64_t count : bulkEvents)
+        {
+            totalBulk += count;
+        }
+
+        std::cout << (quotas ? "quota" : "none") << ", "
+                  << bulkCount << ", "
+                  << (quotas ? bulkQuota : bufferSize) << ", "
+                  << static_cast<uint64_t>(totalBulk * 1e9 / elapsedNS) << ", "
+                  << criticalClaim.percentile(99) << ", "
+                  << criticalClaim.max() << ", "
+                  << criticalLatency.percentile(50) << ", "
+                  << criticalLatency.percentile(99) << ", "
+                  << criticalLatency.max() << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    // Calibrate the clock so that timestamps read the TSC rather than
+    // steady_clock.
+    disruptorplus::tsc_clock::calibrate();
+
+    const int durationMS = argc > 1 ? std::max(1, std::atoi(argv[1])) : 2000;
+    const size_t bufferSize = 16 * 1024;
+    const int64_t criticalIntervalNS = 10 * 1000;
+    const int64_t consumerWorkNS = 100;
+
+    std::cout << "Producer Quota Benchmark" << std::endl
+              << "Usage: quota [milliseconds-per-run]" << std::endl
+              << "Duration: " << durationMS << "ms" << std::endl
+              << "Buffer size: " << bufferSize << std::endl
+              << "Critical producer interval: " << criticalIntervalNS << "ns" << std::endl
+              << "Consumer work: " << consumerWorkNS << "ns per event" << std::endl;
+
+    try
+    {
+        PrintHeader();
+
+        for (size_t bulkCount : { 1, 3 })
+        {
+            Run(false, bulkCount, bufferSize, std::chrono::milliseconds(durationMS), criticalIntervalNS, consumerWorkNS);
+            Run(true, bulkCount, bufferSize, std::chrono::milliseconds(durationMS), criticalIntervalNS, consumerWorkNS);
+        }
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,230 @@
+#include <disruptorplus/single_threaded_claim_strategy.hpp>
+#include <disruptorplus/spin_wait_strategy.hpp>
+#include <disruptorplus/sequence_barrier_group.hpp>
+#include <disruptorplus/ring_buffer.hpp>
+#include <disruptorplus/sequence_reclaimer.hpp>
+#include <disruptorplus/tsc_clock.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace disruptorplus;
+
+namespace
+{
+    const size_t RouteCount = 256;
+
+    // A shared lookup table that consumers read for every event.
+    struct routing_table
+    {
+        uint64_t m_version;
+        uint64_t m_routes[RouteCount];
+    };
+
+    struct event
+    {
+        uint32_t m_key;
+    };
+
+    enum class scheme
+    {
+        // Consumers take a reference count on every lookup.
+        shared,
+
+        // Consumers load a raw pointer; retired tables are reclaimed
+        // once the consumers' barriers have passed them.
+        sequence
+    };
+
+    routing_table* MakeTable(uint64_t version)
+    {
+        routing_table* table = new routing_table;
+        table->m_version = version;
+        for (size_t i = 0; i < RouteCount; ++i)
+        {
+            table->m_routes[i] = version + i;
+        }
+        return table;
+    }
+
+    // Overwrite a table before freeing it so that consumers still reading
+    // it fail the consistency check.
+    void PoisonAndDelete(void* object)
+    {
+        routing_table* table = static_cast<routing_table*>(object);
+        std::memset(table, 0xDD, sizeof(*table));
+        delete table;
+    }
+
+    void PrintHeader()
+    {
+        std::cout << "Scheme" << ", "
+                  << "Consumers" << ", "
+                  << "UpdateEvery" << ", "
+                  << "Events/Sec" << ", "
+                  << "Updates" << ", "
+                  << "PeakPending" << std::endl;
+    }
+
+    // producer (which also updates the table) -> consumers (which look up
+    // every event in the table)
+    void Run(scheme s, size_t consumerCount, uint64_t updateEvery, size_t bufferSize, uint64_t eventCount)
+    {
+        spin_wait_strategy waitStrategy;
+        single_threaded_claim_strategy<spin_wait_strategy> claimStrategy(bufferSize, waitStrategy);
+        std::vector<std::unique_ptr<sequence_barrier<spin_wait_strategy>>> consumed;
+        sequence_barrier_group<spin_wait_strategy> allConsumed(waitStrategy);
+        for (size_t i = 0; i < consumerCount; ++i)
+        {
+            consumed.emplace_back(new sequence_barrier<spin_wait_strategy>(waitStrategy));
+            claimStrategy.add_claim_barrier(*consumed.back());
+            allConsumed.add(*consumed.back());
+        }
+        ring_buffer<event> buffer(bufferSize);
+
+        std::shared_ptr<routing_table> sharedTable(MakeTable(0), &PoisonAndDelete);
+        std::atomic<routing_table*> rawTable(MakeTable(0));
+        sequence_reclaimer<sequence_barrier_group<spin_wait_strategy>> reclaimer(allConsumed);
+
+        const sequence_t last = static_cast<sequence_t>(eventCount - 1);
+        std::atomic<bool> ok(true);
+
+        std::vector<std::thread> consumers;
+        for (size_t c = 0; c < consumerCount; ++c)
+        {
+            consumers.emplace_back([&, c]()
+            {
+                uint64_t sum = 0;
+                sequence_t nextToRead = 0;
+                while (difference(nextToRead, last) <= 0)
+                {
+                    const sequence_t available = claimStrategy.wait_until_published(nextToRead);
+                    do
+                    {
+                        const uint32_t key = buffer[nextToRead].m_key % RouteCount;
+                        uint64_t version;
+                        uint64_t route;
+                        if (s == scheme::shared)
+                        {
+                            const std::shared_ptr<routing_table> table = std::atomic_load(&sharedTable);
+                            version = table->m_version;
+                            route = table->m_routes[key];
+                        }
+                        else
+                        {
+                            const routing_table* table = rawTable.load(std::memory_order_acquire);
+                            version = table->m_version;
+                            route = table->m_routes[key];
+                        }
+                        if (route != version + key)
+                        {
+                            ok = false;
+                        }
+                        sum += route;
+                    } while (nextToRead++ != available);
+                    consumed[c]->publish(available);
+                }
+                volatile uint64_t sink = sum;
+                (void)sink;
+            });
+        }
+
+        uint64_t updates = 0;
+        size_t peakPending = 0;
+        const auto start = tsc_clock::now();
+        for (uint64_t i = 0; i < eventCount; ++i)
+        {
+            if (i % updateEvery == updateEvery - 1)
+            {
+                ++updates;
+                if (s == scheme::shared)
+                {
+                    std::shared_ptr<routing_table> table(MakeTable(updates), &PoisonAndDelete);
+                    std::atomic_store(&sharedTable, table);
+                }
+                else
+                {
+                    routing_table* old = rawTable.exchange(MakeTable(updates), std::memory_order_acq_rel);
+                    reclaimer.retire(old, &PoisonAndDelete, claimStrategy.last_published());
+                    peakPending = std::max(peakPending, reclaimer.pending());
+                }
+            }
+
+            const sequence_t seq = claimStrategy.claim_one();
+            buffer[seq].m_key = static_cast<uint32_t>(i * 2654435761u);
+            claimStrategy.publish(seq);
+        }
+
+        for (auto& consumer : consumers)
+        {
+            consumer.join();
+        }
+        const auto elapsed = tsc_clock::now_ordered() - start;
+        const double elapsedNS = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+
+        reclaimer.reclaim();
+        if (reclaimer.pending() != 0)
+        {
+            ok = false;
+        }
+        PoisonAndDelete(rawTable.load());
+
+        if (!ok)
+        {
+            throw std::domain_error("Unexpected test result.");
+        }
+
+        std::cout << (s == scheme::shared ? "shared_ptr" : "sequence") << ", "
+                  << consumerCount << ", "
+                  << updateEvery << ", "
+                  << static_cast<uint64_t>(eventCount * 1e9 / elapsedNS) << ", "
+                  << updates << ", "
+                  << peakPending << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    // Calibrate the clock so that timestamps read the TSC rather than
+    // steady_clock.
+    disruptorplus::tsc_clock::calibrate();
+
+    const uint64_t eventCount = argc > 1 ? std::max(1, std::atoi(argv[1])) : 10 * 1000 * 1000;
+    const size_t bufferSize = 16 * 1024;
+
+    std::cout << "Sequence Reclamation Benchmark" << std::endl
+              << "Usage: reclaim [event-count]" << std::endl
+              << "Event count: " << eventCount << std::endl
+              << "Buffer size: " << bufferSize << std::endl;
+
+    try
+    {
+        PrintHeader();
+
+        for (size_t consumerCount : { 1, 2, 4 })
+        {
+            for (uint64_t updateEvery : { 100, 10000 })
+            {
+                Run(scheme::shared, consumerCount, updateEvery, bufferSize, eventCount);
+                Run(scheme::sequence, consumerCount, updateEvery, bufferSize, eventCount);
+            }
+        }
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
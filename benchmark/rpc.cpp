@@ -0,0 +1,174 @@
+#include <disruptorplus/spin_wait_strategy.hpp>
+#include <disruptorplus/blocking_wait_strategy.hpp>
+#include <disruptorplus/request_channel.hpp>
+#include <disruptorplus/tsc_clock.hpp>
+
+#include "stats.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace disruptorplus;
+
+namespace
+{
+    struct request
+    {
+        uint64_t m_value;
+        bool m_stop;
+    };
+
+    struct response
+    {
+        uint64_t m_value;
+    };
+
+    int64_t NowNS()
+    {
+        return tsc_clock::now().time_since_epoch().count();
+    }
+
+    void PrintHeader()
+    {
+        std::cout << "ReplyWait" << ", "
+                  << "Callers" << ", "
+                  << "Calls/Sec" << ", "
+                  << "RttP50NS" << ", "
+                  << "RttP99NS" << ", "
+                  << "RttP99.9NS" << ", "
+                  << "RttMaxNS" << std::endl;
+    }
+
+    // callers -> request ring -> server -> per-caller reply slots
+    //
+    // With sharedWait all callers park on one wait strategy, so every reply
+    // wakes every parked caller.
+    template<typename WaitStrategy>
+    void Run(const char* name, bool sharedWait, size_t callerCount, uint64_t totalCalls)
+    {
+        typedef request_channel<request, response, WaitStrategy> channel_type;
+
+        const size_t bufferSize = 1024;
+        const uint64_t callsPerCaller = std::max<uint64_t>(1, totalCalls / callerCount);
+
+        WaitStrategy waitStrategy;
+        WaitStrategy replyWaitStrategy;
+        channel_type channel(waitStrategy, bufferSize);
+        std::vector<typename channel_type::caller*> callers;
+        for (size_t c = 0; c <= callerCount; ++c)
+        {
+            callers.push_back(sharedWait ? &channel.add_caller(replyWaitStrategy) : &channel.add_caller());
+        }
+
+        std::thread server([&]()
+        {
+            bool done = false;
+            while (!done)
+            {
+                channel.process([&](const request& req, response& resp)
+                {
+                    if (req.m_stop)
+                    {
+                        done = true;
+                    }
+                    resp.m_value = req.m_value * 2 + 1;
+                });
+            }
+        });
+
+        std::atomic<bool> ok(true);
+        std::vector<benchmark::histogram> rtts(callerCount);
+        std::vector<std::thread> threads;
+        const auto start = tsc_clock::now();
+        for (size_t c = 0; c < callerCount; ++c)
+        {
+            threads.emplace_back([&, c]()
+            {
+                typename channel_type::caller& caller = *callers[c];
+                for (uint64_t i = 0; i < callsPerCaller; ++i)
+                {
+                    request req;
+                    req.m_value = c * callsPerCaller + i;
+                    req.m_stop = false;
+                    const int64_t sent = NowNS();
+                    const response& resp = caller.call(req);
+                    rtts[c].record(NowNS() - sent);
+                    if (resp.m_value != req.m_value * 2 + 1)
+                    {
+                        ok = false;
+                    }
+                }
+            });
+        }
+        for (auto& t : threads)
+        {
+            t.join();
+        }
+        const auto elapsed = tsc_clock::now_ordered() - start;
+        const double elapsedNS = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+
+        request stop;
+        stop.m_value = 0;
+        stop.m_stop = true;
+        callers[callerCount]->call(stop);
+        server.join();
+
+        benchmark::histogram rtt;
+        for (auto& h : rtts)
+        {
+            rtt.merge(h);
+        }
+        if (!ok || rtt.count() != callsPerCaller * callerCount)
+        {
+            throw std::domain_error("Unexpected test result.");
+        }
+
+        std::cout << name << ", "
+                  << callerCount << ", "
+                  << static_cast<uint64_t>(rtt.count() * 1e9 / elapsedNS) << ", "
+                  << rtt.percentile(50) << ", "
+                  << rtt.percentile(99) << ", "
+                  << rtt.percentile(99.9) << ", "
+                  << rtt.max() << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    // Calibrate the clock so that timestamps read the TSC rather than
+    // steady_clock.
+    disruptorplus::tsc_clock::calibrate();
+
+    const uint64_t totalCalls = argc > 1 ? std::max(1, std::atoi(argv[1])) : 1000 * 1000;
+
+    std::cout << "Request/Response Channel Benchmark" << std::endl
+              << "Usage: rpc [calls-per-run]" << std::endl
+              << "Calls per run: " << totalCalls << std::endl;
+
+    try
+    {
+        PrintHeader();
+
+        for (size_t callerCount : { 1, 2, 4, 8, 16, 32 })
+        {
+            Run<spin_wait_strategy>("spin", false, callerCount, totalCalls);
+            Run<blocking_wait_strategy>("park", false, callerCount, totalCalls);
+            Run<blocking_wait_strategy>("park-shared", true, callerCount, totalCalls);
+        }
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
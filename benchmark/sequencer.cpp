@@ -3,6 +3,7 @@
 #include <disruptorplus/blocking_wait_strategy.hpp>
 #include <disruptorplus/spin_wait_strategy.hpp>
 #include <disruptorplus/ring_buffer.hpp>
+#include <disruptorplus/tsc_clock.hpp>
 
 #include <thread>
 #include <chrono>
@@ -25,7 +26,7 @@ namespace
         std::vector<std::thread> producers;
         producers.reserve(producerCount);
 
-        const auto start = std::chrono::high_resolution_clock::now();
+        const auto start = disruptorplus::tsc_clock::now();
         
         // Producers
         for (int producerIndex = 0; producerIndex < producerCount; ++producerIndex)
@@ -66,7 +67,7 @@ namespace
             throw std::domain_error("Unexpected test result.");
         }
 
-        const auto timeTaken = std::chrono::high_resolution_clock::now() - start;
+        const auto timeTaken = disruptorplus::tsc_clock::now_ordered() - start;
         const auto timeTakenUS = std::chrono::duration_cast<std::chrono::microseconds>(timeTaken).count();
 
         return (producerCount * iterationCount * 1000 * 1000) / timeTakenUS;
@@ -75,6 +76,10 @@ namespace
 
 int main()
 {
+    // Calibrate the clock so that timestamps read the TSC rather than
+    // steady_clock.
+    disruptorplus::tsc_clock::calibrate();
+
     const int producerCount = 3;
     const size_t bufferSize = 64 * 1024;
     const uint64_t iterationCount = 10 * 1000 * 1000;
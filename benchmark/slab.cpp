@@ -0,0 +1,273 @@
+#include <disruptorplus/multi_threaded_claim_strategy.hpp>
+#include <disruptorplus/spin_wait_strategy.hpp>
+#include <disruptorplus/ring_buffer.hpp>
+#include <disruptorplus/payload_slab.hpp>
+#include <disruptorplus/tsc_clock.hpp>
+
+#include "stats.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace disruptorplus;
+
+namespace
+{
+    struct event
+    {
+        char* m_body;
+        uint32_t m_size;
+        uint32_t m_producer;
+        uint64_t m_counter;
+    };
+
+    enum class allocator_kind
+    {
+        heap,
+        slab
+    };
+
+    struct body_profile
+    {
+        const char* m_name;
+        uint32_t m_minSize;
+        uint32_t m_maxSize;
+    };
+
+    // Deterministic xorshift64* generator.
+    class random
+    {
+    public:
+
+        explicit random(uint64_t seed)
+        : m_state(seed != 0 ? seed : 0x9E3779B97F4A7C15ull)
+        {}
+
+        uint64_t next()
+        {
+            m_state ^= m_state >> 12;
+            m_state ^= m_state << 25;
+            m_state ^= m_state >> 27;
+            return m_state * 0x2545F4914F6CDD1Dull;
+        }
+
+        uint32_t next(uint32_t bound)
+        {
+            return static_cast<uint32_t>((next() >> 32) % bound);
+        }
+
+    private:
+
+        uint64_t m_state;
+
+    };
+
+    int64_t NowNS()
+    {
+        return tsc_clock::now().time_since_epoch().count();
+    }
+
+    void PrintHeader()
+    {
+        std::cout << "Producers" << ", "
+                  << "Bodies" << ", "
+                  << "Allocator" << ", "
+                  << "Events/Sec" << ", "
+                  << "MB/Sec" << ", "
+                  << "AllocP50NS" << ", "
+                  << "AllocP99NS" << ", "
+                  << "AllocMaxNS" << std::endl;
+    }
+
+    // producers (each allocating a body per event) -> consumer (which
+    // checks and releases the bodies)
+    //
+    // With the heap allocator the consumer frees each body; with the slab
+    // each producer has its own slab gated on the consumer's barrier.
+    void Run(
+        size_t producerCount,
+        const body_profile& profile,
+        allocator_kind kind,
+        size_t bufferSize,
+        uint64_t eventsPerProducer)
+    {
+        typedef payload_slab<sequence_barrier<spin_wait_strategy>> slab;
+
+        spin_wait_strategy waitStrategy;
+        multi_threaded_claim_strategy<spin_wait_strategy> claimStrategy(bufferSize, waitStrategy);
+        sequence_barrier<spin_wait_strategy> consumed(waitStrategy);
+        claimStrategy.add_claim_barrier(consumed);
+        ring_buffer<event> buffer(bufferSize);
+
+        // Room for a quarter of a ring of the largest bodies, so a slab
+        // can fill up and have to wait on the consumer like the ring does.
+        size_t slabCapacity = 1;
+        while (slabCapacity < bufferSize / 4 * (profile.m_maxSize + 64))
+        {
+            slabCapacity *= 2;
+        }
+        std::vector<std::unique_ptr<slab>> slabs;
+        if (kind == allocator_kind::slab)
+        {
+            for (size_t i = 0; i < producerCount; ++i)
+            {
+                slabs.emplace_back(new slab(consumed, slabCapacity, 64));
+            }
+        }
+
+        const uint64_t eventCount = eventsPerProducer * producerCount;
+        const sequence_t last = static_cast<sequence_t>(eventCount - 1);
+        uint64_t bytes = 0;
+        bool ok = true;
+
+        std::thread consumer([&]()
+        {
+            std::vector<uint64_t> counters(producerCount, 0);
+            sequence_t nextToRead = 0;
+            sequence_t lastKnownPublished = static_cast<sequence_t>(-1);
+            while (difference(nextToRead, last) <= 0)
+            {
+                const sequence_t available = claimStrategy.wait_until_published(nextToRead, lastKnownPublished);
+                lastKnownPublished = available;
+                do
+                {
+                    event& e = buffer[nextToRead];
+                    uint64_t head;
+                    uint64_t tail;
+                    std::memcpy(&head, e.m_body, sizeof(head));
+                    std::memcpy(&tail, e.m_body + e.m_size - sizeof(tail), sizeof(tail));
+                    if (head != e.m_counter || tail != e.m_counter ||
+                        e.m_counter != counters[e.m_producer]++)
+                    {
+                        ok = false;
+                    }
+                    bytes += e.m_size;
+                    if (kind == allocator_kind::heap)
+                    {
+                        std::free(e.m_body);
+                    }
+                } while (nextToRead++ != available);
+                consumed.publish(available);
+            }
+        });
+
+        std::vector<benchmark::histogram> allocLatency(producerCount);
+        std::vector<std::thread> producers;
+        const auto start = tsc_clock::now();
+        for (size_t p = 0; p < producerCount; ++p)
+        {
+            producers.emplace_back([&, p]()
+            {
+                random rng(p + 1);
+                benchmark::histogram& latency = allocLatency[p];
+                const uint32_t range = profile.m_maxSize - profile.m_minSize + 1;
+                for (uint64_t i = 0; i < eventsPerProducer; ++i)
+                {
+                    const uint32_t size = profile.m_minSize + rng.next(range);
+                    const sequence_t seq = claimStrategy.claim_one();
+
+                    const int64_t allocStart = NowNS();
+                    char* body = kind == allocator_kind::heap ?
+                        static_cast<char*>(std::malloc(size)) :
+                        static_cast<char*>(slabs[p]->allocate(seq, size));
+                    latency.record(NowNS() - allocStart);
+                    if (body == nullptr)
+                    {
+                        throw std::bad_alloc();
+                    }
+
+                    std::memset(body, static_cast<int>(i), size);
+                    std::memcpy(body, &i, sizeof(i));
+                    std::memcpy(body + size - sizeof(i), &i, sizeof(i));
+
+                    event& e = buffer[seq];
+                    e.m_body = body;
+                    e.m_size = size;
+                    e.m_producer = static_cast<uint32_t>(p);
+                    e.m_counter = i;
+                    claimStrategy.publish(seq);
+                }
+            });
+        }
+        for (auto& producer : producers)
+        {
+            producer.join();
+        }
+        consumer.join();
+        const auto elapsed = tsc_clock::now_ordered() - start;
+        const double elapsedNS = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+
+        if (!ok)
+        {
+            throw std::domain_error("Unexpected test result.");
+        }
+
+        benchmark::histogram latency;
+        for (const auto& h : allocLatency)
+        {
+            latency.merge(h);
+        }
+
+        std::cout << producerCount << ", "
+                  << profile.m_name << ", "
+                  << (kind == allocator_kind::slab ? "slab" : "heap") << ", "
+                  << static_cast<uint64_t>(eventCount * 1e9 / elapsedNS) << ", "
+                  << static_cast<uint64_t>(bytes * 1e9 / elapsedNS / (1024 * 1024)) << ", "
+                  << latency.percentile(50) << ", "
+                  << latency.percentile(99) << ", "
+                  << latency.max() << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    // Calibrate the clock so that timestamps read the TSC rather than
+    // steady_clock.
+    disruptorplus::tsc_clock::calibrate();
+
+    const uint64_t eventsPerProducer = argc > 1 ? std::max(1, std::atoi(argv[1])) : 1000 * 1000;
+    const size_t bufferSize = 1024;
+
+    std::cout << "Payload Slab Benchmark" << std::endl
+              << "Usage: slab [events-per-producer]" << std::endl
+              << "Events per producer: " << eventsPerProducer << std::endl
+              << "Buffer size: " << bufferSize << std::endl;
+
+    const body_profile profiles[] = {
+        { "64B-512B", 64, 512 },
+        { "4KB-64KB", 4 * 1024, 64 * 1024 },
+    };
+
+    try
+    {
+        PrintHeader();
+
+        for (size_t producerCount : { 1, 2, 4 })
+        {
+            for (const body_profile& profile : profiles)
+            {
+                // Fewer events for large bodies to keep the run time similar.
+                const uint64_t events = profile.m_maxSize > 4096 ?
+                    std::max<uint64_t>(1, eventsPerProducer / 8) : eventsPerProducer;
+                Run(producerCount, profile, allocator_kind::heap, bufferSize, events);
+                Run(producerCount, profile, allocator_kind::slab, bufferSize, events);
+            }
+        }
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
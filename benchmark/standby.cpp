@@ -0,0 +1,243 @@
+#include <disruptorplus/single_threaded_claim_strategy.hpp>
+#include <disruptorplus/spin_wait_strategy.hpp>
+#include <disruptorplus/sequence_barrier_group.hpp>
+#include <disruptorplus/sequence_barrier_any_group.hpp>
+#include <disruptorplus/ring_buffer.hpp>
+#include <disruptorplus/tsc_clock.hpp>
+
+#include "stats.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace disruptorplus;
+
+namespace
+{
+    struct event
+    {
+        int64_t m_publishedNS;
+        uint64_t m_value;
+    };
+
+    // Deterministic xorshift64* generator.
+    class random
+    {
+    public:
+
+        explicit random(uint64_t seed)
+        : m_state(seed != 0 ? seed : 0x9E3779B97F4A7C15ull)
+        {}
+
+        uint64_t next()
+        {
+            m_state ^= m_state >> 12;
+            m_state ^= m_state << 25;
+            m_state ^= m_state >> 27;
+            return m_state * 0x2545F4914F6CDD1Dull;
+        }
+
+    private:
+
+        uint64_t m_state;
+
+    };
+
+    int64_t NowNS()
+    {
+        return tsc_clock::now().time_since_epoch().count();
+    }
+
+    void SpinFor(int64_t ns)
+    {
+        const int64_t until = NowNS() + ns;
+        while (NowNS() < until)
+        {
+        }
+    }
+
+    void PrintHeader()
+    {
+        std::cout << "Downstream" << ", "
+                  << "Replicas" << ", "
+                  << "Events/Sec" << ", "
+                  << "LatencyP50NS" << ", "
+                  << "LatencyP99NS" << ", "
+                  << "LatencyP99.9NS" << ", "
+                  << "LatencyMaxNS" << std::endl;
+    }
+
+    // producer -> replicas (identical, each stalling at random) -> downstream
+    //
+    // Downstream waits either for all replicas (sequence_barrier_group) or
+    // for the first of them (sequence_barrier_any_group). The producer
+    // gates on every replica and on downstream in both cases.
+    void Run(
+        bool any,
+        size_t replicaCount,
+        size_t bufferSize,
+        uint64_t eventCount,
+        uint64_t stallEvery,
+        int64_t stallNS)
+    {
+        spin_wait_strategy waitStrategy;
+        single_threaded_claim_strategy<spin_wait_strategy> claimStrategy(bufferSize, waitStrategy);
+        std::vector<std::unique_ptr<sequence_barrier<spin_wait_strategy>>> replicated;
+        sequence_barrier_group<spin_wait_strategy> allReplicas(waitStrategy);
+        sequence_barrier_any_group<spin_wait_strategy> anyReplica(waitStrategy);
+        for (size_t i = 0; i < replicaCount; ++i)
+        {
+            replicated.emplace_back(new sequence_barrier<spin_wait_strategy>(waitStrategy));
+            claimStrategy.add_claim_barrier(*replicated.back());
+            allReplicas.add(*replicated.back());
+            anyReplica.add(*replicated.back());
+        }
+        sequence_barrier<spin_wait_strategy> consumed(waitStrategy);
+        claimStrategy.add_claim_barrier(consumed);
+        ring_buffer<event> buffer(bufferSize);
+
+        const sequence_t last = static_cast<sequence_t>(eventCount - 1);
+        std::vector<uint64_t> replicaSums(replicaCount, 0);
+
+        std::vector<std::thread> replicas;
+        for (size_t r = 0; r < replicaCount; ++r)
+        {
+            replicas.emplace_back([&, r]()
+            {
+                random rng(r + 1);
+                uint64_t sum = 0;
+                sequence_t nextToRead = 0;
+                while (difference(nextToRead, last) <= 0)
+                {
+                    const sequence_t available = claimStrategy.wait_until_published(nextToRead);
+                    do
+                    {
+                        // Each replica occasionally stalls, eg. on a page
+                        // fault or a preemption, independently of the other.
+                        if (rng.next() % stallEvery == 0)
+                        {
+                            SpinFor(stallNS);
+                        }
+                        sum += buffer[nextToRead].m_value;
+
+                        // Publish each item as it completes so the other
+                        // replica can overtake during a stall.
+                        replicated[r]->publish(nextToRead);
+                    } while (nextToRead++ != available);
+                }
+                replicaSums[r] = sum;
+            });
+        }
+
+        benchmark::histogram latency;
+        uint64_t downstreamSum = 0;
+        std::thread downstream([&]()
+        {
+            sequence_t nextToRead = 0;
+            while (difference(nextToRead, last) <= 0)
+            {
+                const sequence_t available = any
+                    ? anyReplica.wait_until_published(nextToRead)
+                    : allReplicas.wait_until_published(nextToRead);
+                const int64_t now = NowNS();
+                do
+                {
+                    const event& e = buffer[nextToRead];
+                    latency.record(now - e.m_publishedNS);
+                    downstreamSum += e.m_value;
+                } while (nextToRead++ != available);
+                consumed.publish(available);
+            }
+        });
+
+        // Publish at a steady rate so that latency is measured against an
+        // otherwise idle pipeline rather than a backlog.
+        const int64_t intervalNS = 1000;
+        const auto start = tsc_clock::now();
+        int64_t nextPublishNS = NowNS();
+        for (uint64_t i = 0; i < eventCount; ++i)
+        {
+            while (NowNS() < nextPublishNS)
+            {
+            }
+            nextPublishNS += intervalNS;
+
+            const sequence_t seq = claimStrategy.claim_one();
+            buffer[seq].m_value = i;
+            buffer[seq].m_publishedNS = NowNS();
+            claimStrategy.publish(seq);
+        }
+
+        for (auto& replica : replicas)
+        {
+            replica.join();
+        }
+        downstream.join();
+        const auto elapsed = tsc_clock::now_ordered() - start;
+        const double elapsedNS = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+
+        const uint64_t expected = eventCount * (eventCount - 1) / 2;
+        bool ok = downstreamSum == expected && latency.count() == eventCount;
+        for (uint64_t sum : replicaSums)
+        {
+            ok = ok && sum == expected;
+        }
+        if (!ok)
+        {
+            throw std::domain_error("Unexpected test result.");
+        }
+
+        std::cout << (any ? "any" : "all") << ", "
+                  << replicaCount << ", "
+                  << static_cast<uint64_t>(eventCount * 1e9 / elapsedNS) << ", "
+                  << latency.percentile(50) << ", "
+                  << latency.percentile(99) << ", "
+                  << latency.percentile(99.9) << ", "
+                  << latency.max() << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    // Calibrate the clock so that timestamps read the TSC rather than
+    // steady_clock.
+    disruptorplus::tsc_clock::calibrate();
+
+    const uint64_t eventCount = argc > 1 ? std::max(1, std::atoi(argv[1])) : 2 * 1000 * 1000;
+    const size_t bufferSize = 64 * 1024;
+    const uint64_t stallEvery = 1000;
+    const int64_t stallNS = 20 * 1000;
+
+    std::cout << "Hot-Standby Benchmark" << std::endl
+              << "Usage: standby [event-count]" << std::endl
+              << "Event count: " << eventCount << std::endl
+              << "Buffer size: " << bufferSize << std::endl
+              << "Replica stalls: " << stallNS << "ns every " << stallEvery << " events on average" << std::endl;
+
+    try
+    {
+        PrintHeader();
+
+        for (size_t replicaCount : { 2, 3 })
+        {
+            Run(false, replicaCount, bufferSize, eventCount, stallEvery, stallNS);
+            Run(true, replicaCount, bufferSize, eventCount, stallEvery, stallNS);
+        }
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
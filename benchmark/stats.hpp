@@ -0,0 +1,230 @@
+#ifndef DISRUPTORPLUS_BENCHMARK_STATS_HPP_INCLUDED
+#define DISRUPTORPLUS_BENCHMARK_STATS_HPP_INCLUDED
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#ifdef _MSC_VER
+# include <intrin.h>
+#endif
+
+/// \file
+/// \brief
+/// Helpers shared by the benchmark programs for summarising repeated
+/// measurements.
+
+namespace benchmark
+{
+    /// \brief
+    /// Summary statistics of a set of samples.
+    struct summary
+    {
+        size_t count;
+        double min;
+        double max;
+        double mean;
+        double median;
+
+        /// Sample standard deviation.
+        double stddev;
+
+        /// Median absolute deviation from the median.
+        double mad;
+
+        /// Half-width of the 95% confidence interval of the mean.
+        double ci95;
+    };
+
+    /// \brief
+    /// Return the value at the \p p'th percentile of \p sorted.
+    ///
+    /// \param sorted
+    /// Samples sorted in ascending order. Must not be empty.
+    ///
+    /// \param p
+    /// The percentile to look up in the range [0, 100].
+    template<typename T>
+    T percentile(const std::vector<T>& sorted, double p)
+    {
+        assert(!sorted.empty());
+        const double rank = (p / 100.0) * static_cast<double>(sorted.size() - 1);
+        const size_t index = static_cast<size_t>(rank + 0.5);
+        return sorted[std::min(index, sorted.size() - 1)];
+    }
+
+    /// \brief
+    /// Calculate summary statistics for a set of samples.
+    ///
+    /// \param samples
+    /// The samples to summarise. Must not be empty.
+    inline summary summarise(std::vector<double> samples)
+    {
+        assert(!samples.empty());
+        std::sort(samples.begin(), samples.end());
+
+        summary s;
+        s.count = samples.size();
+        s.min = samples.front();
+        s.max = samples.back();
+
+        const size_t mid = samples.size() / 2;
+        s.median = (samples.size() % 2 == 1)
+            ? samples[mid]
+            : (samples[mid - 1] + samples[mid]) / 2;
+
+        double total = 0;
+        for (double x : samples)
+        {
+            total += x;
+        }
+        s.mean = total / static_cast<double>(s.count);
+
+        double sumSquares = 0;
+        std::vector<double> deviations;
+        deviations.reserve(samples.size());
+        for (double x : samples)
+        {
+            sumSquares += (x - s.mean) * (x - s.mean);
+            deviations.push_back(std::fabs(x - s.median));
+        }
+        s.stddev = s.count > 1 ? std::sqrt(sumSquares / static_cast<double>(s.count - 1)) : 0.0;
+        s.ci95 = 1.96 * s.stddev / std::sqrt(static_cast<double>(s.count));
+
+        std::sort(deviations.begin(), deviations.end());
+        s.mad = (deviations.size() % 2 == 1)
+            ? deviations[mid]
+            : (deviations[mid - 1] + deviations[mid]) / 2;
+
+        return s;
+    }
+
+    /// \brief
+    /// A histogram of non-negative integer values (eg. latencies in
+    /// nanoseconds) with logarithmically sized buckets.
+    ///
+    /// Each power-of-two range is split into 32 linear sub-buckets so
+    /// recorded values are accurate to within about 3%. Recording a value
+    /// is cheap and allocation-free so it can be done inside measured loops.
+    class histogram
+    {
+    public:
+
+        histogram()
+        : m_counts(bucketCount, 0)
+        , m_count(0)
+        , m_total(0)
+        , m_min(UINT64_MAX)
+        , m_max(0)
+        {}
+
+        /// \brief
+        /// Record a single value. Negative values are recorded as zero.
+        void record(int64_t value)
+        {
+            const uint64_t v = value < 0 ? 0 : static_cast<uint64_t>(value);
+            ++m_counts[bucket_index(v)];
+            ++m_count;
+            m_total += v;
+            m_min = std::min(m_min, v);
+            m_max = std::max(m_max, v);
+        }
+
+        /// \brief
+        /// Add all values recorded in another histogram to this one.
+        void merge(const histogram& other)
+        {
+            for (size_t i = 0; i < bucketCount; ++i)
+            {
+                m_counts[i] += other.m_counts[i];
+            }
+            m_count += other.m_count;
+            m_total += other.m_total;
+            m_min = std::min(m_min, other.m_min);
+            m_max = std::max(m_max, other.m_max);
+        }
+
+        uint64_t count() const { return m_count; }
+        uint64_t min() const { return m_count > 0 ? m_min : 0; }
+        uint64_t max() const { return m_max; }
+
+        double mean() const
+        {
+            return m_count > 0 ? static_cast<double>(m_total) / static_cast<double>(m_count) : 0.0;
+        }
+
+        /// \brief
+        /// Return an approximation of the value at the \p p'th percentile.
+        ///
+        /// \param p
+        /// The percentile to look up in the range [0, 100].
+        uint64_t percentile(double p) const
+        {
+            if (m_count == 0)
+            {
+                return 0;
+            }
+            const uint64_t rank = static_cast<uint64_t>((p / 100.0) * static_cast<double>(m_count - 1)) + 1;
+            uint64_t seen = 0;
+            for (size_t i = 0; i < bucketCount; ++i)
+            {
+                seen += m_counts[i];
+                if (seen >= rank)
+                {
+                    return std::min(std::max(bucket_value(i), m_min), m_max);
+                }
+            }
+            return m_max;
+        }
+
+    private:
+
+        static const unsigned subBucketBits = 5;
+        static const size_t subBucketCount = size_t(1) << subBucketBits;
+        static const size_t bucketCount = 64 * subBucketCount;
+
+        static unsigned most_significant_bit(uint64_t v)
+        {
+#ifdef _MSC_VER
+            unsigned long index;
+            _BitScanReverse64(&index, v);
+            return static_cast<unsigned>(index);
+#else
+            return 63 - static_cast<unsigned>(__builtin_clzll(v));
+#endif
+        }
+
+        static size_t bucket_index(uint64_t v)
+        {
+            if (v < subBucketCount)
+            {
+                return static_cast<size_t>(v);
+            }
+            const unsigned shift = most_significant_bit(v) - subBucketBits;
+            return (shift + 1) * subBucketCount + static_cast<size_t>((v >> shift) & (subBucketCount - 1));
+        }
+
+        static uint64_t bucket_value(size_t index)
+        {
+            if (index < subBucketCount)
+            {
+                return index;
+            }
+            const size_t shift = index / subBucketCount - 1;
+            const uint64_t mantissa = subBucketCount + index % subBucketCount;
+            return mantissa << shift;
+        }
+
+        std::vector<uint64_t> m_counts;
+        uint64_t m_count;
+        uint64_t m_total;
+        uint64_t m_min;
+        uint64_t m_max;
+
+    };
+}
+
+#endif
@@ -0,0 +1,359 @@
+#include <disruptorplus/multi_threaded_claim_strategy.hpp>
+#include <disruptorplus/blocking_wait_strategy.hpp>
+#include <disruptorplus/spin_wait_strategy.hpp>
+#include <disruptorplus/ring_buffer.hpp>
+#include <disruptorplus/tsc_clock.hpp>
+
+#include "stats.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace disruptorplus;
+
+namespace
+{
+    struct event
+    {
+        // The sequence number of the slot, to detect reads of stale slots.
+        sequence_t m_sequence;
+
+        // Index of the producer that wrote the event.
+        uint32_t m_producer;
+
+        // Number of events the producer had published before this one.
+        uint64_t m_counter;
+    };
+
+    // Written by the main thread once all producers have stopped to tell
+    // the consumer there are no more events.
+    const uint32_t endOfStream = static_cast<uint32_t>(-1);
+
+    enum schedule
+    {
+        // Every producer claims one slot at a time.
+        uniform,
+
+        // Each claim randomly uses claim_one(), claim(n) or try_claim(n).
+        mixed,
+
+        // Producers publish random bursts of claims separated by pauses.
+        bursty,
+
+        // Mixed traffic, but one in sixteen producers occasionally holds
+        // its claimed slots for a long time before publishing, stalling
+        // the consumer and so eventually every other producer.
+        holders
+    };
+
+    const char* ScheduleName(schedule s)
+    {
+        switch (s)
+        {
+        case mixed: return "mixed";
+        case bursty: return "bursty";
+        case holders: return "holders";
+        default: return "uniform";
+        }
+    }
+
+    // Deterministic xorshift64* generator.
+    class random
+    {
+    public:
+
+        explicit random(uint64_t seed)
+        : m_state(seed != 0 ? seed : 0x9E3779B97F4A7C15ull)
+        {}
+
+        uint64_t next()
+        {
+            m_state ^= m_state >> 12;
+            m_state ^= m_state << 25;
+            m_state ^= m_state >> 27;
+            return m_state * 0x2545F4914F6CDD1Dull;
+        }
+
+        uint32_t next(uint32_t bound)
+        {
+            return static_cast<uint32_t>((next() >> 32) % bound);
+        }
+
+    private:
+
+        uint64_t m_state;
+
+    };
+
+    void PrintHeader()
+    {
+        std::cout << "WaitStrategy" << ", "
+                  << "Schedule" << ", "
+                  << "Producers" << ", "
+                  << "Events/Sec" << ", "
+                  << "JainFairness" << ", "
+                  << "MinShare%" << ", "
+                  << "MaxShare%" << ", "
+                  << "ClaimP99NS" << ", "
+                  << "ClaimP99.99NS" << ", "
+                  << "ClaimMaxNS" << std::endl;
+    }
+
+    template<typename WaitStrategy>
+    void RunStress(
+        const char* name,
+        schedule sched,
+        int producerCount,
+        std::chrono::milliseconds duration,
+        uint64_t seed)
+    {
+        const size_t bufferSize = 4 * 1024;
+        const size_t maxBatch = 16;
+
+        WaitStrategy waitStrategy;
+        multi_threaded_claim_strategy<WaitStrategy> claimStrategy(bufferSize, waitStrategy);
+        sequence_barrier<WaitStrategy> consumed(waitStrategy);
+        claimStrategy.add_claim_barrier(consumed);
+        ring_buffer<event> buffer(bufferSize);
+
+        std::atomic<bool> stop(false);
+        std::vector<uint64_t> producedCounts(producerCount, 0);
+        std::vector<benchmark::histogram> claimLatency(producerCount);
+
+        // The consumer verifies that every slot is read exactly once, in
+        // sequence order, and that each producer's events arrive in the
+        // order it published them with none missing.
+        std::vector<uint64_t> consumedCounts(producerCount, 0);
+        std::string consumerError;
+        std::thread consumer([&]()
+        {
+            sequence_t nextToRead = 0;
+            sequence_t lastKnownPublished = static_cast<sequence_t>(-1);
+            bool done = false;
+            while (!done)
+            {
+                const sequence_t available = claimStrategy.wait_until_published(nextToRead, lastKnownPublished);
+                do
+                {
+                    const event& e = buffer[nextToRead];
+                    if (e.m_sequence == nextToRead && e.m_producer == endOfStream)
+                    {
+                        done = true;
+                    }
+                    else if (!consumerError.empty())
+                    {
+                        // Keep draining after a failure so producers do not block.
+                    }
+                    else if (e.m_sequence != nextToRead)
+                    {
+                        std::ostringstream message;
+                        message << "slot for sequence " << nextToRead << " holds sequence " << e.m_sequence;
+                        consumerError = message.str();
+                    }
+                    else if (e.m_producer >= static_cast<uint32_t>(producerCount) ||
+                             e.m_counter != consumedCounts[e.m_producer])
+                    {
+                        std::ostringstream message;
+                        message << "sequence " << nextToRead << " out of order for producer " << e.m_producer;
+                        consumerError = message.str();
+                    }
+                    else
+                    {
+                        ++consumedCounts[e.m_producer];
+                    }
+                } while (nextToRead++ != available);
+                lastKnownPublished = available;
+                consumed.publish(available);
+            }
+        });
+
+        std::vector<std::thread> producers;
+        producers.reserve(producerCount);
+        for (int producer = 0; producer < producerCount; ++producer)
+        {
+            producers.emplace_back([&, producer]()
+            {
+                random rng(seed * 0x100000001B3ull + producer);
+                const bool isHolder = sched == holders && producer % 16 == 0;
+                uint64_t counter = 0;
+                benchmark::histogram& latency = claimLatency[producer];
+
+                while (!stop.load(std::memory_order_relaxed))
+                {
+                    int burst = 1;
+                    if (sched == bursty)
+                    {
+                        burst = 1 + static_cast<int>(rng.next(64));
+                    }
+
+                    for (int b = 0; b < burst; ++b)
+                    {
+                        sequence_range range;
+                        const uint32_t kind = sched == uniform ? 0 : rng.next(3);
+                        const size_t count = 1 + rng.next(maxBatch);
+
+                        const auto claimStart = tsc_clock::now();
+                        if (kind == 0)
+                        {
+                            range = sequence_range(claimStrategy.claim_one(), 1);
+                        }
+                        else if (kind == 1)
+                        {
+                            range = claimStrategy.claim(count);
+                        }
+                        else
+                        {
+                            while (!claimStrategy.try_claim(count, range))
+                            {
+                                std::this_thread::yield();
+                            }
+                        }
+                        latency.record(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            tsc_clock::now() - claimStart).count());
+
+                        for (size_t i = 0; i < range.size(); ++i)
+                        {
+                            event& e = buffer[range[i]];
+                            e.m_sequence = range[i];
+                            e.m_producer = static_cast<uint32_t>(producer);
+                            e.m_counter = counter++;
+                        }
+
+                        if (isHolder && rng.next(64) == 0)
+                        {
+                            std::this_thread::sleep_for(std::chrono::microseconds(100 + rng.next(400)));
+                        }
+
+                        claimStrategy.publish(range);
+                    }
+
+                    if (sched == bursty)
+                    {
+                        if (rng.next(4) == 0)
+                        {
+                            std::this_thread::sleep_for(std::chrono::microseconds(rng.next(200)));
+                        }
+                        else
+                        {
+                            std::this_thread::yield();
+                        }
+                    }
+                }
+
+                producedCounts[producer] = counter;
+            });
+        }
+
+        const auto start = tsc_clock::now();
+        std::this_thread::sleep_for(duration);
+        stop.store(true, std::memory_order_relaxed);
+        for (auto& producer : producers)
+        {
+            producer.join();
+        }
+        const auto elapsed = tsc_clock::now_ordered() - start;
+
+        {
+            const sequence_t seq = claimStrategy.claim_one();
+            event& e = buffer[seq];
+            e.m_sequence = seq;
+            e.m_producer = endOfStream;
+            e.m_counter = 0;
+            claimStrategy.publish(seq);
+        }
+        consumer.join();
+
+        if (!consumerError.empty())
+        {
+            throw std::domain_error(consumerError);
+        }
+        if (consumedCounts != producedCounts)
+        {
+            throw std::domain_error("Unexpected test result.");
+        }
+
+        uint64_t total = 0;
+        double sumOfSquares = 0;
+        uint64_t minCount = producedCounts[0];
+        uint64_t maxCount = producedCounts[0];
+        benchmark::histogram allClaimLatency;
+        for (int producer = 0; producer < producerCount; ++producer)
+        {
+            const uint64_t count = producedCounts[producer];
+            total += count;
+            sumOfSquares += static_cast<double>(count) * count;
+            minCount = std::min(minCount, count);
+            maxCount = std::max(maxCount, count);
+            allClaimLatency.merge(claimLatency[producer]);
+        }
+
+        // Jain's index is 1 when every producer got the same share and
+        // 1/n when a single producer got everything.
+        const double jain = sumOfSquares > 0
+            ? static_cast<double>(total) * total / (producerCount * sumOfSquares)
+            : 1.0;
+        const double fairShare = static_cast<double>(total) / producerCount;
+        const double elapsedNS = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+
+        std::cout << std::fixed << std::setprecision(3)
+                  << name << ", "
+                  << ScheduleName(sched) << ", "
+                  << producerCount << ", "
+                  << static_cast<uint64_t>(total * 1e9 / elapsedNS) << ", "
+                  << jain << ", "
+                  << std::setprecision(1)
+                  << (fairShare > 0 ? 100.0 * minCount / fairShare : 0.0) << ", "
+                  << (fairShare > 0 ? 100.0 * maxCount / fairShare : 0.0) << ", "
+                  << allClaimLatency.percentile(99) << ", "
+                  << allClaimLatency.percentile(99.99) << ", "
+                  << allClaimLatency.max() << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    // Calibrate the clock so that timestamps read the TSC rather than
+    // steady_clock.
+    disruptorplus::tsc_clock::calibrate();
+
+    const std::chrono::milliseconds duration(argc > 1 ? std::max(1, std::atoi(argv[1])) : 200);
+    const uint64_t seed = argc > 2 ? std::strtoull(argv[2], nullptr, 0) : 1;
+    const int maxProducers = argc > 3 ? std::max(1, std::atoi(argv[3])) : 128;
+
+    std::cout << "Multi-Producer Stress and Scaling Benchmark" << std::endl
+              << "Usage: stress [duration-ms [seed [max-producers]]]" << std::endl
+              << "Duration per run: " << duration.count() << "ms" << std::endl
+              << "Seed: " << seed << std::endl;
+
+    try
+    {
+        PrintHeader();
+
+        const schedule schedules[] = { uniform, mixed, bursty, holders };
+        for (schedule sched : schedules)
+        {
+            for (int producerCount = 1; producerCount <= maxProducers; producerCount *= 2)
+            {
+                RunStress<spin_wait_strategy>("spin_wait_strategy", sched, producerCount, duration, seed);
+                RunStress<blocking_wait_strategy>("blocking_wait_strategy", sched, producerCount, duration, seed);
+            }
+        }
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
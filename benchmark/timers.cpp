@@ -0,0 +1,375 @@
+#include <disruptorplus/multi_threaded_claim_strategy.hpp>
+#include <disruptorplus/single_threaded_claim_strategy.hpp>
+#include <disruptorplus/spin_wait_strategy.hpp>
+#include <disruptorplus/ring_buffer.hpp>
+#include <disruptorplus/timer_wheel.hpp>
+#include <disruptorplus/tsc_clock.hpp>
+
+#include "stats.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <queue>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace disruptorplus;
+
+namespace
+{
+    typedef multi_threaded_claim_strategy<spin_wait_strategy> input_claim_strategy;
+    typedef single_threaded_claim_strategy<spin_wait_strategy> output_claim_strategy;
+    typedef timer_wheel<uint64_t, spin_wait_strategy, input_claim_strategy, output_claim_strategy> wheel_type;
+
+    // One tick of the timers is a microsecond.
+    const int64_t TickNS = 1000;
+
+    int64_t NowNS()
+    {
+        return tsc_clock::now().time_since_epoch().count();
+    }
+
+    uint64_t NowTicks()
+    {
+        return static_cast<uint64_t>(NowNS() / TickNS);
+    }
+
+    // Deterministic xorshift64* generator.
+    class random
+    {
+    public:
+
+        explicit random(uint64_t seed)
+        : m_state(seed != 0 ? seed : 0x9E3779B97F4A7C15ull)
+        {}
+
+        uint64_t next()
+        {
+            m_state ^= m_state >> 12;
+            m_state ^= m_state << 25;
+            m_state ^= m_state >> 27;
+            return m_state * 0x2545F4914F6CDD1Dull;
+        }
+
+    private:
+
+        uint64_t m_state;
+
+    };
+
+    void PrintHeader()
+    {
+        std::cout << "Service" << ", "
+                  << "Producers" << ", "
+                  << "Schedules/Sec" << ", "
+                  << "ScheduleP50NS" << ", "
+                  << "ScheduleP99NS" << ", "
+                  << "Expired" << ", "
+                  << "Cancelled" << ", "
+                  << "LatenessP50NS" << ", "
+                  << "LatenessP99NS" << ", "
+                  << "LatenessMaxNS" << std::endl;
+    }
+
+    struct result
+    {
+        double m_elapsedNS;
+        uint64_t m_expired;
+        uint64_t m_cancelled;
+        benchmark::histogram m_schedule;
+        benchmark::histogram m_lateness;
+    };
+
+    // Each producer schedules timers with random delays and cancels every
+    // other one straight away, as a heartbeat that keeps being reset would.
+    // Only every sampleEvery'th schedule call is timed.
+    template<typename Schedule, typename Cancel>
+    void Produce(
+        size_t producer,
+        uint64_t timerCount,
+        uint64_t maxDelayTicks,
+        benchmark::histogram& scheduleCost,
+        Schedule schedule,
+        Cancel cancel)
+    {
+        const uint64_t sampleEvery = 16;
+        random rng(producer + 1);
+        for (uint64_t i = 0; i < timerCount; ++i)
+        {
+            const uint64_t deadline = NowTicks() + 1 + rng.next() % maxDelayTicks;
+            const int64_t start = NowNS();
+            const auto handle = schedule(deadline);
+            if (i % sampleEvery == 0)
+            {
+                scheduleCost.record(NowNS() - start);
+            }
+            if (i % 2 == 1)
+            {
+                cancel(handle);
+            }
+        }
+    }
+
+    // producers -> input ring -> timer wheel -> output ring -> consumer
+    void RunWheel(size_t producerCount, uint64_t timerCount, uint64_t maxDelayTicks, result& r)
+    {
+        const size_t bufferSize = 64 * 1024;
+        const size_t quota = 64 * 1024;
+
+        spin_wait_strategy waitStrategy;
+        input_claim_strategy inputClaim(bufferSize, waitStrategy);
+        output_claim_strategy outputClaim(bufferSize, waitStrategy);
+        ring_buffer<wheel_type::request_type> input(bufferSize);
+        ring_buffer<wheel_type::expiry_type> output(bufferSize);
+        sequence_barrier<spin_wait_strategy> consumed(waitStrategy);
+        outputClaim.add_claim_barrier(consumed);
+
+        wheel_type wheel(waitStrategy, inputClaim, input, outputClaim, output, producerCount * quota, NowTicks());
+        inputClaim.add_claim_barrier(wheel.consumed());
+        std::vector<wheel_type::client*> clients;
+        for (size_t p = 0; p < producerCount; ++p)
+        {
+            clients.push_back(&wheel.add_client(quota));
+        }
+
+        const uint64_t total = producerCount * timerCount;
+        std::atomic<bool> wheelDone(false);
+        std::atomic<uint64_t> expiredTotal(0);
+
+        std::thread consumer([&]()
+        {
+            sequence_t nextToRead = 0;
+            for (;;)
+            {
+                const sequence_t available = outputClaim.last_published();
+                if (difference(available, nextToRead) < 0)
+                {
+                    if (wheelDone.load() && nextToRead == expiredTotal.load())
+                    {
+                        break;
+                    }
+                    std::this_thread::yield();
+                    continue;
+                }
+                const int64_t now = NowNS();
+                do
+                {
+                    const wheel_type::expiry_type& e = output[nextToRead];
+                    r.m_lateness.record(now - static_cast<int64_t>(e.m_deadline) * TickNS);
+                } while (nextToRead++ != available);
+                consumed.publish(available);
+            }
+        });
+
+        std::thread timerThread([&]()
+        {
+            while (wheel.expired() + wheel.cancelled() < total)
+            {
+                if (wheel.poll(NowTicks()) == 0)
+                {
+                    std::this_thread::yield();
+                }
+            }
+            expiredTotal = wheel.expired();
+            wheelDone = true;
+        });
+
+        const auto start = tsc_clock::now();
+        std::vector<benchmark::histogram> scheduleCosts(producerCount);
+        std::vector<std::thread> producers;
+        for (size_t p = 0; p < producerCount; ++p)
+        {
+            producers.emplace_back([&, p]()
+            {
+                wheel_type::client& c = *clients[p];
+                Produce(p, timerCount, maxDelayTicks, scheduleCosts[p],
+                    [&](uint64_t deadline) { return c.schedule(deadline, deadline); },
+                    [&](timer_handle handle) { c.cancel(handle); });
+            });
+        }
+        for (auto& producer : producers)
+        {
+            producer.join();
+        }
+        const auto elapsed = tsc_clock::now_ordered() - start;
+        timerThread.join();
+        consumer.join();
+
+        r.m_elapsedNS = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        r.m_expired = wheel.expired();
+        r.m_cancelled = wheel.cancelled();
+        for (auto& h : scheduleCosts)
+        {
+            r.m_schedule.merge(h);
+        }
+    }
+
+    // producers -> mutex-protected heap <- timer thread
+    void RunHeap(size_t producerCount, uint64_t timerCount, uint64_t maxDelayTicks, result& r)
+    {
+        struct entry
+        {
+            uint64_t m_deadline;
+            uint64_t m_id;
+            bool operator>(const entry& other) const { return m_deadline > other.m_deadline; }
+        };
+
+        enum : uint8_t { pending, cancelled, expired };
+
+        const uint64_t total = producerCount * timerCount;
+        std::mutex mutex;
+        std::priority_queue<entry, std::vector<entry>, std::greater<entry>> heap;
+        std::vector<uint8_t> state(total, pending);
+        uint64_t expiredCount = 0;
+        uint64_t cancelledCount = 0;
+
+        std::thread timerThread([&]()
+        {
+            bool done = false;
+            while (!done)
+            {
+                const uint64_t now = NowTicks();
+                std::vector<uint64_t> fired;
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    while (!heap.empty() && heap.top().m_deadline <= now)
+                    {
+                        const entry e = heap.top();
+                        heap.pop();
+                        if (state[e.m_id] == pending)
+                        {
+                            state[e.m_id] = expired;
+                            fired.push_back(e.m_deadline);
+                        }
+                    }
+                    expiredCount += fired.size();
+                    done = expiredCount + cancelledCount == total;
+                }
+                const int64_t nowNS = NowNS();
+                for (uint64_t deadline : fired)
+                {
+                    r.m_lateness.record(nowNS - static_cast<int64_t>(deadline) * TickNS);
+                }
+                if (fired.empty() && !done)
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+        const auto start = tsc_clock::now();
+        std::vector<benchmark::histogram> scheduleCosts(producerCount);
+        std::vector<std::thread> producers;
+        for (size_t p = 0; p < producerCount; ++p)
+        {
+            producers.emplace_back([&, p]()
+            {
+                uint64_t nextId = p * timerCount;
+                Produce(p, timerCount, maxDelayTicks, scheduleCosts[p],
+                    [&](uint64_t deadline)
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        const entry e = { deadline, nextId++ };
+                        heap.push(e);
+                        return e.m_id;
+                    },
+                    [&](uint64_t id)
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        if (state[id] == pending)
+                        {
+                            state[id] = cancelled;
+                            ++cancelledCount;
+                        }
+                    });
+            });
+        }
+        for (auto& producer : producers)
+        {
+            producer.join();
+        }
+        const auto elapsed = tsc_clock::now_ordered() - start;
+        timerThread.join();
+
+        r.m_elapsedNS = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        r.m_expired = expiredCount;
+        r.m_cancelled = cancelledCount;
+        for (auto& h : scheduleCosts)
+        {
+            r.m_schedule.merge(h);
+        }
+    }
+
+    void Run(bool wheel, size_t producerCount, uint64_t timerCount, uint64_t maxDelayTicks)
+    {
+        result r;
+        if (wheel)
+        {
+            RunWheel(producerCount, timerCount, maxDelayTicks, r);
+        }
+        else
+        {
+            RunHeap(producerCount, timerCount, maxDelayTicks, r);
+        }
+
+        if (r.m_expired + r.m_cancelled != producerCount * timerCount ||
+            r.m_lateness.count() != r.m_expired)
+        {
+            throw std::domain_error("Unexpected test result.");
+        }
+
+        std::cout << (wheel ? "wheel" : "heap") << ", "
+                  << producerCount << ", "
+                  << static_cast<uint64_t>(producerCount * timerCount * 1e9 / r.m_elapsedNS) << ", "
+                  << r.m_schedule.percentile(50) << ", "
+                  << r.m_schedule.percentile(99) << ", "
+                  << r.m_expired << ", "
+                  << r.m_cancelled << ", "
+                  << r.m_lateness.percentile(50) << ", "
+                  << r.m_lateness.percentile(99) << ", "
+                  << r.m_lateness.max() << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    // Calibrate the clock so that timestamps read the TSC rather than
+    // steady_clock.
+    disruptorplus::tsc_clock::calibrate();
+
+    const uint64_t timerCount = argc > 1 ? std::max(1, std::atoi(argv[1])) : 1000 * 1000;
+    const uint64_t maxDelayTicks = 10 * 1000;
+
+    std::cout << "Timer Wheel Benchmark" << std::endl
+              << "Usage: timers [timers-per-producer]" << std::endl
+              << "Timers per producer: " << timerCount << std::endl
+              << "Tick: " << TickNS << "ns" << std::endl
+              << "Maximum delay: " << maxDelayTicks << " ticks" << std::endl;
+
+    try
+    {
+        PrintHeader();
+
+        for (size_t producerCount : { 1, 2, 4 })
+        {
+            Run(false, producerCount, timerCount, maxDelayTicks);
+            Run(true, producerCount, timerCount, maxDelayTicks);
+        }
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
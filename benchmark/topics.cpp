@@ -0,0 +1,215 @@
+#include <disruptorplus/single_threaded_claim_strategy.hpp>
+#include <disruptorplus/spin_wait_strategy.hpp>
+#include <disruptorplus/ring_buffer.hpp>
+#include <disruptorplus/topic_masks.hpp>
+#include <disruptorplus/tsc_clock.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace disruptorplus;
+
+namespace
+{
+    const unsigned TopicCount = 20;
+
+    struct event
+    {
+        uint32_t m_topic;
+        uint32_t m_padding;
+        uint64_t m_value;
+        uint64_t m_body[6];
+    };
+
+    enum class filter
+    {
+        // Consumers read the topic from every item.
+        payload,
+
+        // Consumers scan the topic masks and read only matching items.
+        masks
+    };
+
+    // The topic of the i'th event, spread so that consecutive events
+    // usually differ.
+    unsigned TopicOf(uint64_t i)
+    {
+        return static_cast<unsigned>((i * 7) % TopicCount);
+    }
+
+    void PrintHeader()
+    {
+        std::cout << "Filter" << ", "
+                  << "Consumers" << ", "
+                  << "Events/Sec" << ", "
+                  << "Matched/Consumer" << std::endl;
+    }
+
+    // producer -> N consumers, each interested in 2 of the topics
+    void Run(filter f, size_t consumerCount, size_t bufferSize, uint64_t eventCount)
+    {
+        spin_wait_strategy waitStrategy;
+        single_threaded_claim_strategy<spin_wait_strategy> claimStrategy(bufferSize, waitStrategy);
+        std::vector<std::unique_ptr<sequence_barrier<spin_wait_strategy>>> consumed;
+        for (size_t i = 0; i < consumerCount; ++i)
+        {
+            consumed.emplace_back(new sequence_barrier<spin_wait_strategy>(waitStrategy));
+            claimStrategy.add_claim_barrier(*consumed.back());
+        }
+        ring_buffer<event> buffer(bufferSize);
+        topic_masks masks(bufferSize);
+
+        const sequence_t last = static_cast<sequence_t>(eventCount - 1);
+        std::atomic<bool> ok(true);
+        std::vector<uint64_t> matched(consumerCount, 0);
+
+        std::vector<std::thread> consumers;
+        for (size_t c = 0; c < consumerCount; ++c)
+        {
+            consumers.emplace_back([&, c]()
+            {
+                const unsigned topicA = static_cast<unsigned>((2 * c) % TopicCount);
+                const unsigned topicB = static_cast<unsigned>((2 * c + 1) % TopicCount);
+                const topic_mask interest = topic_bit(topicA) | topic_bit(topicB);
+
+                uint64_t count = 0;
+                uint64_t sum = 0;
+                uint64_t expected = 0;
+                sequence_t nextToRead = 0;
+                while (difference(nextToRead, last) <= 0)
+                {
+                    const sequence_t available = claimStrategy.wait_until_published(nextToRead);
+                    if (f == filter::payload)
+                    {
+                        do
+                        {
+                            const event& e = buffer[nextToRead];
+                            if (e.m_topic == topicA || e.m_topic == topicB)
+                            {
+                                sum += e.m_value;
+                                expected += static_cast<uint64_t>(nextToRead);
+                                ++count;
+                            }
+                        } while (nextToRead++ != available);
+                    }
+                    else
+                    {
+                        count += masks.for_each_matching(nextToRead, available, interest,
+                            [&](sequence_t seq)
+                            {
+                                sum += buffer[seq].m_value;
+                                expected += static_cast<uint64_t>(seq);
+                            });
+                        nextToRead = available + 1;
+                    }
+
+                    // Progress covers the skipped items too.
+                    consumed[c]->publish(available);
+                }
+                if (sum != expected)
+                {
+                    ok = false;
+                }
+                matched[c] = count;
+            });
+        }
+
+        const auto start = tsc_clock::now();
+        uint64_t published = 0;
+        while (published < eventCount)
+        {
+            const size_t batch = static_cast<size_t>(std::min<uint64_t>(eventCount - published, 256));
+            const sequence_range range = claimStrategy.claim(batch);
+            for (size_t i = 0; i < range.size(); ++i)
+            {
+                const uint64_t n = published + i;
+                event& e = buffer[range[i]];
+                e.m_topic = TopicOf(n);
+                e.m_value = n;
+                masks.set(range[i], topic_bit(e.m_topic));
+            }
+            claimStrategy.publish(range);
+            published += range.size();
+        }
+
+        for (auto& consumer : consumers)
+        {
+            consumer.join();
+        }
+        const auto elapsed = tsc_clock::now_ordered() - start;
+        const double elapsedNS = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+
+        // Every event is in exactly one topic so consumer c matches the
+        // events in topics 2c and 2c+1.
+        for (size_t c = 0; c < consumerCount; ++c)
+        {
+            uint64_t expected = 0;
+            for (uint64_t i = 0; i < std::min<uint64_t>(eventCount, TopicCount); ++i)
+            {
+                const unsigned topic = TopicOf(i);
+                if (topic / 2 == c % (TopicCount / 2))
+                {
+                    expected += (eventCount - i + TopicCount - 1) / TopicCount;
+                }
+            }
+            if (matched[c] != expected)
+            {
+                ok = false;
+            }
+        }
+
+        if (!ok)
+        {
+            throw std::domain_error("Unexpected test result.");
+        }
+
+        std::cout << (f == filter::payload ? "payload" : "masks") << ", "
+                  << consumerCount << ", "
+                  << static_cast<uint64_t>(eventCount * 1e9 / elapsedNS) << ", "
+                  << matched[0] << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    // Calibrate the clock so that timestamps read the TSC rather than
+    // steady_clock.
+    disruptorplus::tsc_clock::calibrate();
+
+    const uint64_t eventCount = argc > 1 ? std::max(1, std::atoi(argv[1])) : 50 * 1000 * 1000;
+    const size_t bufferSize = 64 * 1024;
+
+    std::cout << "Topic Routing Benchmark" << std::endl
+              << "Usage: topics [event-count]" << std::endl
+              << "Event count: " << eventCount << std::endl
+              << "Buffer size: " << bufferSize << std::endl
+              << "Event size: " << sizeof(event) << " bytes" << std::endl
+              << "Topics: " << TopicCount << ", 2 per consumer" << std::endl;
+
+    try
+    {
+        PrintHeader();
+
+        for (size_t consumerCount : { 1, 2, 4 })
+        {
+            Run(filter::payload, consumerCount, bufferSize, eventCount);
+            Run(filter::masks, consumerCount, bufferSize, eventCount);
+        }
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -3,6 +3,7 @@
 #include <disruptorplus/blocking_wait_strategy.hpp>
 #include <disruptorplus/spin_wait_strategy.hpp>
 #include <disruptorplus/ring_buffer.hpp>
+#include <disruptorplus/tsc_clock.hpp>
 
 #include <thread>
 #include <chrono>
@@ -42,7 +43,7 @@ namespace
             result = sum;
         });
         
-        const auto start = std::chrono::high_resolution_clock::now();
+        const auto start = disruptorplus::tsc_clock::now();
 
         // Publisher
         for (uint64_t i = 0; i < iterationCount; ++i)
@@ -59,7 +60,7 @@ namespace
             throw std::domain_error("Unexpected test result.");
         }
        
-        const auto timeTaken = std::chrono::high_resolution_clock::now() - start;
+        const auto timeTaken = disruptorplus::tsc_clock::now_ordered() - start;
         const auto timeTakenUS = std::chrono::duration_cast<std::chrono::microseconds>(timeTaken).count();
         
         return (iterationCount * 1000 * 1000) / timeTakenUS;
@@ -68,6 +69,10 @@ namespace
 
 int main()
 {
+    // Calibrate the clock so that timestamps read the TSC rather than
+    // steady_clock.
+    disruptorplus::tsc_clock::calibrate();
+
     const size_t bufferSize = 64 * 1024;
     const uint64_t iterationCount = 10 * 1000 * 1000;
     const uint32_t runCount = 5;
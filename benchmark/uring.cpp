@@ -0,0 +1,351 @@
+#include <disruptorplus/single_threaded_claim_strategy.hpp>
+#include <disruptorplus/spin_wait_strategy.hpp>
+#include <disruptorplus/ring_buffer.hpp>
+#include <disruptorplus/tsc_clock.hpp>
+
+#include "platform.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#if defined(__linux__)
+
+#include <disruptorplus/io_uring_sink.hpp>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <system_error>
+
+using namespace disruptorplus;
+
+namespace
+{
+    struct event
+    {
+        uint64_t m_sequence;
+        uint64_t m_payload[7];
+    };
+
+    enum class sink_kind
+    {
+        write,
+        uring
+    };
+
+    void PrintHeader()
+    {
+        std::cout << "Target" << ", "
+                  << "Sink" << ", "
+                  << "FixedBuffers" << ", "
+                  << "Events/Sec" << ", "
+                  << "MB/Sec" << ", "
+                  << "SinkCpuNS/Event" << std::endl;
+    }
+
+    void WriteAll(int fd, const char* data, size_t size)
+    {
+        while (size > 0)
+        {
+            const ssize_t result = ::write(fd, data, size);
+            if (result < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                throw std::system_error(errno, std::system_category(), "write");
+            }
+            data += result;
+            size -= static_cast<size_t>(result);
+        }
+    }
+
+    // Drains the read end of a pipe, checking the events arrive in order.
+    class pipe_drain
+    {
+    public:
+
+        pipe_drain(int fd, uint64_t eventCount)
+        : m_fd(fd)
+        , m_eventCount(eventCount)
+        , m_ok(false)
+        , m_thread([this]() { drain(); })
+        {}
+
+        bool join()
+        {
+            m_thread.join();
+            return m_ok;
+        }
+
+    private:
+
+        void drain()
+        {
+            event e;
+            size_t filled = 0;
+            uint64_t expected = 0;
+            char chunk[64 * 1024];
+            ssize_t result;
+            while ((result = ::read(m_fd, chunk, sizeof(chunk))) != 0)
+            {
+                if (result < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+                    return;
+                }
+                for (ssize_t i = 0; i < result; )
+                {
+                    const size_t n = std::min(sizeof(e) - filled, static_cast<size_t>(result - i));
+                    std::memcpy(reinterpret_cast<char*>(&e) + filled, chunk + i, n);
+                    filled += n;
+                    i += static_cast<ssize_t>(n);
+                    if (filled == sizeof(e))
+                    {
+                        if (e.m_sequence != expected++)
+                        {
+                            return;
+                        }
+                        filled = 0;
+                    }
+                }
+            }
+            m_ok = expected == m_eventCount && filled == 0;
+        }
+
+        const int m_fd;
+        const uint64_t m_eventCount;
+        bool m_ok;
+        std::thread m_thread;
+
+    };
+
+    // producer -> sink -> fd
+    //
+    // The sink is the only consumer, so the producer is throttled by how
+    // quickly the sink hands events to the kernel.
+    void Run(const char* target, int fd, bool isStream, sink_kind kind, size_t bufferSize, uint64_t eventCount)
+    {
+        spin_wait_strategy waitStrategy;
+        single_threaded_claim_strategy<spin_wait_strategy> claimStrategy(bufferSize, waitStrategy);
+        ring_buffer<event> buffer(bufferSize);
+        const sequence_t last = static_cast<sequence_t>(eventCount - 1);
+
+        std::unique_ptr<io_uring_sink<event, spin_wait_strategy>> uring;
+        sequence_barrier<spin_wait_strategy> written(waitStrategy);
+        if (kind == sink_kind::uring)
+        {
+            uring.reset(new io_uring_sink<event, spin_wait_strategy>(
+                waitStrategy, buffer, fd, isStream ? -1 : 0));
+            claimStrategy.add_claim_barrier(uring->consumed());
+        }
+        else
+        {
+            claimStrategy.add_claim_barrier(written);
+        }
+
+        int64_t sinkCpuNS = 0;
+        std::thread sink([&]()
+        {
+            const benchmark::thread_usage before = benchmark::current_thread_usage();
+            if (uring)
+            {
+                uring->run(claimStrategy, last);
+            }
+            else
+            {
+                // One write() per contiguous span of each batch.
+                const size_t indexMask = bufferSize - 1;
+                sequence_t next = 0;
+                while (difference(next, last) <= 0)
+                {
+                    const sequence_t available = claimStrategy.wait_until_published(next);
+                    while (difference(next, available) <= 0)
+                    {
+                        const size_t slot = static_cast<size_t>(next) & indexMask;
+                        const size_t count = std::min(
+                            static_cast<size_t>(difference(available, next) + 1), bufferSize - slot);
+                        WriteAll(fd, reinterpret_cast<const char*>(&buffer[next]), count * sizeof(event));
+                        next = static_cast<sequence_t>(next + count);
+                    }
+                    written.publish(available);
+                }
+            }
+            sinkCpuNS = (benchmark::current_thread_usage() - before).cpuNS;
+        });
+
+        const auto start = tsc_clock::now();
+        for (uint64_t i = 0; i < eventCount; ++i)
+        {
+            const sequence_t seq = claimStrategy.claim_one();
+            event& e = buffer[seq];
+            e.m_sequence = i;
+            for (auto& word : e.m_payload)
+            {
+                word = i;
+            }
+            claimStrategy.publish(seq);
+        }
+        sink.join();
+        const auto elapsed = tsc_clock::now_ordered() - start;
+        const double elapsedNS = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+
+        std::cout << target << ", "
+                  << (kind == sink_kind::uring ? "io_uring" : "write") << ", "
+                  << (uring ? (uring->uses_fixed_buffers() ? "yes" : "no") : "n/a") << ", "
+                  << static_cast<uint64_t>(eventCount * 1e9 / elapsedNS) << ", "
+                  << static_cast<uint64_t>(eventCount * sizeof(event) * 1e9 / elapsedNS / (1024 * 1024)) << ", "
+                  << sinkCpuNS / static_cast<int64_t>(eventCount) << std::endl;
+    }
+
+    void RunFile(const std::string& directory, sink_kind kind, size_t bufferSize, uint64_t eventCount)
+    {
+        const std::string path = directory + "/events.bin";
+        const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0)
+        {
+            throw std::system_error(errno, std::system_category(), "open " + path);
+        }
+
+        try
+        {
+            Run("file", fd, false, kind, bufferSize, eventCount);
+
+            // Spot check the size and the final record.
+            struct stat st;
+            event e;
+            if (::fstat(fd, &st) != 0 ||
+                static_cast<uint64_t>(st.st_size) != eventCount * sizeof(event) ||
+                ::pread(fd, &e, sizeof(e), st.st_size - sizeof(e)) != sizeof(e) ||
+                e.m_sequence != eventCount - 1)
+            {
+                throw std::domain_error("Unexpected test result.");
+            }
+        }
+        catch (...)
+        {
+            ::close(fd);
+            ::unlink(path.c_str());
+            throw;
+        }
+        ::close(fd);
+        ::unlink(path.c_str());
+    }
+
+    void RunPipe(sink_kind kind, size_t bufferSize, uint64_t eventCount)
+    {
+        int fds[2];
+        if (::pipe(fds) != 0)
+        {
+            throw std::system_error(errno, std::system_category(), "pipe");
+        }
+        // Use the largest pipe the system allows to cut down on wake-ups.
+        ::fcntl(fds[1], F_SETPIPE_SZ, 1024 * 1024);
+
+        pipe_drain drain(fds[0], eventCount);
+        try
+        {
+            Run("pipe", fds[1], true, kind, bufferSize, eventCount);
+        }
+        catch (...)
+        {
+            ::close(fds[1]);
+            drain.join();
+            ::close(fds[0]);
+            throw;
+        }
+        ::close(fds[1]);
+        const bool ok = drain.join();
+        ::close(fds[0]);
+        if (!ok)
+        {
+            throw std::domain_error("Unexpected test result.");
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    // Calibrate the clock so that timestamps read the TSC rather than
+    // steady_clock.
+    disruptorplus::tsc_clock::calibrate();
+
+    const uint64_t eventCount = argc > 1 ? std::max(1, std::atoi(argv[1])) : 4 * 1000 * 1000;
+    const std::string parent = argc > 2 ? argv[2] : "/tmp";
+    const size_t bufferSize = 16 * 1024;
+
+    std::cout << "io_uring Sink Benchmark" << std::endl
+              << "Usage: uring [event-count [directory]]" << std::endl
+              << "Event count: " << eventCount << " (" << sizeof(event) << " bytes each)" << std::endl
+              << "Buffer size: " << bufferSize << std::endl
+              << "Directory: " << parent << std::endl;
+
+    try
+    {
+        try
+        {
+            io_uring_queue probe(1);
+        }
+        catch (std::system_error& e)
+        {
+            std::cout << "unsupported: " << e.what() << std::endl;
+            return 0;
+        }
+
+        PrintHeader();
+
+        const std::string directory = benchmark::make_temp_directory(parent);
+        if (directory.empty())
+        {
+            throw std::runtime_error("failed to create a directory in " + parent);
+        }
+
+        try
+        {
+            RunFile(directory, sink_kind::write, bufferSize, eventCount);
+            RunFile(directory, sink_kind::uring, bufferSize, eventCount);
+        }
+        catch (...)
+        {
+            benchmark::remove_directory(directory);
+            throw;
+        }
+        benchmark::remove_directory(directory);
+
+        RunPipe(sink_kind::write, bufferSize, eventCount);
+        RunPipe(sink_kind::uring, bufferSize, eventCount);
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+#else
+
+int main()
+{
+    std::cout << "io_uring Sink Benchmark" << std::endl
+              << "unsupported: io_uring is only available on Linux" << std::endl;
+    return 0;
+}
+
+#endif
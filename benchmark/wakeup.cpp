@@ -0,0 +1,198 @@
+#include <disruptorplus/single_threaded_claim_strategy.hpp>
+#include <disruptorplus/blocking_wait_strategy.hpp>
+#include <disruptorplus/spin_wait_strategy.hpp>
+#include <disruptorplus/ring_buffer.hpp>
+#include <disruptorplus/tsc_clock.hpp>
+
+#include "platform.hpp"
+#include "stats.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+
+using namespace disruptorplus;
+
+namespace
+{
+    struct event
+    {
+        int64_t m_publishedNS;
+        bool m_last;
+    };
+
+    // Upper bound on how long to wait for the consumer to park before
+    // publishing anyway. The sample is then reported as not verified.
+    const std::chrono::milliseconds parkTimeout(100);
+
+    void PrintHeader()
+    {
+        std::cout << "WaitStrategy" << ", "
+                  << "IdleUS" << ", "
+                  << "Samples" << ", "
+                  << "Parked" << ", "
+                  << "MinNS" << ", "
+                  << "P50NS" << ", "
+                  << "P90NS" << ", "
+                  << "P99NS" << ", "
+                  << "P99.9NS" << ", "
+                  << "MaxNS" << ", "
+                  << "MeanNS" << std::endl;
+    }
+
+    // Measures the time from publish() to a waiting consumer observing the
+    // published event.
+    //
+    // For each sample the producer waits until the consumer has started
+    // waiting for the next sequence, then leaves it idle for idleTime so that
+    // it progresses into the desired phase of its wait strategy. If
+    // requireParked is set the producer additionally waits until the consumer
+    // thread is blocked in the kernel. The 'Parked' column reports how many
+    // samples were taken while the consumer was verified to be parked.
+    template<typename WaitStrategy>
+    void RunWakeup(
+        const char* name,
+        std::chrono::microseconds idleTime,
+        bool requireParked,
+        int sampleCount)
+    {
+        const size_t bufferSize = 1024;
+
+        WaitStrategy waitStrategy;
+        single_threaded_claim_strategy<WaitStrategy> claimStrategy(bufferSize, waitStrategy);
+        sequence_barrier<WaitStrategy> consumed(waitStrategy);
+        claimStrategy.add_claim_barrier(consumed);
+        ring_buffer<event> buffer(bufferSize);
+
+        std::atomic<int64_t> consumerThreadId(0);
+        std::atomic<sequence_t> waitingFor(static_cast<sequence_t>(-1));
+        benchmark::histogram latency;
+
+        std::thread consumer([&]()
+        {
+            consumerThreadId.store(benchmark::current_thread_id());
+            sequence_t nextToRead = 0;
+            bool done = false;
+            while (!done)
+            {
+                waitingFor.store(nextToRead, std::memory_order_release);
+                const sequence_t available = claimStrategy.wait_until_published(nextToRead);
+                const int64_t observedNS = tsc_clock::now_ordered().time_since_epoch().count();
+                do
+                {
+                    const event& e = buffer[nextToRead];
+                    if (e.m_last)
+                    {
+                        done = true;
+                    }
+                    else
+                    {
+                        latency.record(observedNS - e.m_publishedNS);
+                    }
+                } while (nextToRead++ != available);
+                consumed.publish(available);
+            }
+        });
+
+        int parkedCount = 0;
+        for (int i = 0; i <= sampleCount; ++i)
+        {
+            const bool last = (i == sampleCount);
+            const sequence_t seq = claimStrategy.claim_one();
+
+            while (waitingFor.load(std::memory_order_acquire) != seq)
+            {
+                std::this_thread::yield();
+            }
+
+            bool parked = false;
+            if (!last)
+            {
+                std::this_thread::sleep_for(idleTime);
+                const int64_t threadId = consumerThreadId.load();
+                parked = benchmark::is_thread_sleeping(threadId);
+                if (requireParked)
+                {
+                    const auto deadline = tsc_clock::now() + parkTimeout;
+                    while (!parked && tsc_clock::now() < deadline)
+                    {
+                        std::this_thread::yield();
+                        parked = benchmark::is_thread_sleeping(threadId);
+                    }
+                }
+            }
+            if (parked)
+            {
+                ++parkedCount;
+            }
+
+            event& e = buffer[seq];
+            e.m_last = last;
+            e.m_publishedNS = tsc_clock::now().time_since_epoch().count();
+            claimStrategy.publish(seq);
+        }
+
+        consumer.join();
+
+        std::cout << name << ", "
+                  << idleTime.count() << ", "
+                  << latency.count() << ", "
+                  << parkedCount << ", "
+                  << latency.min() << ", "
+                  << latency.percentile(50) << ", "
+                  << latency.percentile(90) << ", "
+                  << latency.percentile(99) << ", "
+                  << latency.percentile(99.9) << ", "
+                  << latency.max() << ", "
+                  << static_cast<uint64_t>(latency.mean()) << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    // Calibrate the clock so that timestamps read the TSC rather than
+    // steady_clock.
+    disruptorplus::tsc_clock::calibrate();
+
+    const int sampleCount = argc > 1 ? std::max(1, std::atoi(argv[1])) : 1000;
+
+    std::cout << "Parked Consumer Wake-up Latency Benchmark" << std::endl
+              << "Usage: wakeup [sample-count]" << std::endl
+              << "Sample count: " << sampleCount << std::endl
+              << "TSC clock: " << (tsc_clock::is_tsc() ? "yes" : "no (steady_clock)") << std::endl;
+
+    if (!benchmark::platform_supported())
+    {
+        std::cout << "error: thread state queries are not available on this platform" << std::endl;
+        return 1;
+    }
+
+    try
+    {
+        PrintHeader();
+
+        // The consumer is parked on the condition variable as soon as it
+        // starts waiting, verify it has blocked before publishing.
+        RunWakeup<blocking_wait_strategy>("blocking_wait_strategy", std::chrono::microseconds(0), true, sampleCount);
+        RunWakeup<blocking_wait_strategy>("blocking_wait_strategy", std::chrono::microseconds(1000), true, sampleCount);
+
+        // The spin strategy backs off from busy-waiting to yielding to
+        // sleeping, select the phase by how long the consumer sits idle.
+        // The 'Parked' column shows how often it was caught sleeping.
+        RunWakeup<spin_wait_strategy>("spin_wait_strategy", std::chrono::microseconds(0), false, sampleCount);
+        RunWakeup<spin_wait_strategy>("spin_wait_strategy", std::chrono::microseconds(100), false, sampleCount);
+        RunWakeup<spin_wait_strategy>("spin_wait_strategy", std::chrono::microseconds(5000), false, sampleCount);
+        RunWakeup<spin_wait_strategy>("spin_wait_strategy", std::chrono::microseconds(5000), true, sampleCount);
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
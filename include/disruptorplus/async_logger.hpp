@@ -0,0 +1,487 @@
+#ifndef DISRUPTORPLUS_ASYNC_LOGGER_HPP_INCLUDED
+#define DISRUPTORPLUS_ASYNC_LOGGER_HPP_INCLUDED
+
+#include <disruptorplus/sequence.hpp>
+#include <disruptorplus/sequence_range.hpp>
+#include <disruptorplus/sequence_barrier.hpp>
+#include <disruptorplus/ring_buffer.hpp>
+#include <disruptorplus/multi_threaded_claim_strategy.hpp>
+#include <disruptorplus/tsc_clock.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+namespace disruptorplus
+{
+    /// \brief
+    /// The severity of a log record.
+    enum class log_level : uint8_t
+    {
+        debug,
+        info,
+        warning,
+        error
+    };
+
+    /// \brief
+    /// What async_logger::log() does when the ring buffer is full.
+    enum class log_overflow
+    {
+        /// Wait for the background consumer to free a slot.
+        block,
+
+        /// Drop the record and count it in async_logger::dropped().
+        drop
+    };
+
+    /// \brief
+    /// A fixed-size binary log record: a pointer to the format string plus
+    /// the raw arguments, to be formatted later by the background consumer.
+    ///
+    /// The format string is not copied so must have static storage
+    /// duration, eg. a string literal. Each \c {} in it is replaced by the
+    /// next argument. String arguments are copied into the record,
+    /// truncated if the record runs out of room.
+    struct log_record
+    {
+        enum
+        {
+            max_arguments = 8,
+            text_capacity = 64
+        };
+
+        enum class argument_type : uint8_t
+        {
+            signed_integer,
+            unsigned_integer,
+            floating_point,
+            boolean,
+            character,
+            string,
+            pointer
+        };
+
+        union argument
+        {
+            int64_t m_signed;
+            uint64_t m_unsigned;
+            double m_double;
+            const void* m_pointer;
+            struct
+            {
+                uint8_t m_offset;
+                uint8_t m_size;
+            } m_string;
+        };
+
+        int64_t m_timestamp;
+        const char* m_format;
+        log_level m_level;
+        uint8_t m_argumentCount;
+        uint8_t m_textSize;
+        argument_type m_types[max_arguments];
+        argument m_arguments[max_arguments];
+        char m_text[text_capacity];
+
+        /// \brief
+        /// Start a new record.
+        void reset(log_level level, const char* format)
+        {
+            m_timestamp = tsc_clock::now().time_since_epoch().count();
+            m_format = format;
+            m_level = level;
+            m_argumentCount = 0;
+            m_textSize = 0;
+        }
+
+        /// \brief
+        /// Append arguments to the record.
+        void add(bool value)
+        {
+            next(argument_type::boolean).m_unsigned = value ? 1 : 0;
+        }
+
+        void add(char value)
+        {
+            next(argument_type::character).m_unsigned = static_cast<unsigned char>(value);
+        }
+
+        template<typename U>
+        typename std::enable_if<std::is_integral<U>::value && std::is_signed<U>::value>::type
+        add(U value)
+        {
+            next(argument_type::signed_integer).m_signed = value;
+        }
+
+        template<typename U>
+        typename std::enable_if<std::is_integral<U>::value && std::is_unsigned<U>::value>::type
+        add(U value)
+        {
+            next(argument_type::unsigned_integer).m_unsigned = value;
+        }
+
+        template<typename U>
+        typename std::enable_if<std::is_floating_point<U>::value>::type
+        add(U value)
+        {
+            next(argument_type::floating_point).m_double = value;
+        }
+
+        void add(const char* value)
+        {
+            add_string(value, std::strlen(value));
+        }
+
+        void add(char* value)
+        {
+            add_string(value, std::strlen(value));
+        }
+
+        void add(const std::string& value)
+        {
+            add_string(value.data(), value.size());
+        }
+
+        template<typename U>
+        void add(const U* value)
+        {
+            next(argument_type::pointer).m_pointer = value;
+        }
+
+        void add_string(const char* data, size_t size)
+        {
+            size = std::min<size_t>(size, text_capacity - m_textSize);
+            argument& a = next(argument_type::string);
+            a.m_string.m_offset = m_textSize;
+            a.m_string.m_size = static_cast<uint8_t>(size);
+            std::memcpy(m_text + m_textSize, data, size);
+            m_textSize = static_cast<uint8_t>(m_textSize + size);
+        }
+
+        /// \brief
+        /// Format the message, without timestamp or level, into \p out.
+        ///
+        /// \return
+        /// The number of characters written, at most \p capacity. The
+        /// output is not null-terminated.
+        size_t format(char* out, size_t capacity) const
+        {
+            size_t size = 0;
+            size_t index = 0;
+            const char* p = m_format;
+            while (*p != '\0' && size < capacity)
+            {
+                if (p[0] == '{' && p[1] == '}' && index < m_argumentCount)
+                {
+                    size += format_argument(index++, out + size, capacity - size);
+                    p += 2;
+                }
+                else
+                {
+                    out[size++] = *p++;
+                }
+            }
+            return size;
+        }
+
+    private:
+
+        argument& next(argument_type type)
+        {
+            assert(m_argumentCount < max_arguments);
+            m_types[m_argumentCount] = type;
+            return m_arguments[m_argumentCount++];
+        }
+
+        size_t format_argument(size_t index, char* out, size_t capacity) const
+        {
+            const argument& a = m_arguments[index];
+            switch (m_types[index])
+            {
+            case argument_type::signed_integer:
+                return print(out, capacity, "%lld", static_cast<long long>(a.m_signed));
+            case argument_type::unsigned_integer:
+                return print(out, capacity, "%llu", static_cast<unsigned long long>(a.m_unsigned));
+            case argument_type::floating_point:
+                return print(out, capacity, "%g", a.m_double);
+            case argument_type::boolean:
+                return copy(out, capacity, a.m_unsigned != 0 ? "true" : "false", a.m_unsigned != 0 ? 4 : 5);
+            case argument_type::character:
+            {
+                const char c = static_cast<char>(a.m_unsigned);
+                return copy(out, capacity, &c, 1);
+            }
+            case argument_type::string:
+                return copy(out, capacity, m_text + a.m_string.m_offset, a.m_string.m_size);
+            default:
+                return print(out, capacity, "%p", a.m_pointer);
+            }
+        }
+
+        template<typename V>
+        static size_t print(char* out, size_t capacity, const char* format, V value)
+        {
+            // snprintf needs room for the terminator.
+            char buffer[32];
+            const int length = std::snprintf(buffer, sizeof(buffer), format, value);
+            return copy(out, capacity, buffer, length < 0 ? 0 : std::min<size_t>(length, sizeof(buffer) - 1));
+        }
+
+        static size_t copy(char* out, size_t capacity, const char* data, size_t size)
+        {
+            size = std::min(size, capacity);
+            std::memcpy(out, data, size);
+            return size;
+        }
+
+    };
+
+    /// \brief
+    /// An asynchronous logging frontend. Producer threads write compact
+    /// binary log_records into a multi-producer ring buffer and a single
+    /// background thread formats them and hands the text to a sink in
+    /// batches.
+    ///
+    /// Logging a record costs a slot claim, a timestamp and copying the
+    /// arguments; it neither formats, allocates nor does I/O. When the ring
+    /// buffer is full log() either waits or drops the record, depending on
+    /// the overflow policy.
+    ///
+    /// Each line is formatted as the timestamp in seconds, the level and
+    /// the message, truncated to line_capacity characters.
+    ///
+    /// \tparam WaitStrategy
+    /// The wait strategy of the ring buffer.
+    template<typename WaitStrategy>
+    class async_logger
+    {
+    public:
+
+        enum
+        {
+            line_capacity = 512
+        };
+
+        /// \brief
+        /// Construct a logger whose ring buffer holds \p bufferSize records.
+        ///
+        /// \param waitStrategy
+        /// The wait strategy of the ring buffer.
+        ///
+        /// \param bufferSize
+        /// The number of records the ring buffer holds. Must be a power of
+        /// two.
+        ///
+        /// \param overflow
+        /// What log() does when the ring buffer is full.
+        ///
+        /// \param minimumLevel
+        /// Records below this level are discarded by log().
+        ///
+        /// \param batchBytes
+        /// The size of the text buffer handed to the sink. At least
+        /// line_capacity.
+        async_logger(
+            WaitStrategy& waitStrategy,
+            size_t bufferSize,
+            log_overflow overflow = log_overflow::block,
+            log_level minimumLevel = log_level::debug,
+            size_t batchBytes = 64 * 1024)
+        : m_claimStrategy(bufferSize, waitStrategy)
+        , m_records(bufferSize)
+        , m_consumed(waitStrategy)
+        , m_overflow(overflow)
+        , m_minimumLevel(minimumLevel)
+        , m_dropped(0)
+        , m_batchBytes(std::max<size_t>(batchBytes, line_capacity))
+        , m_batch(new char[m_batchBytes])
+        , m_nextToRead(0)
+        , m_lastKnownPublished(static_cast<sequence_t>(-1))
+        {
+            m_claimStrategy.add_claim_barrier(m_consumed);
+        }
+
+        /// \brief
+        /// Query whether records of \p level are logged.
+        bool enabled(log_level level) const
+        {
+            return level >= m_minimumLevel;
+        }
+
+        /// \brief
+        /// Log a record. May be called from any thread.
+        ///
+        /// \param format
+        /// The format string. Must have static storage duration.
+        ///
+        /// \param args
+        /// Up to log_record::max_arguments integers, floating-point
+        /// numbers, bools, chars, strings or pointers.
+        ///
+        /// \return
+        /// \c false if the record was filtered out or dropped.
+        template<typename... Args>
+        bool log(log_level level, const char* format, const Args&... args)
+        {
+            static_assert(sizeof...(Args) <= log_record::max_arguments, "too many log arguments");
+
+            if (!enabled(level))
+            {
+                return false;
+            }
+
+            sequence_t seq;
+            if (m_overflow == log_overflow::block)
+            {
+                seq = m_claimStrategy.claim_one();
+            }
+            else
+            {
+                sequence_range range;
+                if (!m_claimStrategy.try_claim(1, range))
+                {
+                    m_dropped.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                seq = range.first();
+            }
+
+            log_record& record = m_records[seq];
+            record.reset(level, format);
+            add_all(record, args...);
+            m_claimStrategy.publish(seq);
+            return true;
+        }
+
+        /// \brief
+        /// The number of records dropped because the ring buffer was full.
+        uint64_t dropped() const
+        {
+            return m_dropped.load(std::memory_order_relaxed);
+        }
+
+        /// \brief
+        /// Format the records that have been published, without blocking,
+        /// and write them to \p sink.
+        ///
+        /// Only one thread may consume the records.
+        ///
+        /// \param sink
+        /// Called as <tt>sink(const char* data, size_t size)</tt> with
+        /// whole lines, once per full text buffer and once at the end.
+        ///
+        /// \return
+        /// The number of records written.
+        template<typename Sink>
+        size_t poll(Sink& sink)
+        {
+            if (difference(m_lastKnownPublished, m_nextToRead) < 0)
+            {
+                m_lastKnownPublished = m_claimStrategy.last_published_after(m_lastKnownPublished);
+                if (difference(m_lastKnownPublished, m_nextToRead) < 0)
+                {
+                    return 0;
+                }
+            }
+            return write(m_lastKnownPublished, sink);
+        }
+
+        /// \brief
+        /// Format the records that have been published, blocking until
+        /// there is at least one, and write them to \p sink.
+        template<typename Sink>
+        size_t process(Sink& sink)
+        {
+            if (difference(m_lastKnownPublished, m_nextToRead) < 0)
+            {
+                m_lastKnownPublished = m_claimStrategy.wait_until_published(m_nextToRead, m_lastKnownPublished);
+            }
+            return write(m_lastKnownPublished, sink);
+        }
+
+    private:
+
+        // Disable copy-construction
+        async_logger(const async_logger&);
+
+        static void add_all(log_record&)
+        {
+        }
+
+        template<typename Arg, typename... Args>
+        static void add_all(log_record& record, const Arg& arg, const Args&... args)
+        {
+            record.add(arg);
+            add_all(record, args...);
+        }
+
+        template<typename Sink>
+        size_t write(sequence_t last, Sink& sink)
+        {
+            const size_t count = static_cast<size_t>(difference(last, m_nextToRead) + 1);
+            size_t size = 0;
+            do
+            {
+                if (m_batchBytes - size < line_capacity)
+                {
+                    sink(static_cast<const char*>(m_batch.get()), size);
+                    size = 0;
+                }
+                size += format_line(m_records[m_nextToRead], m_batch.get() + size);
+
+                // Release slots as we go so producers are not held up by
+                // a large batch.
+                if ((m_nextToRead & 63) == 63)
+                {
+                    m_consumed.publish(m_nextToRead);
+                }
+            } while (m_nextToRead++ != last);
+            m_consumed.publish(last);
+            if (size > 0)
+            {
+                sink(static_cast<const char*>(m_batch.get()), size);
+            }
+            return count;
+        }
+
+        static size_t format_line(const log_record& record, char* out)
+        {
+            static const char* const levels[] = { "DEBUG", "INFO", "WARN", "ERROR" };
+            const int64_t seconds = record.m_timestamp / 1000000000;
+            const int64_t nanoseconds = record.m_timestamp % 1000000000;
+            const int length = std::snprintf(
+                out, line_capacity, "%lld.%09lld %-5s ",
+                static_cast<long long>(seconds),
+                static_cast<long long>(nanoseconds),
+                levels[static_cast<size_t>(record.m_level)]);
+            size_t size = length < 0 ? 0 : std::min<size_t>(length, line_capacity - 1);
+            size += record.format(out + size, line_capacity - 1 - size);
+            out[size++] = '\n';
+            return size;
+        }
+
+        multi_threaded_claim_strategy<WaitStrategy> m_claimStrategy;
+        ring_buffer<log_record> m_records;
+        sequence_barrier<WaitStrategy> m_consumed;
+        const log_overflow m_overflow;
+        const log_level m_minimumLevel;
+        std::atomic<uint64_t> m_dropped;
+
+        // Consumer state.
+        const size_t m_batchBytes;
+        std::unique_ptr<char[]> m_batch;
+        sequence_t m_nextToRead;
+        sequence_t m_lastKnownPublished;
+
+    };
+}
+
+#endif
@@ -118,11 +118,11 @@ namespace disruptorplus
                 std::unique_lock<std::mutex> lock(m_mutex);
                 m_cv.wait_for(
                     lock,
+                    timeout,
                     [&]() -> bool {
                         result = minimum_sequence_after(sequence, count, sequences);
                         return difference(result, sequence) >= 0;
-                    },
-                    timeout);
+                    });
             }
             return result;
         }
@@ -171,11 +171,114 @@ namespace disruptorplus
                 std::unique_lock<std::mutex> lock(m_mutex);
                 m_cv.wait_until(
                     lock,
+                    timeoutTime,
                     [&]() -> bool {
                         result = minimum_sequence_after(sequence, count, sequences);
                         return difference(result, sequence) >= 0;
-                    },
-                    timeoutTime);
+                    });
+            }
+            return result;
+        }
+
+        /// \brief
+        /// Wait unconditionally until any of the specified sequences
+        /// has published at least the specified sequence value.
+        ///
+        /// \param sequence
+        /// The sequence number to wait for.
+        ///
+        /// \param count
+        /// The number of elements in \p sequences.
+        /// Must be greater than zero.
+        ///
+        /// \param sequences
+        /// An array of \p count pointers to sequence values.
+        /// The call will not return until at least one of these values has
+        /// advanced to the specified \p sequence.
+        ///
+        /// \return
+        /// The value of the most-advanced sequence.
+        /// This value is guaranteed to be at least \p sequence.
+        ///
+        /// \throw std::system_error
+        /// If the system does not have enough resources to perform this operation.
+        sequence_t wait_until_any_published(
+            sequence_t sequence,
+            size_t count,
+            const std::atomic<sequence_t>* const sequences[])
+        {
+            assert(count > 0);
+            sequence_t result;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_cv.wait(lock, [&]() -> bool {
+                    result = maximum_sequence(count, sequences);
+                    return difference(result, sequence) >= 0;
+                    });
+            }
+            return result;
+        }
+
+        /// \brief
+        /// Wait until either any of the specified sequences has published
+        /// at least the specified sequence value or a timeout is reached.
+        ///
+        /// \return
+        /// If the operation timed out then returns some number such
+        /// that <tt>difference(result, sequence) < 0</tt>, otherwise
+        /// returns the most-advanced of all the sequence values read
+        /// from \p sequences, which is guaranteed to satisfy
+        /// <tt>difference(result, sequence) >= 0</tt>.
+        template<typename Rep, typename Period>
+        sequence_t wait_until_any_published(
+            sequence_t sequence,
+            size_t count,
+            const std::atomic<sequence_t>* const sequences[],
+            const std::chrono::duration<Rep, Period>& timeout)
+        {
+            assert(count > 0);
+            sequence_t result;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_cv.wait_for(
+                    lock,
+                    timeout,
+                    [&]() -> bool {
+                        result = maximum_sequence(count, sequences);
+                        return difference(result, sequence) >= 0;
+                    });
+            }
+            return result;
+        }
+
+        /// \brief
+        /// Wait until either any of the specified sequences has published
+        /// at least the specified sequence value or a timeout time is reached.
+        ///
+        /// \return
+        /// If the operation timed out then returns some number such
+        /// that <tt>difference(result, sequence) < 0</tt>, otherwise
+        /// returns the most-advanced of all the sequence values read
+        /// from \p sequences, which is guaranteed to satisfy
+        /// <tt>difference(result, sequence) >= 0</tt>.
+        template<typename Clock, typename Duration>
+        sequence_t wait_until_any_published(
+            sequence_t sequence,
+            size_t count,
+            const std::atomic<sequence_t>* const sequences[],
+            const std::chrono::time_point<Clock, Duration>& timeoutTime)
+        {
+            assert(count > 0);
+            sequence_t result;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_cv.wait_until(
+                    lock,
+                    timeoutTime,
+                    [&]() -> bool {
+                        result = maximum_sequence(count, sequences);
+                        return difference(result, sequence) >= 0;
+                    });
             }
             return result;
         }
@@ -2,18 +2,57 @@
 #define DISRUPTORPLUS_CONFIG_HPP_INCLUDED
 
 #include <cstddef>
+#include <new>
 
 namespace disruptorplus
 {
     /// \brief
     /// The expected size of a cache-line in bytes.
     ///
-    /// Some data structures are padded according to this value to
-    /// ensure certain data members do not share a cache line with
-    /// other data in order to reduce the problem of false-sharing.
+    /// Define \c DISRUPTORPLUS_CACHE_LINE_SIZE to override the value.
+    /// Otherwise it is \c std::hardware_destructive_interference_size where
+    /// the standard library provides it, or 64 bytes, which is typical for
+    /// x86/x64 architectures.
     ///
-    /// The value of 64 bytes is typical for x86/x64 architectures.
+    /// The library is header-only so the value is fixed per build. All
+    /// translation units sharing disruptorplus objects must agree on it.
+#if defined(DISRUPTORPLUS_CACHE_LINE_SIZE)
+    const size_t CacheLineSize = DISRUPTORPLUS_CACHE_LINE_SIZE;
+#elif defined(__cpp_lib_hardware_interference_size)
+# if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 12
+#  pragma GCC diagnostic push
+#  pragma GCC diagnostic ignored "-Winterference-size"
+# endif
+    const size_t CacheLineSize = std::hardware_destructive_interference_size;
+# if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 12
+#  pragma GCC diagnostic pop
+# endif
+#else
     const size_t CacheLineSize = 64;
+#endif
+
+    /// \brief
+    /// The number of bytes that data written by different threads is kept
+    /// apart by to avoid false-sharing.
+    ///
+    /// Used to pad the published sequence of sequence_barrier, the claim
+    /// cursors of the claim strategies, the ends of per-slot metadata
+    /// arrays and, when requested, the slots of a ring_buffer.
+    ///
+    /// Defaults to \ref CacheLineSize. Define \c DISRUPTORPLUS_PADDING_SIZE
+    /// to override it. 128 is a better choice on Intel processors, whose
+    /// adjacent-line prefetcher fetches cache lines in aligned pairs, and
+    /// on ARM servers with 128-byte cache lines.
+#if defined(DISRUPTORPLUS_PADDING_SIZE)
+    const size_t PaddingSize = DISRUPTORPLUS_PADDING_SIZE;
+#else
+    const size_t PaddingSize = CacheLineSize;
+#endif
+
+    static_assert(CacheLineSize > 0 && (CacheLineSize & (CacheLineSize - 1)) == 0,
+                  "CacheLineSize must be a power of two");
+    static_assert(PaddingSize >= 16 && (PaddingSize & (PaddingSize - 1)) == 0,
+                  "PaddingSize must be a power of two of at least 16 bytes");
 }
 
 #endif
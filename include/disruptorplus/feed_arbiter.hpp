@@ -0,0 +1,460 @@
+#ifndef DISRUPTORPLUS_FEED_ARBITER_HPP_INCLUDED
+#define DISRUPTORPLUS_FEED_ARBITER_HPP_INCLUDED
+
+#include <disruptorplus/sequence.hpp>
+#include <disruptorplus/sequence_barrier.hpp>
+#include <disruptorplus/ring_buffer.hpp>
+#include <disruptorplus/spin_wait.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace disruptorplus
+{
+    /// \brief
+    /// Counters kept by a feed_arbiter for each of its input lines.
+    struct feed_line_statistics
+    {
+        feed_line_statistics()
+        : m_received(0)
+        , m_won(0)
+        , m_duplicates(0)
+        , m_gapFills(0)
+        {}
+
+        /// Messages read from the line.
+        uint64_t m_received;
+
+        /// Messages this line delivered first, and which were therefore
+        /// emitted from it.
+        uint64_t m_won;
+
+        /// Messages that had already been delivered, by either line, or
+        /// whose feed sequence number had been given up as lost.
+        uint64_t m_duplicates;
+
+        /// Messages that filled the gap at the head of the window,
+        /// releasing messages held behind it.
+        uint64_t m_gapFills;
+    };
+
+    /// \brief
+    /// Merges two redundant feeds (the A and B lines) that carry the same
+    /// messages with the same feed sequence numbers, emitting each feed
+    /// sequence number once, in order, from whichever line delivers it
+    /// first.
+    ///
+    /// Each line is an input ring buffer with its own producer. The arbiter
+    /// reads both, copies the messages it keeps into an output ring buffer
+    /// via the output's claim strategy and publishes the lines' consumed()
+    /// barriers, which the line producers should gate on.
+    ///
+    /// A message that arrives ahead of the next expected feed sequence
+    /// number opens a gap. It is held in a window of a fixed number of
+    /// messages until the other line fills the gap. If a message arrives
+    /// too far ahead to fit in the window, the oldest missing sequence
+    /// numbers are given up as lost and the held messages before it are
+    /// released. Call skip_gap() to give up on a gap earlier, eg. after a
+    /// timeout.
+    ///
+    /// All storage is allocated up-front so processing does not allocate.
+    /// Only a single thread may drive the arbiter.
+    ///
+    /// \tparam T
+    /// The message type. Must be default-constructible and copy-assignable.
+    ///
+    /// \tparam WaitStrategy
+    /// The wait strategy of the consumed() barriers.
+    ///
+    /// \tparam OutputClaimStrategy
+    /// The claim strategy of the output ring buffer.
+    ///
+    /// \tparam FeedSequence
+    /// A function object with signature <tt>uint64_t(const T&)</tt>
+    /// returning the message's feed sequence number. Feed sequence numbers
+    /// increase by one per message on each line.
+    template<typename T, typename WaitStrategy, typename OutputClaimStrategy, typename FeedSequence>
+    class feed_arbiter
+    {
+    public:
+
+        /// \brief
+        /// The index of each input line.
+        enum line
+        {
+            line_a = 0,
+            line_b = 1
+        };
+
+        /// \brief
+        /// Construct an arbiter that reads from \p lineA and \p lineB and
+        /// writes to \p output.
+        ///
+        /// \param waitStrategy
+        /// The wait strategy used by the consumed() barriers.
+        ///
+        /// \param lineA, lineB
+        /// The input ring buffers. Must outlive the arbiter.
+        ///
+        /// \param outputClaimStrategy
+        /// The claim strategy used to claim slots in \p output.
+        ///
+        /// \param output
+        /// The output ring buffer. Must outlive the arbiter.
+        ///
+        /// \param window
+        /// The maximum number of messages held while waiting for a gap to be
+        /// filled. Must be a power of two.
+        ///
+        /// \param firstFeedSequence
+        /// The feed sequence number of the first message expected.
+        ///
+        /// \param feedSequence
+        /// Returns a message's feed sequence number.
+        feed_arbiter(
+            WaitStrategy& waitStrategy,
+            const ring_buffer<T>& lineA,
+            const ring_buffer<T>& lineB,
+            OutputClaimStrategy& outputClaimStrategy,
+            ring_buffer<T>& output,
+            size_t window,
+            uint64_t firstFeedSequence = 0,
+            FeedSequence feedSequence = FeedSequence())
+        : m_outputClaimStrategy(outputClaimStrategy)
+        , m_output(output)
+        , m_feedSequence(feedSequence)
+        , m_windowMask(window - 1)
+        , m_window(new T[window])
+        , m_held(new bool[window]())
+        , m_heldCount(0)
+        , m_nextFeedSequence(firstFeedSequence)
+        , m_emitted(0)
+        , m_gaps(0)
+        , m_lost(0)
+        , m_consumedA(waitStrategy)
+        , m_consumedB(waitStrategy)
+        {
+            // window must be power-of-two
+            assert(window > 0 && (window & m_windowMask) == 0);
+
+            m_lines[line_a] = &lineA;
+            m_lines[line_b] = &lineB;
+            m_nextSequence[line_a] = 0;
+            m_nextSequence[line_b] = 0;
+        }
+
+        /// \brief
+        /// The barrier to which the last sequence number of line \p l that
+        /// has been processed is published.
+        sequence_barrier<WaitStrategy>& consumed(line l)
+        {
+            return l == line_a ? m_consumedA : m_consumedB;
+        }
+
+        /// \brief
+        /// The sequence number of the next item to be read from line \p l.
+        sequence_t next_sequence(line l) const
+        {
+            return m_nextSequence[l];
+        }
+
+        /// \brief
+        /// The feed sequence number of the next message to be emitted.
+        uint64_t next_feed_sequence() const
+        {
+            return m_nextFeedSequence;
+        }
+
+        /// \brief
+        /// The number of messages held waiting for a gap to be filled.
+        size_t held() const
+        {
+            return m_heldCount;
+        }
+
+        /// \brief
+        /// The number of messages written to the output.
+        uint64_t emitted() const
+        {
+            return m_emitted;
+        }
+
+        /// \brief
+        /// The number of gaps opened, ie. messages arriving ahead of the
+        /// next expected feed sequence number while no other message was
+        /// held.
+        uint64_t gaps() const
+        {
+            return m_gaps;
+        }
+
+        /// \brief
+        /// The number of feed sequence numbers given up as lost because
+        /// neither line delivered them in time.
+        uint64_t lost() const
+        {
+            return m_lost;
+        }
+
+        /// \brief
+        /// The counters of line \p l.
+        const feed_line_statistics& statistics(line l) const
+        {
+            return m_statistics[l];
+        }
+
+        /// \brief
+        /// Process the items of line \p l up to and including sequence
+        /// number \p last, which must have been published, then publish
+        /// consumed(l).
+        ///
+        /// \return
+        /// The number of messages emitted.
+        size_t process(line l, sequence_t last)
+        {
+            const uint64_t emittedBefore = m_emitted;
+            const ring_buffer<T>& buffer = *m_lines[l];
+            sequence_t seq = m_nextSequence[l];
+            if (difference(last, seq) < 0)
+            {
+                return 0;
+            }
+            do
+            {
+                arbitrate(l, buffer[seq]);
+            } while (seq++ != last);
+            m_nextSequence[l] = seq;
+            consumed(l).publish(last);
+            return static_cast<size_t>(m_emitted - emittedBefore);
+        }
+
+        /// \brief
+        /// Process whatever has been published to either line without
+        /// blocking, alternating between them in batches of at most
+        /// \p batchSize items so that neither line is starved.
+        ///
+        /// \tparam SourceA, SourceB
+        /// Types with a <tt>last_published()</tt> method, eg.
+        /// single_threaded_claim_strategy or sequence_barrier. For
+        /// multi_threaded_claim_strategy call process() from your own
+        /// loop instead.
+        ///
+        /// \return
+        /// The number of items read from both lines.
+        template<typename SourceA, typename SourceB>
+        size_t poll(const SourceA& sourceA, const SourceB& sourceB, size_t batchSize = 64)
+        {
+            size_t read = 0;
+            bool progress = true;
+            while (progress)
+            {
+                progress = false;
+                for (int i = 0; i < 2; ++i)
+                {
+                    const line l = static_cast<line>(i);
+                    const sequence_t available =
+                        l == line_a ? sourceA.last_published() : sourceB.last_published();
+                    sequence_diff_t count = difference(available, m_nextSequence[l]) + 1;
+                    if (count > 0)
+                    {
+                        count = std::min<sequence_diff_t>(count, static_cast<sequence_diff_t>(batchSize));
+                        process(l, m_nextSequence[l] + static_cast<sequence_t>(count - 1));
+                        read += static_cast<size_t>(count);
+                        progress = true;
+                    }
+                }
+            }
+            return read;
+        }
+
+        /// \brief
+        /// Read both lines until the message with feed sequence number
+        /// \p lastFeedSequence has been emitted or given up as lost.
+        ///
+        /// Spins while neither line has anything new. A trailing gap that
+        /// neither line ever fills keeps this waiting, so give up on gaps
+        /// from another loop with skip_gap() if the lines can stop early.
+        template<typename SourceA, typename SourceB>
+        void run(const SourceA& sourceA, const SourceB& sourceB, uint64_t lastFeedSequence)
+        {
+            spin_wait spinner;
+            while (m_nextFeedSequence <= lastFeedSequence)
+            {
+                if (poll(sourceA, sourceB) > 0)
+                {
+                    spinner.reset();
+                }
+                else
+                {
+                    spinner.spin_once();
+                }
+            }
+        }
+
+        /// \brief
+        /// Give up on the feed sequence numbers missing before the oldest
+        /// held message, counting them as lost, and emit the held messages
+        /// up to the next gap.
+        ///
+        /// Does nothing if no messages are held.
+        void skip_gap()
+        {
+            if (m_heldCount == 0)
+            {
+                return;
+            }
+            uint64_t next = m_nextFeedSequence;
+            while (!m_held[next & m_windowMask])
+            {
+                ++next;
+            }
+            advance_to(next);
+        }
+
+    private:
+
+        // Disable copy-construction
+        feed_arbiter(const feed_arbiter&);
+
+        void arbitrate(line l, const T& message)
+        {
+            feed_line_statistics& stats = m_statistics[l];
+            ++stats.m_received;
+
+            const uint64_t feedSequence = m_feedSequence(message);
+            if (feedSequence < m_nextFeedSequence)
+            {
+                ++stats.m_duplicates;
+                return;
+            }
+
+            if (feedSequence == m_nextFeedSequence)
+            {
+                accept(stats, message);
+                return;
+            }
+
+            // Ahead of a gap. Give up on the oldest missing messages if the
+            // window cannot reach this far.
+            if (feedSequence - m_nextFeedSequence > m_windowMask)
+            {
+                advance_to(feedSequence - m_windowMask);
+                if (feedSequence == m_nextFeedSequence)
+                {
+                    accept(stats, message);
+                    return;
+                }
+            }
+
+            const size_t slot = static_cast<size_t>(feedSequence) & m_windowMask;
+            if (m_held[slot])
+            {
+                ++stats.m_duplicates;
+                return;
+            }
+            if (m_heldCount == 0)
+            {
+                ++m_gaps;
+            }
+            ++stats.m_won;
+            m_window[slot] = message;
+            m_held[slot] = true;
+            ++m_heldCount;
+        }
+
+        // Emit the message with the next expected feed sequence number and
+        // any held messages it releases.
+        void accept(feed_line_statistics& stats, const T& message)
+        {
+            ++stats.m_won;
+            emit(message);
+            ++m_nextFeedSequence;
+            if (m_heldCount > 0 && m_held[static_cast<size_t>(m_nextFeedSequence) & m_windowMask])
+            {
+                ++stats.m_gapFills;
+            }
+            release_held();
+        }
+
+        // Emit held messages from the head of the window until the next gap.
+        void release_held()
+        {
+            while (m_heldCount > 0)
+            {
+                const size_t slot = static_cast<size_t>(m_nextFeedSequence) & m_windowMask;
+                if (!m_held[slot])
+                {
+                    return;
+                }
+                emit(m_window[slot]);
+                m_held[slot] = false;
+                --m_heldCount;
+                ++m_nextFeedSequence;
+            }
+        }
+
+        // Advance the next expected feed sequence number to at least
+        // target, emitting held messages and counting missing ones as lost.
+        void advance_to(uint64_t target)
+        {
+            // Held messages are all within the window so this loop is
+            // bounded by its size.
+            while (m_nextFeedSequence < target && m_heldCount > 0)
+            {
+                const size_t slot = static_cast<size_t>(m_nextFeedSequence) & m_windowMask;
+                if (m_held[slot])
+                {
+                    emit(m_window[slot]);
+                    m_held[slot] = false;
+                    --m_heldCount;
+                }
+                else
+                {
+                    ++m_lost;
+                }
+                ++m_nextFeedSequence;
+            }
+            if (m_nextFeedSequence < target)
+            {
+                m_lost += target - m_nextFeedSequence;
+                m_nextFeedSequence = target;
+            }
+            release_held();
+        }
+
+        void emit(const T& message)
+        {
+            const sequence_t seq = m_outputClaimStrategy.claim_one();
+            m_output[seq] = message;
+            m_outputClaimStrategy.publish(seq);
+            ++m_emitted;
+        }
+
+        OutputClaimStrategy& m_outputClaimStrategy;
+        ring_buffer<T>& m_output;
+        FeedSequence m_feedSequence;
+
+        const ring_buffer<T>* m_lines[2];
+        sequence_t m_nextSequence[2];
+        feed_line_statistics m_statistics[2];
+
+        const size_t m_windowMask;
+        std::unique_ptr<T[]> m_window;
+        std::unique_ptr<bool[]> m_held;
+        size_t m_heldCount;
+
+        uint64_t m_nextFeedSequence;
+        uint64_t m_emitted;
+        uint64_t m_gaps;
+        uint64_t m_lost;
+
+        sequence_barrier<WaitStrategy> m_consumedA;
+        sequence_barrier<WaitStrategy> m_consumedB;
+
+    };
+}
+
+#endif
@@ -0,0 +1,130 @@
+#ifndef DISRUPTORPLUS_INTRINSICS_HPP_INCLUDED
+#define DISRUPTORPLUS_INTRINSICS_HPP_INCLUDED
+
+#include <cassert>
+#include <cstdint>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+# include <intrin.h>
+#endif
+
+// DISRUPTORPLUS_X86 is 1 where the SSE2 intrinsics are available.
+// DISRUPTORPLUS_X86_MULTIVERSION is 1 where AVX2 and AVX-512 kernels can
+// also be compiled, using target attributes, and selected at runtime.
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+# include <immintrin.h>
+# define DISRUPTORPLUS_X86 1
+# define DISRUPTORPLUS_X86_MULTIVERSION 1
+#elif defined(_MSC_VER) && defined(_M_X64)
+# include <emmintrin.h>
+# define DISRUPTORPLUS_X86 1
+# define DISRUPTORPLUS_X86_MULTIVERSION 0
+#else
+# define DISRUPTORPLUS_X86 0
+# define DISRUPTORPLUS_X86_MULTIVERSION 0
+#endif
+
+namespace disruptorplus
+{
+    /// \brief
+    /// The index of the lowest set bit of \p bits, which must be non-zero.
+    inline unsigned lowest_bit(uint64_t bits)
+    {
+        assert(bits != 0);
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned>(__builtin_ctzll(bits));
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+        unsigned long index;
+        _BitScanForward64(&index, bits);
+        return static_cast<unsigned>(index);
+#elif defined(_MSC_VER)
+        unsigned long index;
+        if (_BitScanForward(&index, static_cast<unsigned long>(bits)))
+        {
+            return static_cast<unsigned>(index);
+        }
+        _BitScanForward(&index, static_cast<unsigned long>(bits >> 32));
+        return static_cast<unsigned>(index) + 32;
+#else
+        unsigned index = 0;
+        for (unsigned shift = 32; shift > 0; shift /= 2)
+        {
+            if ((bits & ((static_cast<uint64_t>(1) << shift) - 1)) == 0)
+            {
+                bits >>= shift;
+                index += shift;
+            }
+        }
+        return index;
+#endif
+    }
+
+    /// \brief
+    /// The index of the highest set bit of \p bits, which must be non-zero.
+    inline unsigned highest_bit(uint64_t bits)
+    {
+        assert(bits != 0);
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned>(63 - __builtin_clzll(bits));
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+        unsigned long index;
+        _BitScanReverse64(&index, bits);
+        return static_cast<unsigned>(index);
+#elif defined(_MSC_VER)
+        unsigned long index;
+        if (_BitScanReverse(&index, static_cast<unsigned long>(bits >> 32)))
+        {
+            return static_cast<unsigned>(index) + 32;
+        }
+        _BitScanReverse(&index, static_cast<unsigned long>(bits));
+        return static_cast<unsigned>(index);
+#else
+        unsigned index = 0;
+        for (unsigned shift = 32; shift > 0; shift /= 2)
+        {
+            if ((bits >> shift) != 0)
+            {
+                bits >>= shift;
+                index += shift;
+            }
+        }
+        return index;
+#endif
+    }
+
+#if DISRUPTORPLUS_X86
+
+    /// \brief
+    /// An x86 vector instruction set that SIMD kernels are compiled for.
+    enum class x86_vector_isa
+    {
+        sse2,
+        avx2,
+        avx512f
+    };
+
+    /// \brief
+    /// The widest vector instruction set that the processor and operating
+    /// system support and that this build can compile kernels for.
+    ///
+    /// Always SSE2 when DISRUPTORPLUS_X86_MULTIVERSION is 0, eg. for MSVC.
+    inline x86_vector_isa widest_x86_vector_isa()
+    {
+#if DISRUPTORPLUS_X86_MULTIVERSION
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f"))
+        {
+            return x86_vector_isa::avx512f;
+        }
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return x86_vector_isa::avx2;
+        }
+#endif
+        return x86_vector_isa::sse2;
+    }
+
+#endif
+}
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef DISRUPTORPLUS_IO_MESSAGE_HPP_INCLUDED
+#define DISRUPTORPLUS_IO_MESSAGE_HPP_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+
+namespace disruptorplus
+{
+    /// \brief
+    /// The size recorded in a slot that was claimed by an I/O producer but
+    /// never filled. Consumers must skip these slots.
+    static const uint32_t io_message_tombstone = 0xFFFFFFFFu;
+
+    /// \brief
+    /// A ring buffer event that I/O producers such as slot_reader and
+    /// io_uring_source read into directly.
+    ///
+    /// Any event type with a \c uint32_t \c m_size member and a \c m_data
+    /// character array can be used in its place, eg. to add fields that
+    /// consumers fill in.
+    ///
+    /// \tparam Capacity
+    /// The maximum number of bytes received into one slot.
+    template<size_t Capacity>
+    struct io_message
+    {
+        /// \brief
+        /// Number of bytes of \c m_data that were received, or
+        /// io_message_tombstone.
+        uint32_t m_size;
+
+        char m_data[Capacity];
+
+        bool is_tombstone() const { return m_size == io_message_tombstone; }
+    };
+}
+
+#endif
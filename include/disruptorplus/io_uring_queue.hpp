@@ -0,0 +1,275 @@
+#ifndef DISRUPTORPLUS_IO_URING_QUEUE_HPP_INCLUDED
+#define DISRUPTORPLUS_IO_URING_QUEUE_HPP_INCLUDED
+
+#if !defined(__linux__)
+# error "io_uring is only available on Linux"
+#endif
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <system_error>
+
+namespace disruptorplus
+{
+    /// \brief
+    /// A minimal io_uring submission/completion queue pair driven through
+    /// the raw system calls, so no dependency on liburing is needed.
+    ///
+    /// Only the calling thread may use a given queue.
+    class io_uring_queue
+    {
+    public:
+
+        /// \brief
+        /// Create an io_uring instance.
+        ///
+        /// \param entries
+        /// The submission queue depth. Rounded up to a power of two by the
+        /// kernel. The completion queue is twice as deep.
+        ///
+        /// \throw std::system_error
+        /// If io_uring is unavailable (eg. disabled by the kernel, blocked by
+        /// a seccomp filter) or the queues could not be mapped.
+        explicit io_uring_queue(unsigned entries)
+        : m_fd(-1)
+        , m_sqRing(nullptr)
+        , m_cqRing(nullptr)
+        , m_sqRingSize(0)
+        , m_cqRingSize(0)
+        , m_sqes(nullptr)
+        , m_sqeTail(0)
+        {
+            io_uring_params params;
+            std::memset(&params, 0, sizeof(params));
+            m_fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+            if (m_fd < 0)
+            {
+                throw std::system_error(errno, std::system_category(), "io_uring_setup");
+            }
+
+            m_sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+            m_cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+            const bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+            if (singleMap)
+            {
+                m_sqRingSize = m_cqRingSize = std::max(m_sqRingSize, m_cqRingSize);
+            }
+
+            m_sqRing = map(m_sqRingSize, IORING_OFF_SQ_RING);
+            m_cqRing = singleMap ? m_sqRing : map(m_cqRingSize, IORING_OFF_CQ_RING);
+            m_sqes = static_cast<io_uring_sqe*>(map(params.sq_entries * sizeof(io_uring_sqe), IORING_OFF_SQES));
+
+            unsigned char* sq = static_cast<unsigned char*>(m_sqRing);
+            m_sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+            m_sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+            m_sqMask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+            m_sqEntries = params.sq_entries;
+            m_sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+
+            unsigned char* cq = static_cast<unsigned char*>(m_cqRing);
+            m_cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+            m_cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+            m_cqMask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+            m_cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+            m_sqeTail = *m_sqTail;
+        }
+
+        ~io_uring_queue()
+        {
+            close();
+        }
+
+        /// \brief
+        /// The submission queue depth.
+        unsigned entries() const { return m_sqEntries; }
+
+        /// \brief
+        /// Register buffers that subsequent READ_FIXED/WRITE_FIXED operations
+        /// refer to by index. The memory is pinned until the queue is destroyed.
+        ///
+        /// \return
+        /// Zero on success, otherwise the error code. Registration commonly
+        /// fails with ENOMEM when the buffers exceed RLIMIT_MEMLOCK.
+        int register_buffers(const iovec* buffers, unsigned count)
+        {
+            if (::syscall(__NR_io_uring_register, m_fd, IORING_REGISTER_BUFFERS, buffers, count) != 0)
+            {
+                return errno;
+            }
+            return 0;
+        }
+
+        /// \brief
+        /// Get the next free submission queue entry, zero-initialised.
+        ///
+        /// \return
+        /// The entry, or \c nullptr if the submission queue is full.
+        io_uring_sqe* get_sqe()
+        {
+            const unsigned head = __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE);
+            if (m_sqeTail - head >= m_sqEntries)
+            {
+                return nullptr;
+            }
+            io_uring_sqe* sqe = &m_sqes[m_sqeTail & m_sqMask];
+            m_sqArray[m_sqeTail & m_sqMask] = m_sqeTail & m_sqMask;
+            ++m_sqeTail;
+            std::memset(sqe, 0, sizeof(*sqe));
+            return sqe;
+        }
+
+        /// \brief
+        /// The number of entries obtained from get_sqe() that the kernel has
+        /// not yet consumed.
+        unsigned pending() const
+        {
+            return m_sqeTail - __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE);
+        }
+
+        /// \brief
+        /// Submit all entries obtained from get_sqe() that the kernel has not
+        /// yet consumed and optionally wait for completions.
+        ///
+        /// Entries the kernel does not accept, because of a partial submit or
+        /// because it returned EAGAIN/EBUSY, stay in the submission queue and
+        /// are submitted again by the next call.
+        ///
+        /// \param waitFor
+        /// The minimum number of completions to wait for. Not waited for if
+        /// the kernel returns EAGAIN/EBUSY, eg. because the completion queue
+        /// needs reaping first.
+        ///
+        /// \return
+        /// The number of entries the kernel consumed.
+        ///
+        /// \throw std::system_error
+        /// If io_uring_enter() fails.
+        unsigned submit(unsigned waitFor = 0)
+        {
+            __atomic_store_n(m_sqTail, m_sqeTail, __ATOMIC_RELEASE);
+            const unsigned toSubmit = pending();
+            if (toSubmit == 0 && waitFor == 0)
+            {
+                return 0;
+            }
+
+            const unsigned flags = waitFor > 0 ? IORING_ENTER_GETEVENTS : 0;
+            for (;;)
+            {
+                const long result = ::syscall(__NR_io_uring_enter, m_fd, toSubmit, waitFor, flags, nullptr, 0);
+                if (result >= 0)
+                {
+                    return static_cast<unsigned>(result);
+                }
+                if (errno == EAGAIN || errno == EBUSY)
+                {
+                    // Out of resources or the completion queue is backed up,
+                    // let the caller reap and retry.
+                    return 0;
+                }
+                if (errno != EINTR)
+                {
+                    throw std::system_error(errno, std::system_category(), "io_uring_enter");
+                }
+            }
+        }
+
+        /// \brief
+        /// Get the oldest completion without removing it.
+        ///
+        /// \return
+        /// The completion, or \c nullptr if none are available.
+        const io_uring_cqe* peek_cqe() const
+        {
+            const unsigned head = *m_cqHead;
+            if (head == __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE))
+            {
+                return nullptr;
+            }
+            return &m_cqes[head & m_cqMask];
+        }
+
+        /// \brief
+        /// Remove the completion returned by peek_cqe().
+        void cqe_seen()
+        {
+            __atomic_store_n(m_cqHead, *m_cqHead + 1, __ATOMIC_RELEASE);
+        }
+
+    private:
+
+        void* map(size_t size, uint64_t offset)
+        {
+            void* p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                             m_fd, static_cast<off_t>(offset));
+            if (p == MAP_FAILED)
+            {
+                const int error = errno;
+                close();
+                throw std::system_error(error, std::system_category(), "mmap io_uring");
+            }
+            return p;
+        }
+
+        void close()
+        {
+            if (m_sqes != nullptr)
+            {
+                ::munmap(m_sqes, m_sqEntries * sizeof(io_uring_sqe));
+                m_sqes = nullptr;
+            }
+            if (m_cqRing != nullptr && m_cqRing != m_sqRing)
+            {
+                ::munmap(m_cqRing, m_cqRingSize);
+            }
+            m_cqRing = nullptr;
+            if (m_sqRing != nullptr)
+            {
+                ::munmap(m_sqRing, m_sqRingSize);
+                m_sqRing = nullptr;
+            }
+            if (m_fd >= 0)
+            {
+                ::close(m_fd);
+                m_fd = -1;
+            }
+        }
+
+        // Disable copy-construction
+        io_uring_queue(const io_uring_queue&);
+
+        int m_fd;
+        void* m_sqRing;
+        void* m_cqRing;
+        size_t m_sqRingSize;
+        size_t m_cqRingSize;
+        io_uring_sqe* m_sqes;
+
+        unsigned* m_sqHead;
+        unsigned* m_sqTail;
+        unsigned* m_sqArray;
+        unsigned m_sqMask;
+        unsigned m_sqEntries;
+
+        unsigned* m_cqHead;
+        unsigned* m_cqTail;
+        unsigned m_cqMask;
+        io_uring_cqe* m_cqes;
+
+        // Entries handed out by get_sqe(). Entries between the kernel's head
+        // and this are pending submission.
+        unsigned m_sqeTail;
+
+    };
+}
+
+#endif
@@ -0,0 +1,471 @@
+#ifndef DISRUPTORPLUS_IO_URING_SINK_HPP_INCLUDED
+#define DISRUPTORPLUS_IO_URING_SINK_HPP_INCLUDED
+
+#include <disruptorplus/sequence.hpp>
+#include <disruptorplus/sequence_barrier.hpp>
+#include <disruptorplus/ring_buffer.hpp>
+#include <disruptorplus/io_uring_queue.hpp>
+
+#include <sys/uio.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+
+namespace disruptorplus
+{
+    /// \brief
+    /// The default payload of an io_uring_sink: the raw bytes of the event.
+    template<typename T>
+    struct io_uring_whole_event
+    {
+        iovec operator()(const T& event) const
+        {
+            iovec iov;
+            iov.iov_base = const_cast<T*>(&event);
+            iov.iov_len = sizeof(T);
+            return iov;
+        }
+    };
+
+    /// \brief
+    /// A consumer that writes events to a file descriptor with io_uring,
+    /// straight from the ring buffer's slots.
+    ///
+    /// Each batch of published events is gathered into vectored writes that
+    /// point at the slot memory so nothing is copied in user space. The ring
+    /// buffer's storage is registered with the kernel up-front so that
+    /// batches that are contiguous in the ring can be submitted as fixed
+    /// buffer writes, which avoid pinning the pages on every write.
+    ///
+    /// The consumed() barrier is only published once the kernel has
+    /// completed the writes covering a batch, so add it as a claim barrier
+    /// to stop producers overwriting slots that are still being written.
+    ///
+    /// Only a single thread may drive the sink.
+    ///
+    /// \tparam T
+    /// The ring buffer element type.
+    ///
+    /// \tparam WaitStrategy
+    /// The wait strategy of the consumed() barrier.
+    ///
+    /// \tparam Payload
+    /// A function object with signature <tt>iovec(const T&)</tt> returning
+    /// the bytes to write for an event. The bytes must remain valid until the
+    /// event is consumed, typically by pointing into the event itself.
+    /// Events with an empty payload are skipped.
+    template<typename T, typename WaitStrategy, typename Payload = io_uring_whole_event<T>>
+    class io_uring_sink
+    {
+    public:
+
+        /// \brief
+        /// Construct a sink that writes events from \p buffer to \p fd.
+        ///
+        /// \param waitStrategy
+        /// The wait strategy used by the consumed() barrier.
+        ///
+        /// \param buffer
+        /// The ring buffer whose events are written. Must outlive the sink.
+        ///
+        /// \param fd
+        /// The file descriptor to write to. Not owned by the sink.
+        ///
+        /// \param offset
+        /// The file offset of the first event for regular files, in which
+        /// case writes are pipelined at explicit offsets. Pass -1 for pipes,
+        /// sockets or files opened with O_APPEND; only one write is then kept
+        /// in flight so that the output stays in sequence order.
+        ///
+        /// \param queueDepth
+        /// The maximum number of writes in flight.
+        ///
+        /// \throw std::system_error
+        /// If io_uring is not available.
+        io_uring_sink(
+            WaitStrategy& waitStrategy,
+            const ring_buffer<T>& buffer,
+            int fd,
+            int64_t offset = -1,
+            unsigned queueDepth = 64,
+            Payload payload = Payload())
+        : m_buffer(buffer)
+        , m_fd(fd)
+        , m_offset(offset)
+        , m_payload(payload)
+        , m_queue(queueDepth)
+        , m_fixed(false)
+        , m_regionBegin(reinterpret_cast<const char*>(&buffer[0]))
+        , m_regionEnd(m_regionBegin + buffer.size() * sizeof(T))
+        , m_iovecs(buffer.size())
+        , m_writes(queueDepth)
+        , m_writesHead(0)
+        , m_writesTail(0)
+        , m_queued(0)
+        , m_nextSequence(0)
+        , m_consumed(waitStrategy)
+        {
+            iovec region;
+            region.iov_base = const_cast<char*>(m_regionBegin);
+            region.iov_len = static_cast<size_t>(m_regionEnd - m_regionBegin);
+            m_fixed = m_queue.register_buffers(&region, 1) == 0;
+        }
+
+        /// \brief
+        /// Waits for any writes still in flight as they reference the
+        /// ring buffer's memory.
+        ///
+        /// Gives up once no completion can arrive, ie. no writes are in the
+        /// kernel and it will not accept those still in the submission
+        /// queue.
+        ~io_uring_sink()
+        {
+            try
+            {
+                while (!idle())
+                {
+                    if (m_queue.peek_cqe() == nullptr &&
+                        m_queued == m_queue.pending() &&
+                        (m_queued == 0 || m_queue.submit() == 0))
+                    {
+                        break;
+                    }
+                    reap(true);
+                }
+            }
+            catch (...)
+            {
+            }
+        }
+
+        /// \brief
+        /// The barrier to which the last sequence number whose write has
+        /// completed is published.
+        sequence_barrier<WaitStrategy>& consumed() { return m_consumed; }
+
+        /// \copydoc io_uring_sink::consumed()
+        const sequence_barrier<WaitStrategy>& consumed() const { return m_consumed; }
+
+        /// \brief
+        /// Whether the ring buffer was registered so contiguous batches are
+        /// written as fixed buffers.
+        ///
+        /// Registration fails if the ring buffer is larger than the
+        /// locked-memory limit, in which case all batches use writev.
+        bool uses_fixed_buffers() const { return m_fixed; }
+
+        /// \brief
+        /// The sequence number of the next event to be submitted.
+        sequence_t next_sequence() const { return m_nextSequence; }
+
+        /// \brief
+        /// Whether there are no writes in flight.
+        bool idle() const { return m_writesHead == m_writesTail; }
+
+        /// \brief
+        /// Submit writes for events from next_sequence() up to and including
+        /// \p last, as far as the queue depth allows.
+        ///
+        /// The events must already have been published to the caller.
+        ///
+        /// \return
+        /// The number of events submitted.
+        size_t submit(sequence_t last)
+        {
+            const size_t indexMask = m_buffer.size() - 1;
+            size_t submitted = 0;
+            while (difference(m_nextSequence, last) <= 0 &&
+                   m_writesTail - m_writesHead < m_writes.size() &&
+                   (m_offset >= 0 || idle()))
+            {
+                // Gather the longest run of slots that is contiguous in the
+                // ring, storing the iovecs alongside the slots they describe
+                // so that they stay put while the write is in flight.
+                const size_t slot = static_cast<size_t>(m_nextSequence) & indexMask;
+                const size_t count = std::min(
+                    static_cast<size_t>(difference(last, m_nextSequence) + 1),
+                    std::min(m_buffer.size() - slot, static_cast<size_t>(max_iovecs)));
+
+                iovec* const iovs = &m_iovecs[slot];
+                unsigned iovCount = 0;
+                size_t bytes = 0;
+                for (size_t i = 0; i < count; ++i)
+                {
+                    const iovec iov = m_payload(m_buffer[m_nextSequence + i]);
+                    if (iov.iov_len == 0)
+                    {
+                        continue;
+                    }
+                    if (iovCount > 0 &&
+                        static_cast<char*>(iovs[iovCount - 1].iov_base) + iovs[iovCount - 1].iov_len == iov.iov_base)
+                    {
+                        iovs[iovCount - 1].iov_len += iov.iov_len;
+                    }
+                    else
+                    {
+                        iovs[iovCount++] = iov;
+                    }
+                    bytes += iov.iov_len;
+                }
+
+                write& w = m_writes[m_writesTail % m_writes.size()];
+                w.m_last = static_cast<sequence_t>(m_nextSequence + count - 1);
+                w.m_iovs = iovs;
+                w.m_iovCount = iovCount;
+                w.m_remaining = bytes;
+                w.m_offset = m_offset;
+                w.m_done = bytes == 0;
+
+                if (!w.m_done)
+                {
+                    const char* base = static_cast<const char*>(iovs[0].iov_base);
+                    w.m_isFixed = m_fixed && iovCount == 1 &&
+                        base >= m_regionBegin && base + bytes <= m_regionEnd;
+                    if (!queue_write(m_writesTail % m_writes.size()))
+                    {
+                        break;
+                    }
+                    if (m_offset >= 0)
+                    {
+                        m_offset += static_cast<int64_t>(bytes);
+                    }
+                }
+
+                ++m_writesTail;
+                m_nextSequence = static_cast<sequence_t>(m_nextSequence + count);
+                submitted += count;
+            }
+
+            m_queue.submit();
+            publish_completed();
+            return submitted;
+        }
+
+        /// \brief
+        /// Process write completions and publish consumed() up to the last
+        /// event whose write, and all prior writes, have completed.
+        ///
+        /// Short writes are resubmitted for the remaining bytes.
+        ///
+        /// \param wait
+        /// Block until at least one completion arrives if none are ready
+        /// and writes are in flight.
+        ///
+        /// \return
+        /// Whether any completions were processed.
+        ///
+        /// \throw std::system_error
+        /// If a write failed. The failed write's events are still reported
+        /// as consumed by a later call so that producers are not blocked.
+        bool reap(bool wait)
+        {
+            if (idle())
+            {
+                return false;
+            }
+
+            // Only wait if a write is queued, otherwise no completion can
+            // arrive.
+            if (wait && m_queued > 0 && m_queue.peek_cqe() == nullptr)
+            {
+                m_queue.submit(1);
+            }
+
+            bool reaped = false;
+            while (const io_uring_cqe* cqe = m_queue.peek_cqe())
+            {
+                const size_t index = static_cast<size_t>(cqe->user_data);
+                const int result = cqe->res;
+                m_queue.cqe_seen();
+                --m_queued;
+                reaped = true;
+
+                write& w = m_writes[index];
+                if (result < 0)
+                {
+                    if (result != -EINTR && result != -EAGAIN)
+                    {
+                        w.m_done = true;
+                        throw std::system_error(-result, std::system_category(), "io_uring write");
+                    }
+                }
+                else if (result == 0)
+                {
+                    w.m_done = true;
+                    throw std::runtime_error("io_uring write made no progress");
+                }
+                else
+                {
+                    advance(w, static_cast<size_t>(result));
+                }
+
+                if (w.m_remaining == 0)
+                {
+                    w.m_done = true;
+                }
+                else if (!queue_write(index))
+                {
+                    w.m_done = true;
+                    throw std::runtime_error("io_uring submission queue overflow");
+                }
+            }
+
+            m_queue.submit();
+            publish_completed();
+            return reaped;
+        }
+
+        /// \brief
+        /// Write events as they are published to \p source until the event
+        /// with sequence number \p last has been consumed.
+        ///
+        /// New batches are submitted while earlier ones are still in flight
+        /// and the thread only blocks in the kernel once nothing new has
+        /// been published.
+        ///
+        /// \tparam Source
+        /// A type with <tt>wait_until_published(sequence_t)</tt> and
+        /// <tt>last_published()</tt> methods, eg. single_threaded_claim_strategy,
+        /// sequence_barrier or sequence_barrier_group. For
+        /// multi_threaded_claim_strategy call submit() and reap() from your
+        /// own loop instead.
+        template<typename Source>
+        void run(const Source& source, sequence_t last)
+        {
+            while (difference(m_consumed.last_published(), last) < 0)
+            {
+                size_t submitted = 0;
+                if (difference(m_nextSequence, last) <= 0)
+                {
+                    sequence_t available = idle() ?
+                        source.wait_until_published(m_nextSequence) :
+                        source.last_published();
+                    if (difference(available, last) > 0)
+                    {
+                        available = last;
+                    }
+                    if (difference(available, m_nextSequence) >= 0)
+                    {
+                        submitted = submit(available);
+                    }
+                }
+                reap(submitted == 0);
+            }
+        }
+
+    private:
+
+        // Writes of more iovecs than this are rejected by the kernel.
+        enum { max_iovecs = 1024 };
+
+        struct write
+        {
+            sequence_t m_last;
+            iovec* m_iovs;
+            unsigned m_iovCount;
+            size_t m_remaining;
+            int64_t m_offset;
+            bool m_isFixed;
+            bool m_done;
+        };
+
+        bool queue_write(size_t index)
+        {
+            io_uring_sqe* sqe = m_queue.get_sqe();
+            if (sqe == nullptr)
+            {
+                return false;
+            }
+
+            const write& w = m_writes[index];
+            sqe->fd = m_fd;
+            sqe->off = static_cast<uint64_t>(w.m_offset);
+            sqe->user_data = index;
+            if (w.m_isFixed)
+            {
+                sqe->opcode = IORING_OP_WRITE_FIXED;
+                sqe->addr = reinterpret_cast<uint64_t>(w.m_iovs[0].iov_base);
+                sqe->len = static_cast<unsigned>(w.m_iovs[0].iov_len);
+                sqe->buf_index = 0;
+            }
+            else
+            {
+                sqe->opcode = IORING_OP_WRITEV;
+                sqe->addr = reinterpret_cast<uint64_t>(w.m_iovs);
+                sqe->len = w.m_iovCount;
+            }
+            ++m_queued;
+            return true;
+        }
+
+        // Trim the bytes already written from the front of a write.
+        void advance(write& w, size_t bytes)
+        {
+            w.m_remaining -= bytes;
+            if (w.m_offset >= 0)
+            {
+                w.m_offset += static_cast<int64_t>(bytes);
+            }
+            while (bytes > 0)
+            {
+                const size_t n = std::min(bytes, w.m_iovs->iov_len);
+                w.m_iovs->iov_base = static_cast<char*>(w.m_iovs->iov_base) + n;
+                w.m_iovs->iov_len -= n;
+                bytes -= n;
+                if (w.m_iovs->iov_len == 0 && w.m_iovCount > 1)
+                {
+                    ++w.m_iovs;
+                    --w.m_iovCount;
+                }
+            }
+        }
+
+        // Writes complete out of order so only publish up to the first
+        // write that is still in flight.
+        void publish_completed()
+        {
+            bool published = false;
+            sequence_t last = 0;
+            while (!idle() && m_writes[m_writesHead % m_writes.size()].m_done)
+            {
+                last = m_writes[m_writesHead % m_writes.size()].m_last;
+                ++m_writesHead;
+                published = true;
+            }
+            if (published)
+            {
+                m_consumed.publish(last);
+            }
+        }
+
+        // Disable copy-construction
+        io_uring_sink(const io_uring_sink&);
+
+        const ring_buffer<T>& m_buffer;
+        const int m_fd;
+        int64_t m_offset;
+        Payload m_payload;
+        io_uring_queue m_queue;
+        bool m_fixed;
+        const char* const m_regionBegin;
+        const char* const m_regionEnd;
+        std::vector<iovec> m_iovecs;
+        std::vector<write> m_writes;
+        size_t m_writesHead;
+        size_t m_writesTail;
+
+        // Writes queued to the kernel whose completions have not been
+        // reaped, including those still pending in the submission queue.
+        unsigned m_queued;
+
+        sequence_t m_nextSequence;
+        sequence_barrier<WaitStrategy> m_consumed;
+
+    };
+}
+
+#endif
@@ -0,0 +1,388 @@
+#ifndef DISRUPTORPLUS_IO_URING_SOURCE_HPP_INCLUDED
+#define DISRUPTORPLUS_IO_URING_SOURCE_HPP_INCLUDED
+
+#include <disruptorplus/sequence.hpp>
+#include <disruptorplus/sequence_range.hpp>
+#include <disruptorplus/ring_buffer.hpp>
+#include <disruptorplus/io_message.hpp>
+#include <disruptorplus/io_uring_queue.hpp>
+
+#include <sys/uio.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+
+namespace disruptorplus
+{
+    /// \brief
+    /// A producer that reads from a file descriptor with io_uring directly
+    /// into claimed ring buffer slots.
+    ///
+    /// Each read targets the \c m_data of one claimed slot. The ring
+    /// buffer's storage is registered with the kernel up-front so the reads
+    /// are submitted as fixed buffer reads. Reads complete out of order but
+    /// slots are published in sequence order, each as soon as it and all
+    /// earlier slots are filled. Slots whose read hit end-of-file are
+    /// published as tombstones.
+    ///
+    /// Only a single thread may drive the source.
+    ///
+    /// \tparam T
+    /// The ring buffer element type. Must have a \c uint32_t \c m_size
+    /// member and a \c m_data character array, see io_message.
+    ///
+    /// \tparam ClaimStrategy
+    /// The claim strategy the source publishes to.
+    template<typename T, typename ClaimStrategy>
+    class io_uring_source
+    {
+    public:
+
+        /// \brief
+        /// Construct a source that reads \p fd into slots of \p buffer.
+        ///
+        /// \param offset
+        /// The file offset to start reading a regular file from, in which
+        /// case up to \p queueDepth reads of consecutive chunks are kept in
+        /// flight. Pass -1 for pipes and sockets; only one read is then kept
+        /// in flight so that the data stays in order.
+        ///
+        /// \param queueDepth
+        /// The maximum number of reads in flight. Must be less than the
+        /// ring buffer size.
+        ///
+        /// \throw std::system_error
+        /// If io_uring is not available.
+        io_uring_source(
+            ClaimStrategy& claimStrategy,
+            ring_buffer<T>& buffer,
+            int fd,
+            int64_t offset = -1,
+            unsigned queueDepth = 64)
+        : m_claimStrategy(claimStrategy)
+        , m_buffer(buffer)
+        , m_fd(fd)
+        , m_offset(offset)
+        , m_queue(queueDepth)
+        , m_fixed(false)
+        , m_reads(queueDepth)
+        , m_readsHead(0)
+        , m_readsTail(0)
+        , m_queued(0)
+        , m_eof(false)
+        {
+            iovec region;
+            region.iov_base = &buffer[0];
+            region.iov_len = buffer.size() * sizeof(T);
+            m_fixed = m_queue.register_buffers(&region, 1) == 0;
+        }
+
+        /// \brief
+        /// Waits for any reads still in flight as they reference the ring
+        /// buffer's memory and publishes their slots.
+        ///
+        /// Gives up once no completion can arrive, ie. no reads are in the
+        /// kernel and it will not accept those still in the submission
+        /// queue. The slots of reads that did not complete are published
+        /// as tombstones so that consumers are not left waiting for them.
+        ~io_uring_source()
+        {
+            while (!idle())
+            {
+                try
+                {
+                    if (m_queue.peek_cqe() == nullptr &&
+                        m_queued == m_queue.pending() &&
+                        (m_queued == 0 || m_queue.submit() == 0))
+                    {
+                        break;
+                    }
+                }
+                catch (...)
+                {
+                    break;
+                }
+
+                // A failed read is published before reap() reports it, so
+                // keep going unless waiting itself failed.
+                const unsigned queued = m_queued;
+                try
+                {
+                    reap(true);
+                }
+                catch (...)
+                {
+                    if (m_queued == queued)
+                    {
+                        break;
+                    }
+                }
+            }
+            abandon();
+        }
+
+        /// \brief
+        /// Whether the ring buffer was registered so reads use fixed buffers.
+        bool uses_fixed_buffers() const { return m_fixed; }
+
+        /// \brief
+        /// Whether a read has reported end-of-file. No further reads are
+        /// submitted once it has.
+        bool eof() const { return m_eof; }
+
+        /// \brief
+        /// Whether there are no reads in flight.
+        bool idle() const { return m_readsHead == m_readsTail; }
+
+        /// \brief
+        /// Claim slots and submit reads into them until the queue depth is
+        /// reached.
+        ///
+        /// Blocks claiming a slot only if no reads are in flight.
+        ///
+        /// \return
+        /// The number of reads submitted.
+        size_t submit()
+        {
+            size_t submitted = 0;
+            while (!m_eof &&
+                   m_readsTail - m_readsHead < m_reads.size() &&
+                   (m_offset >= 0 || idle()))
+            {
+                sequence_range claimed;
+                if (idle())
+                {
+                    claimed = sequence_range(m_claimStrategy.claim_one(), 1);
+                }
+                else if (!m_claimStrategy.try_claim(1, claimed))
+                {
+                    break;
+                }
+
+                const size_t index = m_readsTail % m_reads.size();
+                read& r = m_reads[index];
+                r.m_sequence = claimed.first();
+                r.m_offset = m_offset;
+                r.m_done = false;
+                ++m_readsTail;
+                if (!queue_read(index))
+                {
+                    fail(index);
+                    publish_completed();
+                    throw std::runtime_error("io_uring submission queue overflow");
+                }
+
+                ++submitted;
+                if (m_offset >= 0)
+                {
+                    m_offset += static_cast<int64_t>(sizeof(m_buffer[0].m_data));
+                }
+            }
+
+            m_queue.submit();
+            return submitted;
+        }
+
+        /// \brief
+        /// Process read completions and publish the slots that are filled,
+        /// in sequence order.
+        ///
+        /// \param wait
+        /// Block until at least one completion arrives if none are ready
+        /// and reads are in flight.
+        ///
+        /// \return
+        /// The number of slots published, including tombstones.
+        ///
+        /// \throw std::system_error
+        /// If a read failed. The slots of failed reads are published as
+        /// tombstones before the error is reported.
+        size_t reap(bool wait)
+        {
+            if (idle())
+            {
+                return 0;
+            }
+
+            // Only wait if a read is queued, otherwise no completion can
+            // arrive.
+            if (wait && m_queued > 0 && m_queue.peek_cqe() == nullptr)
+            {
+                m_queue.submit(1);
+            }
+
+            int error = 0;
+            bool overflow = false;
+            while (const io_uring_cqe* cqe = m_queue.peek_cqe())
+            {
+                const size_t index = static_cast<size_t>(cqe->user_data);
+                const int result = cqe->res;
+                m_queue.cqe_seen();
+                --m_queued;
+
+                read& r = m_reads[index];
+                T& message = m_buffer[r.m_sequence];
+                if (result < 0)
+                {
+                    if (result != -EINTR && result != -EAGAIN)
+                    {
+                        error = -result;
+                        fail(index);
+                    }
+                    else if (!queue_read(index))
+                    {
+                        overflow = true;
+                        fail(index);
+                    }
+                    continue;
+                }
+
+                if (result == 0)
+                {
+                    message.m_size = io_message_tombstone;
+                    m_eof = true;
+                }
+                else
+                {
+                    message.m_size = static_cast<uint32_t>(result);
+                }
+                r.m_done = true;
+            }
+
+            const size_t published = publish_completed();
+
+            m_queue.submit();
+
+            if (error != 0)
+            {
+                throw std::system_error(error, std::system_category(), "io_uring read");
+            }
+            if (overflow)
+            {
+                throw std::runtime_error("io_uring submission queue overflow");
+            }
+            return published;
+        }
+
+
+        /// \brief
+        /// Read until end-of-file, publishing slots as they are filled.
+        ///
+        /// \return
+        /// The number of slots published, including tombstones.
+        uint64_t run()
+        {
+            uint64_t published = 0;
+            while (!m_eof || !idle())
+            {
+                submit();
+                published += reap(true);
+            }
+            return published;
+        }
+
+    private:
+
+        struct read
+        {
+            sequence_t m_sequence;
+            int64_t m_offset;
+            bool m_done;
+        };
+
+        // At most queueDepth reads are in flight so this only fails if the
+        // kernel stopped accepting submissions.
+        bool queue_read(size_t index)
+        {
+            io_uring_sqe* sqe = m_queue.get_sqe();
+            if (sqe == nullptr)
+            {
+                return false;
+            }
+            const read& r = m_reads[index];
+            T& message = m_buffer[r.m_sequence];
+            sqe->opcode = m_fixed ? IORING_OP_READ_FIXED : IORING_OP_READ;
+            sqe->fd = m_fd;
+            sqe->off = static_cast<uint64_t>(r.m_offset);
+            sqe->addr = reinterpret_cast<uint64_t>(message.m_data);
+            sqe->len = static_cast<unsigned>(sizeof(message.m_data));
+            sqe->buf_index = 0;
+            sqe->user_data = index;
+            ++m_queued;
+            return true;
+        }
+
+        // Complete a read whose slot will not be filled as a tombstone.
+        void fail(size_t index)
+        {
+            read& r = m_reads[index];
+            m_buffer[r.m_sequence].m_size = io_message_tombstone;
+            r.m_done = true;
+        }
+
+        // Fail the reads that will not complete and publish their slots.
+        void abandon()
+        {
+            for (size_t i = m_readsHead; i != m_readsTail; ++i)
+            {
+                if (!m_reads[i % m_reads.size()].m_done)
+                {
+                    fail(i % m_reads.size());
+                }
+            }
+            publish_completed();
+        }
+
+        // Publish the completed reads at the front, coalescing runs of
+        // consecutive sequence numbers. Other producers may have claimed
+        // the sequence numbers in between.
+        size_t publish_completed()
+        {
+            size_t published = 0;
+            sequence_range run;
+            while (!idle() && m_reads[m_readsHead % m_reads.size()].m_done)
+            {
+                const sequence_t sequence = m_reads[m_readsHead % m_reads.size()].m_sequence;
+                if (run.size() > 0 && sequence != run.end())
+                {
+                    m_claimStrategy.publish(run);
+                    published += run.size();
+                    run = sequence_range();
+                }
+                run = sequence_range(run.size() > 0 ? run.first() : sequence, run.size() + 1);
+                ++m_readsHead;
+            }
+            if (run.size() > 0)
+            {
+                m_claimStrategy.publish(run);
+                published += run.size();
+            }
+            return published;
+        }
+
+        // Disable copy-construction
+        io_uring_source(const io_uring_source&);
+
+        ClaimStrategy& m_claimStrategy;
+        ring_buffer<T>& m_buffer;
+        const int m_fd;
+        int64_t m_offset;
+        io_uring_queue m_queue;
+        bool m_fixed;
+        std::vector<read> m_reads;
+        size_t m_readsHead;
+        size_t m_readsTail;
+
+        // Reads queued to the kernel whose completions have not been reaped,
+        // including those still pending in the submission queue.
+        unsigned m_queued;
+
+        bool m_eof;
+
+    };
+}
+
+#endif
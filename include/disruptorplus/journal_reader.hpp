@@ -0,0 +1,207 @@
+#ifndef DISRUPTORPLUS_JOURNAL_READER_HPP_INCLUDED
+#define DISRUPTORPLUS_JOURNAL_READER_HPP_INCLUDED
+
+#include <disruptorplus/sequence.hpp>
+#include <disruptorplus/sequence_range.hpp>
+#include <disruptorplus/ring_buffer.hpp>
+#include <disruptorplus/journal_segment.hpp>
+
+#include <dirent.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+namespace disruptorplus
+{
+    /// \brief
+    /// Reads a journal written by journal_writer and replays it into a
+    /// ring buffer.
+    ///
+    /// Only the committed records of a contiguous run of segments, starting
+    /// from the segment with the lowest sequence number, are replayed.
+    /// Anything after the first gap is ignored.
+    ///
+    /// \tparam T
+    /// The journaled event type. Must match the type that was written.
+    template<typename T>
+    class journal_reader
+    {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "journal events must be trivially copyable");
+
+    public:
+
+        /// \brief
+        /// Open all of the segment files in \p directory.
+        ///
+        /// \throw std::system_error
+        /// If the directory or a segment could not be opened.
+        ///
+        /// \throw std::runtime_error
+        /// If a segment has an unexpected format or record size.
+        explicit journal_reader(const std::string& directory)
+        : m_beginSequence(0)
+        , m_endSequence(0)
+        {
+            std::vector<sequence_t> firstSequences;
+            DIR* dir = ::opendir(directory.c_str());
+            if (dir == nullptr)
+            {
+                throw std::system_error(errno, std::system_category(), "open journal directory");
+            }
+            while (const dirent* entry = ::readdir(dir))
+            {
+                sequence_t first;
+                if (journal_segment::parse_file_name(entry->d_name, first))
+                {
+                    firstSequences.push_back(first);
+                }
+            }
+            ::closedir(dir);
+
+            std::sort(firstSequences.begin(), firstSequences.end());
+
+            for (sequence_t first : firstSequences)
+            {
+                std::unique_ptr<journal_segment> segment(
+                    new journal_segment(journal_segment::file_name(directory, first)));
+                if (segment->record_size() != sizeof(T))
+                {
+                    throw std::runtime_error("journal segment record size does not match the event type");
+                }
+
+                if (m_segments.empty())
+                {
+                    m_beginSequence = segment->begin_sequence();
+                    m_endSequence = m_beginSequence;
+                }
+
+                // Stop at the first segment that does not continue on from
+                // the committed records of the previous one.
+                if (segment->begin_sequence() > m_endSequence ||
+                    segment->committed_end() <= m_endSequence)
+                {
+                    break;
+                }
+                m_endSequence = segment->committed_end();
+                m_segments.push_back(std::move(segment));
+
+                if (m_endSequence != m_segments.back()->first_sequence() + m_segments.back()->capacity())
+                {
+                    // Partially committed, anything after it is not contiguous.
+                    break;
+                }
+            }
+        }
+
+        /// \brief
+        /// The sequence number of the first record in the journal.
+        sequence_t begin_sequence() const { return m_beginSequence; }
+
+        /// \brief
+        /// One past the sequence number of the last committed record.
+        ///
+        /// A journal_writer resuming after a replay should start from here.
+        sequence_t end_sequence() const { return m_endSequence; }
+
+        /// \brief
+        /// Pointer to the committed record for \p sequence.
+        ///
+        /// \pre
+        /// <tt>begin_sequence() <= sequence < end_sequence()</tt>
+        const T* record(sequence_t sequence) const
+        {
+            const journal_segment& segment = *find_segment(sequence);
+            return reinterpret_cast<const T*>(
+                segment.record(static_cast<size_t>(sequence - segment.first_sequence())));
+        }
+
+        /// \brief
+        /// Publish journaled events into a ring buffer.
+        ///
+        /// Claims slots from \p claimStrategy in batches of up to
+        /// \p batchSize events, copies the records straight from the
+        /// mapped segments into the claimed slots and publishes them.
+        ///
+        /// \param from
+        /// The first journal sequence number to replay.
+        ///
+        /// \param to
+        /// One past the last journal sequence number to replay. Clamped to
+        /// end_sequence().
+        ///
+        /// \return
+        /// The number of events published.
+        template<typename ClaimStrategy>
+        uint64_t replay(
+            ClaimStrategy& claimStrategy,
+            ring_buffer<T>& buffer,
+            sequence_t from,
+            sequence_t to,
+            size_t batchSize = 1024)
+        {
+            from = std::max(from, m_beginSequence);
+            to = std::min(to, m_endSequence);
+
+            const size_t indexMask = buffer.size() - 1;
+            uint64_t replayed = 0;
+            while (from < to)
+            {
+                const journal_segment& segment = *find_segment(from);
+                const sequence_t segmentEnd = std::min(
+                    to, static_cast<sequence_t>(segment.first_sequence() + segment.capacity()));
+                const size_t count = static_cast<size_t>(std::min<sequence_t>(segmentEnd - from, batchSize));
+
+                const sequence_range range = claimStrategy.claim(count);
+                const T* source = reinterpret_cast<const T*>(
+                    segment.record(static_cast<size_t>(from - segment.first_sequence())));
+
+                // Split the copy where the claimed range wraps around the ring.
+                const size_t slot = static_cast<size_t>(range.first()) & indexMask;
+                const size_t firstSpan = std::min(range.size(), buffer.size() - slot);
+                std::memcpy(&buffer[range.first()], source, firstSpan * sizeof(T));
+                if (firstSpan < range.size())
+                {
+                    std::memcpy(&buffer[range[firstSpan]], source + firstSpan, (range.size() - firstSpan) * sizeof(T));
+                }
+
+                claimStrategy.publish(range);
+                from = static_cast<sequence_t>(from + range.size());
+                replayed += range.size();
+            }
+            return replayed;
+        }
+
+    private:
+
+        const journal_segment* find_segment(sequence_t sequence) const
+        {
+            // Segments are sorted and contiguous so the first whose end is
+            // after the sequence holds it.
+            auto it = std::upper_bound(
+                m_segments.begin(), m_segments.end(), sequence,
+                [](sequence_t s, const std::unique_ptr<journal_segment>& segment)
+                {
+                    return s < segment->first_sequence() + segment->capacity();
+                });
+            return it->get();
+        }
+
+        // Disable copy-construction
+        journal_reader(const journal_reader&);
+
+        std::vector<std::unique_ptr<journal_segment>> m_segments;
+        sequence_t m_beginSequence;
+        sequence_t m_endSequence;
+
+    };
+}
+
+#endif
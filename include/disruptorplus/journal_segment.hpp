@@ -0,0 +1,385 @@
+#ifndef DISRUPTORPLUS_JOURNAL_SEGMENT_HPP_INCLUDED
+#define DISRUPTORPLUS_JOURNAL_SEGMENT_HPP_INCLUDED
+
+#include <disruptorplus/sequence.hpp>
+
+#if defined(_WIN32)
+# error "journal segments are currently only implemented for POSIX platforms"
+#endif
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+namespace disruptorplus
+{
+    /// \brief
+    /// How a journal makes appended records durable.
+    enum class journal_sync
+    {
+        /// Leave writing back dirty pages to the operating system.
+        /// Records survive a process crash but not a machine crash.
+        none,
+
+        /// Schedule write-back of each batch without waiting for it.
+        async,
+
+        /// Wait for each batch to reach stable storage before it is
+        /// published as committed.
+        sync
+    };
+
+    /// \brief
+    /// A memory-mapped journal segment file holding a fixed number of
+    /// fixed-size records for consecutive sequence numbers.
+    ///
+    /// The file starts with a one page header followed by the records.
+    /// The header records how many records have been committed. It is
+    /// only updated once the records themselves have been flushed so a
+    /// reader never sees a committed record that was not written.
+    class journal_segment
+    {
+    public:
+
+        /// \brief
+        /// Create or reopen a segment file for writing.
+        ///
+        /// \param path
+        /// Path of the segment file. Use file_name() to build it.
+        ///
+        /// \param recordSize
+        /// Size in bytes of each record.
+        ///
+        /// \param firstSequence
+        /// The sequence number of the first record in the segment.
+        ///
+        /// \param capacity
+        /// The number of records the segment holds.
+        ///
+        /// \param beginSequence
+        /// The sequence number of the first record that will be written if
+        /// the file is newly created. Records before it are never committed.
+        ///
+        /// \throw std::system_error
+        /// If the file could not be created, sized or mapped.
+        ///
+        /// \throw std::runtime_error
+        /// If the file is an existing segment with a different record size,
+        /// first sequence number or capacity, or an invalid header.
+        journal_segment(
+            const std::string& path,
+            size_t recordSize,
+            sequence_t firstSequence,
+            size_t capacity,
+            sequence_t beginSequence)
+        : m_fd(-1)
+        , m_data(nullptr)
+        , m_size(0)
+        , m_pageSize(page_size())
+        {
+            m_fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+            if (m_fd < 0)
+            {
+                throw std::system_error(errno, std::system_category(), "open journal segment");
+            }
+
+            // Check an existing segment's header before sizing the file so
+            // that a mismatch neither truncates nor reinterprets its records.
+            journal_segment_header existing;
+            const ssize_t headerSize = ::pread(m_fd, &existing, sizeof(existing), 0);
+            if (headerSize < 0)
+            {
+                const int error = errno;
+                close();
+                throw std::system_error(error, std::system_category(), "read journal segment");
+            }
+            const bool reopened =
+                static_cast<size_t>(headerSize) == sizeof(existing) && existing.m_magic == magic;
+            if (reopened &&
+                (existing.m_recordSize != recordSize ||
+                 existing.m_firstSequence != firstSequence ||
+                 existing.m_capacity != capacity ||
+                 existing.m_dataOffset != m_pageSize ||
+                 existing.m_beginSequence < existing.m_firstSequence ||
+                 existing.m_committedEnd < existing.m_beginSequence ||
+                 existing.m_committedEnd > existing.m_firstSequence + existing.m_capacity))
+            {
+                close();
+                throw std::runtime_error("journal segment does not match the requested layout: " + path);
+            }
+
+            m_size = m_pageSize + recordSize * capacity;
+
+            // Allocate the blocks up-front so that running out of disk space
+            // is reported here rather than as SIGBUS when writing the mapping.
+            int result = ::posix_fallocate(m_fd, 0, static_cast<off_t>(m_size));
+            if (result == EINVAL || result == EOPNOTSUPP)
+            {
+                result = ::ftruncate(m_fd, static_cast<off_t>(m_size)) == 0 ? 0 : errno;
+            }
+            if (result != 0)
+            {
+                close();
+                throw std::system_error(result, std::system_category(), "allocate journal segment");
+            }
+
+            map(PROT_READ | PROT_WRITE);
+
+            if (!reopened)
+            {
+                journal_segment_header& h = header();
+                h.m_recordSize = recordSize;
+                h.m_firstSequence = firstSequence;
+                h.m_capacity = capacity;
+                h.m_dataOffset = m_pageSize;
+                h.m_beginSequence = beginSequence;
+                h.m_committedEnd = beginSequence;
+                h.m_magic = magic;
+            }
+        }
+
+        /// \brief
+        /// Open an existing segment file read-only.
+        ///
+        /// \throw std::system_error
+        /// If the file could not be opened or mapped.
+        ///
+        /// \throw std::runtime_error
+        /// If the file is not a journal segment.
+        explicit journal_segment(const std::string& path)
+        : m_fd(-1)
+        , m_data(nullptr)
+        , m_size(0)
+        , m_pageSize(page_size())
+        {
+            m_fd = ::open(path.c_str(), O_RDONLY);
+            if (m_fd < 0)
+            {
+                throw std::system_error(errno, std::system_category(), "open journal segment");
+            }
+
+            struct stat info;
+            if (::fstat(m_fd, &info) != 0)
+            {
+                const int error = errno;
+                close();
+                throw std::system_error(error, std::system_category(), "stat journal segment");
+            }
+            m_size = static_cast<size_t>(info.st_size);
+
+            if (m_size < sizeof(journal_segment_header))
+            {
+                close();
+                throw std::runtime_error("journal segment is truncated: " + path);
+            }
+
+            map(PROT_READ);
+
+            const journal_segment_header& h = header();
+            if (h.m_magic != magic ||
+                h.m_dataOffset < sizeof(journal_segment_header) ||
+                h.m_dataOffset + h.m_recordSize * h.m_capacity > m_size ||
+                h.m_beginSequence < h.m_firstSequence ||
+                h.m_committedEnd < h.m_beginSequence ||
+                h.m_committedEnd > h.m_firstSequence + h.m_capacity)
+            {
+                close();
+                throw std::runtime_error("journal segment has an unexpected format: " + path);
+            }
+            m_pageSize = static_cast<size_t>(h.m_dataOffset);
+        }
+
+        ~journal_segment()
+        {
+            close();
+        }
+
+        /// \brief
+        /// Build the path of the segment starting at \p firstSequence.
+        ///
+        /// Names are zero-padded so they sort in sequence order.
+        static std::string file_name(const std::string& directory, sequence_t firstSequence)
+        {
+            char name[32];
+            std::snprintf(name, sizeof(name), "%020llu.journal",
+                          static_cast<unsigned long long>(firstSequence));
+            return directory + "/" + name;
+        }
+
+        /// \brief
+        /// Parse the first sequence number out of a segment file name.
+        ///
+        /// \return
+        /// \c true if \p name has the form produced by file_name().
+        static bool parse_file_name(const std::string& name, sequence_t& firstSequence)
+        {
+            const std::string suffix = ".journal";
+            if (name.size() != 20 + suffix.size() ||
+                name.compare(20, suffix.size(), suffix) != 0)
+            {
+                return false;
+            }
+            sequence_t value = 0;
+            for (size_t i = 0; i < 20; ++i)
+            {
+                if (name[i] < '0' || name[i] > '9')
+                {
+                    return false;
+                }
+                value = value * 10 + static_cast<sequence_t>(name[i] - '0');
+            }
+            firstSequence = value;
+            return true;
+        }
+
+        size_t record_size() const { return static_cast<size_t>(header().m_recordSize); }
+
+        sequence_t first_sequence() const { return static_cast<sequence_t>(header().m_firstSequence); }
+
+        /// \brief
+        /// The sequence number of the first record ever written to the
+        /// segment. Later than first_sequence() if the writer started
+        /// part-way through the segment.
+        sequence_t begin_sequence() const { return static_cast<sequence_t>(header().m_beginSequence); }
+
+        size_t capacity() const { return static_cast<size_t>(header().m_capacity); }
+
+        /// \brief
+        /// One past the sequence number of the last committed record.
+        sequence_t committed_end() const
+        {
+            return static_cast<sequence_t>(header().m_committedEnd);
+        }
+
+        /// \brief
+        /// Pointer to the record at \p index within this segment.
+        unsigned char* record(size_t index)
+        {
+            return m_data + m_pageSize + index * record_size();
+        }
+
+        /// \copydoc journal_segment::record(size_t)
+        const unsigned char* record(size_t index) const
+        {
+            return m_data + m_pageSize + index * record_size();
+        }
+
+        /// \brief
+        /// Flush records <tt>[begin, end)</tt> and then mark every record
+        /// before \p committedEnd as committed.
+        ///
+        /// \throw std::system_error
+        /// If flushing failed.
+        void commit(size_t begin, size_t end, sequence_t committedEnd, journal_sync sync)
+        {
+            if (sync != journal_sync::none && begin != end)
+            {
+                flush(m_pageSize + begin * record_size(), (end - begin) * record_size(), sync);
+            }
+            header().m_committedEnd = committedEnd;
+            if (sync != journal_sync::none)
+            {
+                flush(0, sizeof(journal_segment_header), sync);
+            }
+        }
+
+    private:
+
+        struct journal_segment_header
+        {
+            uint64_t m_magic;
+            uint64_t m_recordSize;
+            uint64_t m_firstSequence;
+            uint64_t m_capacity;
+            uint64_t m_dataOffset;
+            uint64_t m_beginSequence;
+            uint64_t m_committedEnd;
+        };
+
+        // "DPJRNL01"
+        static const uint64_t magic = 0x31304C4E524A5044ull;
+
+        static size_t page_size()
+        {
+            const long size = ::sysconf(_SC_PAGESIZE);
+            return size > 0 ? static_cast<size_t>(size) : 4096;
+        }
+
+        journal_segment_header& header()
+        {
+            return *reinterpret_cast<journal_segment_header*>(m_data);
+        }
+
+        const journal_segment_header& header() const
+        {
+            return *reinterpret_cast<const journal_segment_header*>(m_data);
+        }
+
+        void map(int protection)
+        {
+            int flags = MAP_SHARED;
+#if defined(MAP_POPULATE)
+            // Fault the pages in now rather than one at a time on first access.
+            flags |= MAP_POPULATE;
+#endif
+            void* data = ::mmap(nullptr, m_size, protection, flags, m_fd, 0);
+            if (data == MAP_FAILED)
+            {
+                const int error = errno;
+                close();
+                throw std::system_error(error, std::system_category(), "map journal segment");
+            }
+            m_data = static_cast<unsigned char*>(data);
+            if (protection == PROT_READ)
+            {
+                ::madvise(m_data, m_size, MADV_SEQUENTIAL);
+            }
+        }
+
+        void flush(size_t offset, size_t size, journal_sync sync)
+        {
+            // msync() requires a page-aligned start address.
+            const size_t alignedOffset = offset - offset % m_pageSize;
+            const int flags = sync == journal_sync::sync ? MS_SYNC : MS_ASYNC;
+            if (::msync(m_data + alignedOffset, offset + size - alignedOffset, flags) != 0)
+            {
+                throw std::system_error(errno, std::system_category(), "flush journal segment");
+            }
+        }
+
+        void close()
+        {
+            if (m_data != nullptr)
+            {
+                ::munmap(m_data, m_size);
+                m_data = nullptr;
+            }
+            if (m_fd >= 0)
+            {
+                ::close(m_fd);
+                m_fd = -1;
+            }
+        }
+
+        // Disable copy-construction
+        journal_segment(const journal_segment&);
+
+        int m_fd;
+        unsigned char* m_data;
+        size_t m_size;
+        size_t m_pageSize;
+
+    };
+}
+
+#endif
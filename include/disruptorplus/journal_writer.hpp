@@ -0,0 +1,203 @@
+#ifndef DISRUPTORPLUS_JOURNAL_WRITER_HPP_INCLUDED
+#define DISRUPTORPLUS_JOURNAL_WRITER_HPP_INCLUDED
+
+#include <disruptorplus/sequence.hpp>
+#include <disruptorplus/sequence_barrier.hpp>
+#include <disruptorplus/ring_buffer.hpp>
+#include <disruptorplus/journal_segment.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+namespace disruptorplus
+{
+    /// \brief
+    /// A consumer that appends events from a ring buffer to a journal of
+    /// memory-mapped segment files.
+    ///
+    /// Each batch of published events is copied into the journal with one
+    /// copy per contiguous span of slots and flushed once per batch. The
+    /// committed() barrier is then published so that downstream consumers
+    /// can gate on events having been made durable.
+    ///
+    /// Add committed(), or a barrier of a consumer that waits on it, as a
+    /// claim barrier so that slots are not reused before they are journaled.
+    ///
+    /// Use journal_reader to replay the journal.
+    ///
+    /// \tparam T
+    /// The ring buffer element type. Must be trivially copyable as events
+    /// are written to the journal as raw bytes.
+    ///
+    /// \tparam WaitStrategy
+    /// The wait strategy of the committed() barrier.
+    template<typename T, typename WaitStrategy>
+    class journal_writer
+    {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "journal events must be trivially copyable");
+
+    public:
+
+        /// \brief
+        /// Construct a journal writer that writes segments into \p directory.
+        ///
+        /// \param waitStrategy
+        /// The wait strategy used by the committed() barrier.
+        ///
+        /// \param directory
+        /// An existing directory to write the segment files to.
+        ///
+        /// \param recordsPerSegment
+        /// The number of events in each segment file.
+        ///
+        /// \param sync
+        /// How each batch is flushed before being published as committed.
+        ///
+        /// \param firstSequence
+        /// The sequence number of the first event to journal. When resuming
+        /// after a replay set this to journal_reader::end_sequence() to
+        /// continue appending to the same journal.
+        journal_writer(
+            WaitStrategy& waitStrategy,
+            const std::string& directory,
+            size_t recordsPerSegment,
+            journal_sync sync = journal_sync::sync,
+            sequence_t firstSequence = 0)
+        : m_directory(directory)
+        , m_recordsPerSegment(recordsPerSegment)
+        , m_sync(sync)
+        , m_nextSequence(firstSequence)
+        , m_dirtyBegin(0)
+        , m_dirtyEnd(0)
+        , m_committed(waitStrategy)
+        {
+            m_committed.publish(static_cast<sequence_t>(firstSequence - 1));
+        }
+
+        /// \brief
+        /// The barrier to which the last durably journaled sequence number
+        /// is published.
+        sequence_barrier<WaitStrategy>& committed() { return m_committed; }
+
+        /// \copydoc journal_writer::committed()
+        const sequence_barrier<WaitStrategy>& committed() const { return m_committed; }
+
+        /// \brief
+        /// The sequence number of the next event to be journaled.
+        sequence_t next_sequence() const { return m_nextSequence; }
+
+        /// \brief
+        /// Append all events from next_sequence() up to and including
+        /// \p last, flush them and publish \p last to committed().
+        ///
+        /// The events must already have been published to the caller.
+        ///
+        /// \throw std::system_error
+        /// If a segment could not be created or flushed.
+        void append(const ring_buffer<T>& buffer, sequence_t last)
+        {
+            const size_t indexMask = buffer.size() - 1;
+            while (difference(m_nextSequence, last) <= 0)
+            {
+                if (!m_segment)
+                {
+                    open_segment(m_nextSequence);
+                }
+
+                // Copy the longest span that is contiguous both in the ring
+                // buffer and in the segment.
+                const size_t index = static_cast<size_t>(m_nextSequence - m_segment->first_sequence());
+                const size_t slot = static_cast<size_t>(m_nextSequence) & indexMask;
+                const size_t count = std::min(
+                    static_cast<size_t>(difference(last, m_nextSequence) + 1),
+                    std::min(m_segment->capacity() - index, buffer.size() - slot));
+
+                std::memcpy(m_segment->record(index), &buffer[m_nextSequence], count * sizeof(T));
+
+                if (m_dirtyBegin == m_dirtyEnd)
+                {
+                    m_dirtyBegin = index;
+                }
+                m_dirtyEnd = index + count;
+                m_nextSequence = static_cast<sequence_t>(m_nextSequence + count);
+
+                if (m_dirtyEnd == m_segment->capacity())
+                {
+                    commit_segment();
+                    m_segment.reset();
+                }
+            }
+
+            if (m_segment)
+            {
+                commit_segment();
+            }
+
+            m_committed.publish(last);
+        }
+
+        /// \brief
+        /// Journal events as they are published to \p source until the
+        /// event with sequence number \p last has been committed.
+        ///
+        /// \tparam Source
+        /// A type with a <tt>wait_until_published(sequence_t)</tt> method,
+        /// eg. single_threaded_claim_strategy, sequence_barrier or
+        /// sequence_barrier_group. For multi_threaded_claim_strategy call
+        /// append() from your own loop instead.
+        template<typename Source>
+        void run(const ring_buffer<T>& buffer, const Source& source, sequence_t last)
+        {
+            while (difference(m_nextSequence, last) <= 0)
+            {
+                sequence_t available = source.wait_until_published(m_nextSequence);
+                if (difference(available, last) > 0)
+                {
+                    available = last;
+                }
+                append(buffer, available);
+            }
+        }
+
+    private:
+
+        void open_segment(sequence_t sequence)
+        {
+            const sequence_t first = static_cast<sequence_t>(
+                sequence - sequence % m_recordsPerSegment);
+            m_segment.reset(new journal_segment(
+                journal_segment::file_name(m_directory, first),
+                sizeof(T),
+                first,
+                m_recordsPerSegment,
+                sequence));
+            m_dirtyBegin = 0;
+            m_dirtyEnd = 0;
+        }
+
+        void commit_segment()
+        {
+            m_segment->commit(m_dirtyBegin, m_dirtyEnd, m_nextSequence, m_sync);
+            m_dirtyBegin = m_dirtyEnd;
+        }
+
+        // Disable copy-construction
+        journal_writer(const journal_writer&);
+
+        const std::string m_directory;
+        const size_t m_recordsPerSegment;
+        const journal_sync m_sync;
+        sequence_t m_nextSequence;
+        std::unique_ptr<journal_segment> m_segment;
+        size_t m_dirtyBegin;
+        size_t m_dirtyEnd;
+        sequence_barrier<WaitStrategy> m_committed;
+
+    };
+}
+
+#endif
@@ -5,6 +5,7 @@
 #include <disruptorplus/sequence_barrier.hpp>
 #include <disruptorplus/sequence_barrier_group.hpp>
 #include <disruptorplus/sequence_range.hpp>
+#include <disruptorplus/tsc_clock.hpp>
 
 #include <atomic>
 #include <chrono>
@@ -65,7 +66,8 @@ namespace disruptorplus
             , m_bufferSize(bufferSize)
             , m_waitStrategy(waitStrategy)
             , m_claimBarrier(waitStrategy)
-            , m_published(new std::atomic<sequence_t>[bufferSize])
+            , m_publishedStorage(new std::atomic<sequence_t>[bufferSize + 2 * published_padding])
+            , m_published(m_publishedStorage.get() + published_padding)
             , m_nextClaimable(0)
         {
             // bufferSize must be power-of-two
@@ -134,6 +136,17 @@ namespace disruptorplus
             m_claimBarrier.add(barrier);
         }
         
+        /// \brief
+        /// The group of barriers added with add_claim_barrier() that slots
+        /// are claimed against.
+        ///
+        /// Its last published sequence number is the last slot that readers
+        /// have finished with.
+        const sequence_barrier_group<WaitStrategy>& claim_barrier() const
+        {
+            return m_claimBarrier;
+        }
+        
         /// \brief
         /// Claim a single slot in the ring buffer for writing to.
         ///
@@ -255,7 +268,7 @@ namespace disruptorplus
             return try_claim_until(
                 count,
                 range,
-                std::chrono::high_resolution_clock::now() + timeout);
+                tsc_clock::now() + std::chrono::duration_cast<tsc_clock::duration>(timeout));
         }
         
         /// \brief
@@ -386,7 +399,7 @@ namespace disruptorplus
             }
             m_waitStrategy.signal_all_when_blocking();
         }
-        
+
         /// \brief
         /// Return the highest sequence number published after the specified
         /// last-known published sequence.
@@ -482,7 +495,7 @@ namespace disruptorplus
             return wait_until_published(
                 sequence,
                 lastKnownPublished,
-                std::chrono::high_resolution_clock::now() + timeout);
+                tsc_clock::now() + std::chrono::duration_cast<tsc_clock::duration>(timeout));
         }
         
         /// \brief
@@ -516,6 +529,10 @@ namespace disruptorplus
         {
             assert(difference(sequence, lastKnownPublished) > 0);
             
+            // Convert the deadline once rather than calling Clock::now()
+            // again for each unpublished slot we have to wait on.
+            const tsc_clock::time_point deadline = tsc_clock::from(timeoutTime);
+            
             for (sequence_t seq = lastKnownPublished + 1;
                  difference(seq, sequence) <= 0;
                  ++seq)
@@ -525,7 +542,7 @@ namespace disruptorplus
                     const std::atomic<sequence_t>* const sequences[1] =
                         { &m_published[seq & m_indexMask] };
                     sequence_t result =
-                        m_waitStrategy.wait_until_published(seq, 1, sequences);
+                        m_waitStrategy.wait_until_published(seq, 1, sequences, deadline);
                     if (difference(result, seq) < 0)
                     {
                         // Timeout. seq is the first non-published sequence
@@ -557,14 +574,20 @@ namespace disruptorplus
         
         sequence_barrier_group<WaitStrategy> m_claimBarrier;
         
-        const std::unique_ptr<std::atomic<sequence_t>[]> m_published;
+        // Entries either side of m_published left unused so that the
+        // first and last slots' entries do not share a cache line with
+        // other heap allocations.
+        enum { published_padding = PaddingSize / sizeof(std::atomic<sequence_t>) };
+
+        const std::unique_ptr<std::atomic<sequence_t>[]> m_publishedStorage;
+        std::atomic<sequence_t>* const m_published;
 
         // Since this m_nextClaimable is going to be written to by multiple
         // threads, we don't want false sharing with m_published or other
         // variables that occur after it in the heap/stack.
-        uint8_t m_pad0[CacheLineSize - sizeof(sequence_t)];
+        uint8_t m_pad0[PaddingSize - sizeof(sequence_t)];
         std::atomic<sequence_t> m_nextClaimable;
-        uint8_t m_pad1[CacheLineSize - sizeof(sequence_t)];
+        uint8_t m_pad1[PaddingSize - sizeof(sequence_t)];
         
     };
 }
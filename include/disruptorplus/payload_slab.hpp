@@ -0,0 +1,251 @@
+#ifndef DISRUPTORPLUS_PAYLOAD_SLAB_HPP_INCLUDED
+#define DISRUPTORPLUS_PAYLOAD_SLAB_HPP_INCLUDED
+
+#include <disruptorplus/config.hpp>
+#include <disruptorplus/sequence.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+
+namespace disruptorplus
+{
+    /// \brief
+    /// A pool of memory for variable-sized event bodies that is recycled by
+    /// sequence number rather than freed explicitly.
+    ///
+    /// Each body is allocated for the sequence number of the slot that will
+    /// point to it and stays valid until the gating barrier has published
+    /// that sequence number. Bodies are carved from one circular region in
+    /// the order they are allocated and are reclaimed from its tail as the
+    /// gating barrier advances, so the allocation path touches no shared
+    /// state at all. The gating barrier is only read when the region looks
+    /// full and only waited on when it actually is.
+    ///
+    /// Allocations must be made for increasing sequence numbers. With a
+    /// single_threaded_claim_strategy one slab can serve the ring; with a
+    /// multi_threaded_claim_strategy give each producer its own slab.
+    ///
+    /// Only the owning producer thread may allocate. Consumers may read a
+    /// body until they publish its sequence number to their barrier.
+    ///
+    /// \tparam GatingBarrier
+    /// The barrier that marks how far all consumers of the bodies have got,
+    /// eg. sequence_barrier or sequence_barrier_group. Usually the same one
+    /// that gates the ring buffer's claim strategy.
+    template<typename GatingBarrier>
+    class payload_slab
+    {
+    public:
+
+        /// \brief
+        /// Construct a slab with \p capacity bytes of storage.
+        ///
+        /// \param gatingBarrier
+        /// The barrier whose progress releases bodies. Must outlive the slab.
+        ///
+        /// \param capacity
+        /// The size of the storage in bytes, including an allocation header
+        /// per body. Must be a power of two.
+        ///
+        /// \param alignment
+        /// The alignment of each body. Must be a power of two. Raised to at
+        /// least 16 bytes.
+        ///
+        /// \throws std::bad_alloc
+        /// If there was insufficient memory to allocate the storage.
+        payload_slab(const GatingBarrier& gatingBarrier, size_t capacity, size_t alignment = 16)
+        : m_gatingBarrier(gatingBarrier)
+        , m_capacity(capacity)
+        , m_alignment(std::max<size_t>(alignment, sizeof(header)))
+        , m_headerSize(m_alignment)
+        , m_storage(new char[capacity + m_alignment])
+        , m_base(align(m_storage.get()))
+        , m_head(0)
+        , m_tail(0)
+        , m_passed(gatingBarrier.last_published())
+        {
+            // Check that the sizes are powers of two.
+            assert(capacity != 0 && (capacity & (capacity - 1)) == 0);
+            assert((m_alignment & (m_alignment - 1)) == 0);
+            assert(capacity >= m_alignment);
+        }
+
+        /// \brief
+        /// The size of the storage in bytes.
+        size_t capacity() const { return m_capacity; }
+
+        /// \brief
+        /// The number of bytes held by bodies that have not yet been
+        /// reclaimed, including headers and padding.
+        size_t in_use() const { return static_cast<size_t>(m_head - m_tail); }
+
+        /// \brief
+        /// Allocate a body of \p size bytes for the event with sequence
+        /// number \p sequence.
+        ///
+        /// Blocks, using the gating barrier's wait strategy, until enough
+        /// earlier bodies have been released.
+        ///
+        /// \param sequence
+        /// The sequence number of the claimed slot that will refer to the
+        /// body. Must not be before the sequence number of the previous
+        /// allocation, and all earlier sequence numbers that own bodies must
+        /// already be published to consumers.
+        ///
+        /// \return
+        /// Pointer to \p size bytes aligned to the slab's alignment.
+        ///
+        /// \throws std::length_error
+        /// If the body can never fit in the slab.
+        void* allocate(sequence_t sequence, size_t size)
+        {
+            const size_t needed = m_headerSize + round_up(size);
+            if (needed > m_capacity)
+            {
+                throw std::length_error("payload_slab allocation larger than capacity");
+            }
+
+            if (m_head == m_tail)
+            {
+                // Empty, so restart from the beginning of the storage to
+                // leave the most contiguous space.
+                m_head = m_tail = 0;
+            }
+
+            // Bodies must be contiguous so pad out the end of the storage if
+            // the body would wrap around it.
+            size_t position = static_cast<size_t>(m_head) & (m_capacity - 1);
+            const size_t contiguous = m_capacity - position;
+            const size_t padding = needed <= contiguous ? 0 : contiguous;
+            if (m_capacity - in_use() < padding + needed)
+            {
+                reclaim(padding + needed);
+                position = static_cast<size_t>(m_head) & (m_capacity - 1);
+            }
+
+            if (padding > 0 && position != 0)
+            {
+                write_header(position, sequence, m_capacity - position);
+                m_head += m_capacity - position;
+                position = 0;
+            }
+
+            write_header(position, sequence, needed);
+            m_head += needed;
+            return m_base + position + m_headerSize;
+        }
+
+        /// \brief
+        /// Allocate storage for \p count objects of type \p U.
+        ///
+        /// The objects are not constructed and are never destroyed so \p U
+        /// should be trivially destructible.
+        template<typename U>
+        U* allocate(sequence_t sequence, size_t count = 1)
+        {
+            assert(alignof(U) <= m_alignment);
+            return static_cast<U*>(allocate(sequence, count * sizeof(U)));
+        }
+
+        /// \brief
+        /// Release all bodies whose sequence numbers the gating barrier has
+        /// published, without blocking.
+        ///
+        /// This happens automatically when allocating but may be called when
+        /// idle to keep in_use() accurate.
+        void trim()
+        {
+            m_passed = m_gatingBarrier.last_published();
+            release_passed();
+        }
+
+    private:
+
+        struct header
+        {
+            sequence_t m_sequence;
+            uint64_t m_size;
+        };
+
+        char* align(char* p) const
+        {
+            const uintptr_t address = reinterpret_cast<uintptr_t>(p);
+            return p + ((m_alignment - (address & (m_alignment - 1))) & (m_alignment - 1));
+        }
+
+        size_t round_up(size_t size) const
+        {
+            return (size + m_alignment - 1) & ~(m_alignment - 1);
+        }
+
+        void write_header(size_t position, sequence_t sequence, size_t size)
+        {
+            header* h = reinterpret_cast<header*>(m_base + position);
+            h->m_sequence = sequence;
+            h->m_size = size;
+        }
+
+        const header& oldest() const
+        {
+            return *reinterpret_cast<const header*>(
+                m_base + (static_cast<size_t>(m_tail) & (m_capacity - 1)));
+        }
+
+        // Release from the tail everything the last known gating position
+        // covers.
+        void release_passed()
+        {
+            while (m_head != m_tail && difference(oldest().m_sequence, m_passed) <= 0)
+            {
+                m_tail += oldest().m_size;
+            }
+        }
+
+        // Release from the tail until at least \p bytes are free, refreshing
+        // the gating position only once the cached one is exhausted.
+        void reclaim(size_t bytes)
+        {
+            release_passed();
+            while (m_capacity - in_use() < bytes)
+            {
+                if (m_head == m_tail)
+                {
+                    // Nothing left to release; the caller's padding is no
+                    // longer needed once the storage restarts at zero.
+                    m_head = m_tail = 0;
+                    return;
+                }
+                m_passed = m_gatingBarrier.last_published();
+                if (difference(oldest().m_sequence, m_passed) > 0)
+                {
+                    m_passed = m_gatingBarrier.wait_until_published(oldest().m_sequence);
+                }
+                release_passed();
+            }
+        }
+
+        // Disable copy-construction
+        payload_slab(const payload_slab&);
+
+        const GatingBarrier& m_gatingBarrier;
+        const size_t m_capacity;
+        const size_t m_alignment;
+        const size_t m_headerSize;
+        std::unique_ptr<char[]> m_storage;
+        char* const m_base;
+
+        // Byte offsets that only ever increase; their position in the
+        // storage is the offset modulo the capacity.
+        uint64_t m_head;
+        uint64_t m_tail;
+
+        // Last gating barrier position read.
+        sequence_t m_passed;
+
+    };
+}
+
+#endif
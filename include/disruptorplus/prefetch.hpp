@@ -0,0 +1,138 @@
+#ifndef DISRUPTORPLUS_PREFETCH_HPP_INCLUDED
+#define DISRUPTORPLUS_PREFETCH_HPP_INCLUDED
+
+#include <disruptorplus/config.hpp>
+#include <disruptorplus/sequence.hpp>
+
+#include <cstddef>
+
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+# include <xmmintrin.h>
+#endif
+
+namespace disruptorplus
+{
+    /// \brief
+    /// Hint to the processor that the cache line containing \p address
+    /// will soon be read.
+    ///
+    /// Does nothing on compilers without a prefetch intrinsic.
+    inline void prefetch_read(const void* address)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(address, 0, 3);
+#elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+        _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#else
+        (void)address;
+#endif
+    }
+
+    /// \brief
+    /// Hint to the processor that all cache lines of \p object will soon
+    /// be read.
+    template<typename T>
+    inline void prefetch_object(const T& object)
+    {
+        const char* p = reinterpret_cast<const char*>(&object);
+        for (size_t offset = 0; offset < sizeof(T); offset += CacheLineSize)
+        {
+            prefetch_read(p + offset);
+        }
+    }
+
+    /// \brief
+    /// The default indirect prefetch used by for_each_prefetched(), which
+    /// prefetches nothing.
+    struct no_indirect_prefetch
+    {
+        template<typename T>
+        const void* operator()(const T&) const { return nullptr; }
+    };
+
+    /// \brief
+    /// Call \p func for the items in \p buffer with sequence numbers
+    /// \p first to \p last inclusive, prefetching slots ahead of the one
+    /// being processed.
+    ///
+    /// Use this when a consumer catches up on a backlog in a ring buffer
+    /// much larger than its caches. Processing one slot at a time stalls on
+    /// each miss; prefetching overlaps the misses with the work on earlier
+    /// slots.
+    ///
+    /// Optionally the items can point at further data, eg. a body allocated
+    /// elsewhere. \p indirect is called on the item half the prefetch
+    /// distance ahead, whose slot has already been prefetched, and the data
+    /// at the address it returns is prefetched too.
+    ///
+    /// \param buffer
+    /// The ring buffer, either const or non-const.
+    ///
+    /// \param func
+    /// Called as <tt>func(buffer[sequence])</tt> in sequence order.
+    ///
+    /// \param distance
+    /// How many slots ahead to prefetch. Roughly the memory latency divided
+    /// by the time to process one item; 8-16 suits small items.
+    ///
+    /// \param indirect
+    /// Called as <tt>indirect(buffer[sequence])</tt>, returning the address
+    /// to prefetch or \c nullptr.
+    template<typename Buffer, typename Func, typename Indirect>
+    void for_each_prefetched(
+        Buffer& buffer,
+        sequence_t first,
+        sequence_t last,
+        Func func,
+        size_t distance,
+        Indirect indirect)
+    {
+        const size_t count = static_cast<size_t>(difference(last, first) + 1);
+        const size_t indirectDistance = distance / 2;
+
+        // Warm up the slots and indirect data that will be needed first.
+        for (size_t i = 0; i < distance && i < count; ++i)
+        {
+            prefetch_object(buffer[first + i]);
+        }
+        for (size_t i = 0; i < indirectDistance && i < count; ++i)
+        {
+            if (const void* p = indirect(buffer[first + i]))
+            {
+                prefetch_read(p);
+            }
+        }
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (i + distance < count)
+            {
+                prefetch_object(buffer[first + i + distance]);
+            }
+            if (indirectDistance > 0 && i + indirectDistance < count)
+            {
+                if (const void* p = indirect(buffer[first + i + indirectDistance]))
+                {
+                    prefetch_read(p);
+                }
+            }
+            func(buffer[first + i]);
+        }
+    }
+
+    /// \brief
+    /// Call \p func for the items in \p buffer with sequence numbers
+    /// \p first to \p last inclusive, prefetching \p distance slots ahead.
+    template<typename Buffer, typename Func>
+    void for_each_prefetched(
+        Buffer& buffer,
+        sequence_t first,
+        sequence_t last,
+        Func func,
+        size_t distance = 8)
+    {
+        for_each_prefetched(buffer, first, last, func, distance, no_indirect_prefetch());
+    }
+}
+
+#endif
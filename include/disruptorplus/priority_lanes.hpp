@@ -0,0 +1,331 @@
+#ifndef DISRUPTORPLUS_PRIORITY_LANES_HPP_INCLUDED
+#define DISRUPTORPLUS_PRIORITY_LANES_HPP_INCLUDED
+
+#include <disruptorplus/config.hpp>
+#include <disruptorplus/sequence.hpp>
+#include <disruptorplus/sequence_range.hpp>
+#include <disruptorplus/sequence_barrier.hpp>
+#include <disruptorplus/ring_buffer.hpp>
+#include <disruptorplus/multi_threaded_claim_strategy.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace disruptorplus
+{
+    /// \brief
+    /// The order in which a priority_lanes consumer drains its lanes.
+    enum class lane_policy
+    {
+        /// Always take from the highest-priority non-empty lane. Lower
+        /// lanes are only read while every higher lane is empty, so they
+        /// can be starved.
+        strict,
+
+        /// Visit the lanes in priority order, taking up to each lane's
+        /// weight in items per round, so each busy lane gets a share of the
+        /// consumer proportional to its weight.
+        weighted
+    };
+
+    /// \brief
+    /// A set of ring buffers ("lanes"), one per priority, with a single
+    /// producer API and a single consumer that drains them in priority order.
+    ///
+    /// Urgent items, such as cancels, would otherwise wait behind any
+    /// backlog of bulk items in a shared ring buffer. Here each priority has
+    /// its own ring buffer and claim strategy so an urgent item only waits
+    /// behind other urgent items and the batch the consumer is processing.
+    ///
+    /// Priority 0 is the highest. Producers claim and publish slots through
+    /// this object, which also rings a shared doorbell so that a consumer
+    /// with nothing to do makes one combined wait covering all lanes.
+    ///
+    /// \tparam T
+    /// The item type of every lane.
+    ///
+    /// \tparam WaitStrategy
+    /// The wait strategy shared by all lanes.
+    ///
+    /// \tparam ClaimStrategy
+    /// The claim strategy template of each lane, eg.
+    /// multi_threaded_claim_strategy or single_threaded_claim_strategy.
+    template<
+        typename T,
+        typename WaitStrategy,
+        template<typename> class ClaimStrategy = multi_threaded_claim_strategy>
+    class priority_lanes
+    {
+    public:
+
+        /// \brief
+        /// Construct lanes with strict priority.
+        ///
+        /// \param waitStrategy
+        /// The wait strategy shared by all lanes.
+        ///
+        /// \param laneSizes
+        /// The ring buffer size of each lane, highest priority first.
+        /// Each must be a power of two.
+        ///
+        /// \param batchSize
+        /// The most items taken from one lane before checking the higher
+        /// lanes again.
+        priority_lanes(
+            WaitStrategy& waitStrategy,
+            const std::vector<size_t>& laneSizes,
+            size_t batchSize = 64)
+        : m_waitStrategy(waitStrategy)
+        , m_policy(lane_policy::strict)
+        , m_doorbell(0)
+        {
+            init(laneSizes, std::vector<size_t>(laneSizes.size(), batchSize));
+        }
+
+        /// \brief
+        /// Construct lanes with the given policy.
+        ///
+        /// \param weights
+        /// The number of items taken from each lane per visit, highest
+        /// priority first. With lane_policy::weighted these set the lanes'
+        /// shares; with lane_policy::strict they are the per-lane batch
+        /// sizes.
+        priority_lanes(
+            WaitStrategy& waitStrategy,
+            const std::vector<size_t>& laneSizes,
+            lane_policy policy,
+            const std::vector<size_t>& weights)
+        : m_waitStrategy(waitStrategy)
+        , m_policy(policy)
+        , m_doorbell(0)
+        {
+            init(laneSizes, weights);
+        }
+
+        /// \brief
+        /// The number of lanes.
+        size_t lane_count() const
+        {
+            return m_lanes.size();
+        }
+
+        /// \brief
+        /// The ring buffer of the lane for \p priority.
+        ring_buffer<T>& buffer(size_t priority)
+        {
+            return m_lanes[priority]->m_buffer;
+        }
+
+        /// \brief
+        /// The claim strategy of the lane for \p priority.
+        ///
+        /// Items published directly through the claim strategy do not ring
+        /// the doorbell, so call ring() afterwards.
+        ClaimStrategy<WaitStrategy>& claim_strategy(size_t priority)
+        {
+            return m_lanes[priority]->m_claimStrategy;
+        }
+
+        /// \brief
+        /// The barrier to which the consumer publishes its progress through
+        /// the lane for \p priority.
+        const sequence_barrier<WaitStrategy>& consumed(size_t priority) const
+        {
+            return m_lanes[priority]->m_consumed;
+        }
+
+        /// \brief
+        /// Claim a slot in the lane for \p priority.
+        sequence_t claim_one(size_t priority)
+        {
+            return claim_strategy(priority).claim_one();
+        }
+
+        /// \brief
+        /// Claim up to \p count slots in the lane for \p priority.
+        sequence_range claim(size_t priority, size_t count)
+        {
+            return claim_strategy(priority).claim(count);
+        }
+
+        /// \brief
+        /// Publish the slot \p sequence of the lane for \p priority.
+        void publish(size_t priority, sequence_t sequence)
+        {
+            claim_strategy(priority).publish(sequence);
+            ring();
+        }
+
+        /// \brief
+        /// Publish the slots in \p range of the lane for \p priority.
+        void publish(size_t priority, const sequence_range& range)
+        {
+            claim_strategy(priority).publish(range);
+            ring();
+        }
+
+        /// \brief
+        /// Copy \p item into the lane for \p priority and publish it.
+        void push(size_t priority, const T& item)
+        {
+            const sequence_t sequence = claim_one(priority);
+            buffer(priority)[sequence] = item;
+            publish(priority, sequence);
+        }
+
+        /// \brief
+        /// Wake the consumer if it is waiting for any lane.
+        void ring()
+        {
+            m_doorbell.fetch_add(1, std::memory_order_release);
+            m_waitStrategy.signal_all_when_blocking();
+        }
+
+        /// \brief
+        /// Process published items without blocking.
+        ///
+        /// Only one thread may consume from the lanes.
+        ///
+        /// \param func
+        /// Called as <tt>func(priority, item)</tt> for each item.
+        ///
+        /// \param maxItems
+        /// Stop after roughly this many items, finishing the current batch.
+        ///
+        /// \return
+        /// The number of items processed.
+        template<typename Func>
+        size_t poll(Func func, size_t maxItems = 1024)
+        {
+            size_t processed = 0;
+            bool progress = true;
+            while (progress && processed < maxItems)
+            {
+                progress = false;
+                for (size_t priority = 0; priority < m_lanes.size(); ++priority)
+                {
+                    const size_t count = process_lane(priority, func);
+                    if (count > 0)
+                    {
+                        processed += count;
+                        progress = true;
+                        if (m_policy == lane_policy::strict)
+                        {
+                            // Re-check the higher lanes before continuing.
+                            break;
+                        }
+                    }
+                }
+            }
+            return processed;
+        }
+
+        /// \brief
+        /// Process published items, blocking until there is at least one.
+        ///
+        /// When every lane is empty the consumer makes a single wait on the
+        /// doorbell rung by the producers rather than checking each lane.
+        ///
+        /// \return
+        /// The number of items processed.
+        template<typename Func>
+        size_t process(Func func, size_t maxItems = 1024)
+        {
+            for (;;)
+            {
+                // Read the doorbell before checking the lanes so that an
+                // item published after the check rings it past this value.
+                const sequence_t rung = m_doorbell.load(std::memory_order_acquire);
+                const size_t processed = poll(func, maxItems);
+                if (processed > 0)
+                {
+                    return processed;
+                }
+                const std::atomic<sequence_t>* const doorbell[1] = { &m_doorbell };
+                m_waitStrategy.wait_until_published(static_cast<sequence_t>(rung + 1), 1, doorbell);
+            }
+        }
+
+    private:
+
+        // Disable copy-construction
+        priority_lanes(const priority_lanes&);
+
+        struct lane
+        {
+            lane(WaitStrategy& waitStrategy, size_t size, size_t weight)
+            : m_buffer(size)
+            , m_claimStrategy(size, waitStrategy)
+            , m_consumed(waitStrategy)
+            , m_weight(weight)
+            , m_nextToRead(0)
+            , m_lastKnownPublished(static_cast<sequence_t>(-1))
+            {
+                m_claimStrategy.add_claim_barrier(m_consumed);
+            }
+
+            ring_buffer<T> m_buffer;
+            ClaimStrategy<WaitStrategy> m_claimStrategy;
+            sequence_barrier<WaitStrategy> m_consumed;
+            const size_t m_weight;
+
+            // Consumer state.
+            sequence_t m_nextToRead;
+            sequence_t m_lastKnownPublished;
+        };
+
+        void init(const std::vector<size_t>& laneSizes, const std::vector<size_t>& weights)
+        {
+            assert(!laneSizes.empty() && weights.size() == laneSizes.size());
+            for (size_t i = 0; i < laneSizes.size(); ++i)
+            {
+                assert(weights[i] > 0);
+                m_lanes.emplace_back(new lane(m_waitStrategy, laneSizes[i], weights[i]));
+            }
+        }
+
+        // Process up to the lane's weight of published items.
+        template<typename Func>
+        size_t process_lane(size_t priority, Func& func)
+        {
+            lane& l = *m_lanes[priority];
+            if (difference(l.m_lastKnownPublished, l.m_nextToRead) < 0)
+            {
+                l.m_lastKnownPublished = l.m_claimStrategy.last_published_after(l.m_lastKnownPublished);
+                if (difference(l.m_lastKnownPublished, l.m_nextToRead) < 0)
+                {
+                    return 0;
+                }
+            }
+
+            const size_t available = static_cast<size_t>(difference(l.m_lastKnownPublished, l.m_nextToRead) + 1);
+            const size_t count = std::min(available, l.m_weight);
+            const sequence_t last = static_cast<sequence_t>(l.m_nextToRead + count - 1);
+            sequence_t seq = l.m_nextToRead;
+            do
+            {
+                func(priority, l.m_buffer[seq]);
+            } while (seq++ != last);
+            l.m_nextToRead = seq;
+            l.m_consumed.publish(last);
+            return count;
+        }
+
+        WaitStrategy& m_waitStrategy;
+        const lane_policy m_policy;
+        std::vector<std::unique_ptr<lane>> m_lanes;
+
+        // Producers increment this after publishing to any lane.
+        uint8_t m_pad0[PaddingSize - sizeof(sequence_t)];
+        std::atomic<sequence_t> m_doorbell;
+        uint8_t m_pad1[PaddingSize - sizeof(sequence_t)];
+
+    };
+}
+
+#endif
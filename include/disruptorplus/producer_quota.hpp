@@ -0,0 +1,217 @@
+#ifndef DISRUPTORPLUS_PRODUCER_QUOTA_HPP_INCLUDED
+#define DISRUPTORPLUS_PRODUCER_QUOTA_HPP_INCLUDED
+
+#include <disruptorplus/sequence.hpp>
+#include <disruptorplus/sequence_range.hpp>
+#include <disruptorplus/multi_threaded_claim_strategy.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+
+namespace disruptorplus
+{
+    /// \brief
+    /// The quota of a producer with \p weight out of \p totalWeight shares
+    /// of a ring buffer of \p bufferSize slots. Always at least one slot.
+    inline size_t fair_share_quota(size_t bufferSize, size_t weight, size_t totalWeight)
+    {
+        assert(weight <= totalWeight && totalWeight > 0);
+        return std::max<size_t>(1, bufferSize / totalWeight * weight);
+    }
+
+    /// \brief
+    /// One producer's handle onto a shared multi_threaded_claim_strategy
+    /// that bounds how many unconsumed slots the producer may hold.
+    ///
+    /// Without quotas a producer that bursts, or whose items are slow to
+    /// process, can fill the whole ring buffer so that every other producer
+    /// blocks behind it in the claim barrier. Giving each producer a quota,
+    /// with the quotas summing to at most the buffer size, stops any one of
+    /// them using another's headroom. A producer over its quota waits for
+    /// the readers to pass its own oldest slots rather than for the ring
+    /// buffer as a whole to drain.
+    ///
+    /// Slots count against the quota from being claimed until every claim
+    /// barrier has passed them. fair_share_quota() divides a buffer into
+    /// weighted shares.
+    ///
+    /// Each producer thread uses its own producer_quota. Claimed slots must
+    /// be published, via this object or the claim strategy, before the
+    /// producer can wait for its own quota to be freed.
+    ///
+    /// \tparam WaitStrategy
+    /// The wait strategy of the claim strategy.
+    template<typename WaitStrategy>
+    class producer_quota
+    {
+    public:
+
+        /// \brief
+        /// Construct a handle onto \p claimStrategy that may hold at most
+        /// \p quota unconsumed slots.
+        ///
+        /// \param quota
+        /// The maximum number of unconsumed slots. Must be between 1 and
+        /// the buffer size.
+        producer_quota(multi_threaded_claim_strategy<WaitStrategy>& claimStrategy, size_t quota)
+        : m_claimStrategy(claimStrategy)
+        , m_quota(quota)
+        , m_claims(new sequence_range[quota])
+        , m_claimsHead(0)
+        , m_claimsCount(0)
+        , m_outstanding(0)
+        {
+            assert(quota > 0 && quota <= claimStrategy.buffer_size());
+        }
+
+        /// \brief
+        /// The maximum number of unconsumed slots.
+        size_t quota() const
+        {
+            return m_quota;
+        }
+
+        /// \brief
+        /// The number of slots claimed by this producer that the readers
+        /// have not yet passed, as of the last claim.
+        size_t outstanding() const
+        {
+            return m_outstanding;
+        }
+
+        /// \brief
+        /// Claim a single slot, blocking until the producer's quota and the
+        /// ring buffer allow it.
+        sequence_t claim_one()
+        {
+            return claim(1).first();
+        }
+
+        /// \brief
+        /// Claim up to \p count consecutive slots.
+        ///
+        /// Waits until the producer's outstanding slots leave room for at
+        /// least \p count slots, or the whole quota if \p count exceeds it,
+        /// then claims them from the shared claim strategy.
+        ///
+        /// \return
+        /// The sequence numbers claimed, at least one slot if \p count is
+        /// non-zero.
+        sequence_range claim(size_t count)
+        {
+            count = std::min(count, m_quota);
+            reclaim(m_claimStrategy.claim_barrier().last_published());
+            if (m_outstanding + count > m_quota)
+            {
+                wait_for_quota(m_outstanding + count - m_quota);
+            }
+            return record(m_claimStrategy.claim(count));
+        }
+
+        /// \brief
+        /// Attempt to claim up to \p count slots without blocking.
+        ///
+        /// \return
+        /// Returns \c true if any slots were claimed, in which case \p range
+        /// is set to them. May claim fewer than requested if the quota or
+        /// the ring buffer is nearly full.
+        bool try_claim(size_t count, sequence_range& range)
+        {
+            reclaim(m_claimStrategy.claim_barrier().last_published());
+            count = std::min(count, m_quota - m_outstanding);
+            if (count == 0 || !m_claimStrategy.try_claim(count, range))
+            {
+                return false;
+            }
+            record(range);
+            return true;
+        }
+
+        /// \brief
+        /// Publish the slot with sequence number \p sequence.
+        void publish(sequence_t sequence)
+        {
+            m_claimStrategy.publish(sequence);
+        }
+
+        /// \brief
+        /// Publish the slots in \p range.
+        void publish(const sequence_range& range)
+        {
+            m_claimStrategy.publish(range);
+        }
+
+    private:
+
+        // Disable copy-construction
+        producer_quota(const producer_quota&);
+
+        // Release the slots of claims that the readers have passed.
+        void reclaim(sequence_t consumed)
+        {
+            while (m_claimsCount > 0)
+            {
+                sequence_range& oldest = m_claims[m_claimsHead];
+                const sequence_diff_t passed = difference(consumed, oldest.first()) + 1;
+                if (passed <= 0)
+                {
+                    return;
+                }
+                if (static_cast<size_t>(passed) < oldest.size())
+                {
+                    // Partially consumed.
+                    oldest = sequence_range(
+                        static_cast<sequence_t>(oldest.first() + passed),
+                        oldest.size() - static_cast<size_t>(passed));
+                    m_outstanding -= static_cast<size_t>(passed);
+                    return;
+                }
+                m_outstanding -= oldest.size();
+                m_claimsHead = (m_claimsHead + 1) % m_quota;
+                --m_claimsCount;
+            }
+        }
+
+        // Wait until the readers have passed this producer's next needed
+        // outstanding slots.
+        void wait_for_quota(size_t needed)
+        {
+            assert(needed <= m_outstanding);
+
+            // Find the needed'th oldest outstanding slot.
+            size_t index = m_claimsHead;
+            while (needed > m_claims[index].size())
+            {
+                needed -= m_claims[index].size();
+                index = (index + 1) % m_quota;
+            }
+            const sequence_t target = m_claims[index][needed - 1];
+
+            reclaim(m_claimStrategy.claim_barrier().wait_until_published(target));
+        }
+
+        sequence_range record(const sequence_range& range)
+        {
+            assert(m_claimsCount < m_quota);
+            m_claims[(m_claimsHead + m_claimsCount) % m_quota] = range;
+            ++m_claimsCount;
+            m_outstanding += range.size();
+            return range;
+        }
+
+        multi_threaded_claim_strategy<WaitStrategy>& m_claimStrategy;
+        const size_t m_quota;
+
+        // The producer's claims not yet passed by the readers, oldest first.
+        // Every claim holds at least one slot so at most m_quota are needed.
+        std::unique_ptr<sequence_range[]> m_claims;
+        size_t m_claimsHead;
+        size_t m_claimsCount;
+        size_t m_outstanding;
+
+    };
+}
+
+#endif
@@ -0,0 +1,290 @@
+#ifndef DISRUPTORPLUS_REQUEST_CHANNEL_HPP_INCLUDED
+#define DISRUPTORPLUS_REQUEST_CHANNEL_HPP_INCLUDED
+
+#include <disruptorplus/config.hpp>
+#include <disruptorplus/sequence.hpp>
+#include <disruptorplus/sequence_barrier.hpp>
+#include <disruptorplus/ring_buffer.hpp>
+#include <disruptorplus/multi_threaded_claim_strategy.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace disruptorplus
+{
+    /// \brief
+    /// An item of a request_channel's request ring buffer.
+    template<typename Request>
+    struct request_envelope
+    {
+        /// The index of the caller to reply to.
+        uint32_t m_caller;
+
+        /// The caller's correlation token for this call.
+        sequence_t m_token;
+
+        Request m_request;
+    };
+
+    /// \brief
+    /// Synchronous-looking calls from many threads to a single server
+    /// thread, with requests sent through a shared multi-producer ring
+    /// buffer and each reply written straight into its caller's own reply
+    /// slot.
+    ///
+    /// Each caller has a reply slot holding one response and a sequence
+    /// barrier to which the server publishes the correlation token of the
+    /// call it has answered. A caller waits on its own barrier, so a reply
+    /// only wakes the thread it is for. By default each caller also has
+    /// its own instance of \p ReplyWaitStrategy, so with
+    /// blocking_wait_strategy a caller parks on its own condition variable;
+    /// callers may instead share one instance.
+    ///
+    /// Tokens are each caller's count of calls made, so they need no
+    /// allocation and a late or repeated reply can never be mistaken for
+    /// the reply to a later call. A caller has at most one call outstanding.
+    ///
+    /// \tparam Request, Response
+    /// The request and response types. Must be default-constructible and
+    /// copy-assignable.
+    ///
+    /// \tparam WaitStrategy
+    /// The wait strategy of the request ring buffer.
+    ///
+    /// \tparam ReplyWaitStrategy
+    /// The wait strategy callers use to wait for replies, eg.
+    /// spin_wait_strategy to spin or blocking_wait_strategy to park.
+    template<typename Request, typename Response, typename WaitStrategy, typename ReplyWaitStrategy = WaitStrategy>
+    class request_channel
+    {
+    public:
+
+        typedef request_envelope<Request> envelope_type;
+
+        /// \brief
+        /// One calling thread's reply slot and correlation state.
+        ///
+        /// Each caller may only be used by one thread at a time.
+        class caller
+        {
+        public:
+
+            /// \brief
+            /// Send \p request and wait for its response.
+            ///
+            /// \return
+            /// The response, which stays valid until the next call.
+            const Response& call(const Request& request)
+            {
+                return receive(send(request));
+            }
+
+            /// \brief
+            /// Send \p request without waiting for its response.
+            ///
+            /// The previous call's response must have been received.
+            ///
+            /// \return
+            /// The correlation token of the call, for passing to receive()
+            /// or try_receive().
+            sequence_t send(const Request& request)
+            {
+                assert(difference(m_replied.last_published(), m_nextToken) == -1);
+                const sequence_t token = m_nextToken++;
+                const sequence_t seq = m_channel.m_claimStrategy.claim_one();
+                envelope_type& envelope = m_channel.m_requests[seq];
+                envelope.m_caller = m_index;
+                envelope.m_token = token;
+                envelope.m_request = request;
+                m_channel.m_claimStrategy.publish(seq);
+                return token;
+            }
+
+            /// \brief
+            /// Wait for the response to the call with token \p token.
+            ///
+            /// \return
+            /// The response, which stays valid until the next call.
+            const Response& receive(sequence_t token) const
+            {
+                m_replied.wait_until_published(token);
+                return m_response;
+            }
+
+            /// \brief
+            /// Query whether the call with token \p token has been answered
+            /// without waiting, eg. from an event loop or coroutine
+            /// scheduler.
+            ///
+            /// \return
+            /// \c true if response() holds the response.
+            bool try_receive(sequence_t token) const
+            {
+                return difference(m_replied.last_published(), token) >= 0;
+            }
+
+            /// \brief
+            /// The response to the last call answered.
+            const Response& response() const
+            {
+                return m_response;
+            }
+
+        private:
+
+            friend class request_channel;
+
+            caller(request_channel& channel, uint32_t index, ReplyWaitStrategy* sharedWaitStrategy)
+            : m_channel(channel)
+            , m_index(index)
+            , m_nextToken(0)
+            , m_ownWaitStrategy(sharedWaitStrategy == nullptr ? new ReplyWaitStrategy() : nullptr)
+            , m_replied(sharedWaitStrategy == nullptr ? *m_ownWaitStrategy : *sharedWaitStrategy)
+            {}
+
+            // Disable copy-construction
+            caller(const caller&);
+
+            request_channel& m_channel;
+            const uint32_t m_index;
+
+            // Caller state.
+            sequence_t m_nextToken;
+
+            std::unique_ptr<ReplyWaitStrategy> m_ownWaitStrategy;
+
+            // Written by the server.
+            uint8_t m_pad0[PaddingSize];
+            sequence_barrier<ReplyWaitStrategy> m_replied;
+            Response m_response;
+            uint8_t m_pad1[PaddingSize];
+
+        };
+
+        /// \brief
+        /// Construct a channel whose request ring buffer has \p bufferSize
+        /// slots.
+        ///
+        /// \param waitStrategy
+        /// The wait strategy of the request ring buffer.
+        ///
+        /// \param bufferSize
+        /// The size of the request ring buffer. Must be a power of two.
+        request_channel(WaitStrategy& waitStrategy, size_t bufferSize)
+        : m_claimStrategy(bufferSize, waitStrategy)
+        , m_requests(bufferSize)
+        , m_consumed(waitStrategy)
+        , m_nextToRead(0)
+        , m_lastKnownPublished(static_cast<sequence_t>(-1))
+        {
+            m_claimStrategy.add_claim_barrier(m_consumed);
+        }
+
+        /// \brief
+        /// Add a caller that waits for replies using its own instance of
+        /// \p ReplyWaitStrategy.
+        ///
+        /// Must be called before the server starts.
+        caller& add_caller()
+        {
+            m_callers.emplace_back(new caller(*this, static_cast<uint32_t>(m_callers.size()), nullptr));
+            return *m_callers.back();
+        }
+
+        /// \brief
+        /// Add a caller that waits for replies using \p waitStrategy, which
+        /// may be shared with other callers and must outlive the channel.
+        ///
+        /// Must be called before the server starts.
+        caller& add_caller(ReplyWaitStrategy& waitStrategy)
+        {
+            m_callers.emplace_back(new caller(*this, static_cast<uint32_t>(m_callers.size()), &waitStrategy));
+            return *m_callers.back();
+        }
+
+        /// \brief
+        /// The number of callers.
+        size_t caller_count() const
+        {
+            return m_callers.size();
+        }
+
+        /// \brief
+        /// Answer the requests that have been published, without blocking.
+        ///
+        /// Only one thread may serve the channel.
+        ///
+        /// \param func
+        /// Called as <tt>func(const Request&, Response&)</tt> for each
+        /// request, writing the response directly into the caller's reply
+        /// slot.
+        ///
+        /// \return
+        /// The number of requests answered.
+        template<typename Func>
+        size_t poll(Func func)
+        {
+            if (difference(m_lastKnownPublished, m_nextToRead) < 0)
+            {
+                m_lastKnownPublished = m_claimStrategy.last_published_after(m_lastKnownPublished);
+                if (difference(m_lastKnownPublished, m_nextToRead) < 0)
+                {
+                    return 0;
+                }
+            }
+            return serve(m_lastKnownPublished, func);
+        }
+
+        /// \brief
+        /// Answer the requests that have been published, blocking until
+        /// there is at least one.
+        ///
+        /// \return
+        /// The number of requests answered.
+        template<typename Func>
+        size_t process(Func func)
+        {
+            if (difference(m_lastKnownPublished, m_nextToRead) < 0)
+            {
+                m_lastKnownPublished = m_claimStrategy.wait_until_published(m_nextToRead, m_lastKnownPublished);
+            }
+            return serve(m_lastKnownPublished, func);
+        }
+
+    private:
+
+        // Disable copy-construction
+        request_channel(const request_channel&);
+
+        template<typename Func>
+        size_t serve(sequence_t last, Func& func)
+        {
+            const size_t count = static_cast<size_t>(difference(last, m_nextToRead) + 1);
+            do
+            {
+                const envelope_type& envelope = m_requests[m_nextToRead];
+                assert(envelope.m_caller < m_callers.size());
+                caller& c = *m_callers[envelope.m_caller];
+                func(envelope.m_request, c.m_response);
+                c.m_replied.publish(envelope.m_token);
+            } while (m_nextToRead++ != last);
+            m_consumed.publish(last);
+            return count;
+        }
+
+        multi_threaded_claim_strategy<WaitStrategy> m_claimStrategy;
+        ring_buffer<envelope_type> m_requests;
+        sequence_barrier<WaitStrategy> m_consumed;
+        std::vector<std::unique_ptr<caller>> m_callers;
+
+        // Server state.
+        sequence_t m_nextToRead;
+        sequence_t m_lastKnownPublished;
+
+    };
+}
+
+#endif
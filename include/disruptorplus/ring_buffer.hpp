@@ -1,13 +1,58 @@
 #ifndef DISRUPTORPLUS_RING_BUFFER_HPP_INCLUDED
 #define DISRUPTORPLUS_RING_BUFFER_HPP_INCLUDED
 
+#include <disruptorplus/config.hpp>
 #include <disruptorplus/sequence.hpp>
 
 #include <memory>
+#include <new>
 #include <cassert>
+#include <cstdlib>
+#include <type_traits>
+#if defined(_MSC_VER)
+# include <malloc.h>
+#endif
 
 namespace disruptorplus
 {
+    /// \brief
+    /// A base class that makes arrays of the derived type be allocated with
+    /// \p Alignment.
+    ///
+    /// The global operator new[] is not required to honour over-aligned
+    /// types prior to C++17, so derive an \c alignas type from this for
+    /// its arrays to actually start on an \p Alignment boundary.
+    template<size_t Alignment>
+    struct aligned_array_allocation
+    {
+        static void* operator new[](size_t size)
+        {
+#if defined(_MSC_VER)
+            void* p = _aligned_malloc(size, Alignment);
+#else
+            void* p = nullptr;
+            if (posix_memalign(&p, Alignment, size) != 0)
+            {
+                p = nullptr;
+            }
+#endif
+            if (p == nullptr)
+            {
+                throw std::bad_alloc();
+            }
+            return p;
+        }
+
+        static void operator delete[](void* p)
+        {
+#if defined(_MSC_VER)
+            _aligned_free(p);
+#else
+            free(p);
+#endif
+        }
+    };
+
     /// \brief
     /// A ring buffer is a buffer of size power-of-two that can
     /// be indexed using a sequence number.
@@ -23,7 +68,15 @@ namespace disruptorplus
     /// \tparam T
     /// The type of elements the ring buffer.
     /// This type must be default-constructible.
-    template<typename T>
+    ///
+    /// \tparam PadSlots
+    /// If \c true, each element is placed in its own block of
+    /// \ref PaddingSize bytes (or a multiple of it) so that producers
+    /// writing neighbouring slots do not falsely share cache lines.
+    /// The elements are then no longer contiguous, so the helpers that
+    /// treat the buffer as one array, such as streaming_copy, only accept
+    /// unpadded ring buffers.
+    template<typename T, bool PadSlots = false>
     class ring_buffer
     {
     public:
@@ -55,7 +108,7 @@ namespace disruptorplus
         ring_buffer(size_t size)
         : m_size(size)
         , m_mask(size - 1)
-        , m_data(new T[size])
+        , m_data(new slot[size])
         {
             // Check that size was a power-of-two.
             assert(m_size > 0 && (m_size & m_mask) == 0);
@@ -80,23 +133,36 @@ namespace disruptorplus
         /// modulo \ref size().
         reference operator[](sequence_t seq)
         {
-            return m_data[static_cast<size_t>(seq) & m_mask];
+            return value(m_data[static_cast<size_t>(seq) & m_mask]);
         }
         
         /// \copydoc ring_buffer::operator[](sequence_t)
         const_reference operator[](sequence_t seq) const
         {
-            return m_data[static_cast<size_t>(seq) & m_mask];
+            return value(m_data[static_cast<size_t>(seq) & m_mask]);
         }
         
     private:
 
+        // An element padded out to PaddingSize bytes.
+        struct alignas(PaddingSize) padded_slot : aligned_array_allocation<PaddingSize>
+        {
+            T m_value;
+        };
+
+        typedef typename std::conditional<PadSlots, padded_slot, T>::type slot;
+
+        static T& value(T& item) { return item; }
+        static const T& value(const T& item) { return item; }
+        static T& value(padded_slot& item) { return item.m_value; }
+        static const T& value(const padded_slot& item) { return item.m_value; }
+
         // Disable copy-construction
         ring_buffer(const ring_buffer&);
     
         const size_t m_size;
         const size_t m_mask;
-        std::unique_ptr<T[]> m_data;
+        std::unique_ptr<slot[]> m_data;
     
     };
 }
@@ -97,6 +97,47 @@ namespace disruptorplus
         return minimum;
     }
     
+    /// \brief
+    /// Calculate the maximum sequence number of an array of sequences.
+    ///
+    /// Calculates the maximum sequence number of the array of sequences
+    /// taking into account any overflowed sequence numbers by using the
+    /// first sequence as the zero-point.
+    ///
+    /// This assumes no two active sequence values will be more than
+    /// <tt>(1 << (sizeof(sequence_t) * 8 - 2)) - 1</tt> different from each other.
+    ///
+    /// This operation implies acquire memory semantics on each of the sequences.
+    ///
+    /// \param count
+    /// The number of elements in \p sequences.
+    /// Must be greater than zero.
+    ///
+    /// \param sequences
+    /// An array of pointers to sequence_t values containing the sequence
+    /// numbers to read.
+    ///
+    /// \return
+    /// The maximum sequence number read from \p sequences.
+    /// ie. the sequence number, \c s, such that <tt>difference(s, sequences[i]) >= 0</tt>
+    /// for all \c i in \[0, count)\[.
+    inline sequence_t maximum_sequence(
+        size_t count,
+        const std::atomic<sequence_t>* const sequences[])
+    {
+        assert(count > 0);
+        sequence_t maximum = sequences[0]->load(std::memory_order_acquire);
+        for (size_t i = 1; i < count; ++i)
+        {
+            sequence_t seq = sequences[i]->load(std::memory_order_acquire);
+            if (difference(seq, maximum) > 0)
+            {
+                maximum = seq;
+            }
+        }
+        return maximum;
+    }
+    
     /// \brief
     /// Calculate the minimum sequence number of an array of sequences,
     /// short-circuiting if any of them precede a specified sequence number.
@@ -12,6 +12,9 @@ namespace disruptorplus
     template<typename WaitStrategy>
     class sequence_barrier_group;
 
+    template<typename WaitStrategy>
+    class sequence_barrier_any_group;
+
     /// \brief
     /// A sequence barrier holds a sequence number that can be used to
     /// publish which item has finished processing and is now available.
@@ -197,13 +200,14 @@ namespace disruptorplus
     private:
     
         friend class sequence_barrier_group<WaitStrategy>;
+        friend class sequence_barrier_any_group<WaitStrategy>;
     
         WaitStrategy& m_waitStrategy;
     
         // Pad before/after to prevent false-sharing
-        uint8_t m_pad1[CacheLineSize - sizeof(sequence_t)];
+        uint8_t m_pad1[PaddingSize - sizeof(sequence_t)];
         std::atomic<sequence_t> m_lastPublished;
-        uint8_t m_pad2[CacheLineSize - sizeof(sequence_t)];
+        uint8_t m_pad2[PaddingSize - sizeof(sequence_t)];
         
     };
 }
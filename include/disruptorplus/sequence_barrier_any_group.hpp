@@ -0,0 +1,215 @@
+#ifndef DISRUPTORPLUS_SEQUENCE_BARRIER_ANY_GROUP_HPP_INCLUDED
+#define DISRUPTORPLUS_SEQUENCE_BARRIER_ANY_GROUP_HPP_INCLUDED
+
+#include <disruptorplus/sequence.hpp>
+#include <disruptorplus/sequence_barrier.hpp>
+
+#include <cassert>
+#include <chrono>
+#include <vector>
+
+namespace disruptorplus
+{
+    /// \brief
+    /// A sequence barrier any-group holds a collection of sequence barriers
+    /// that can be used to wait until any one of the sequence barriers has
+    /// published a given sequence number.
+    ///
+    /// This is the counterpart of \ref sequence_barrier_group, which waits
+    /// for all of its barriers. Use it for hot-standby replicas: two or more
+    /// identical consumers process every item and a downstream consumer
+    /// proceeds as soon as the first of them has finished with an item, so
+    /// its latency is that of the fastest replica rather than the slowest.
+    ///
+    /// The same barriers can also be added to a sequence_barrier_group. In
+    /// particular the producer must still gate on all of the replicas via
+    /// its claim barrier, or the slower replica would be overrun. A consumer
+    /// that needs both any of the replicas and all of some other consumers
+    /// waits on this group and then on the other group in turn.
+    ///
+    /// \tparam WaitStrategy
+    /// A class that defines the strategy to use for blocking threads while
+    /// waiting for a given sequence number to be published.
+    /// Must implement the wait_strategy model, including the
+    /// \c wait_until_any_published() operations.
+    template<typename WaitStrategy>
+    class sequence_barrier_any_group
+    {
+    public:
+
+        /// \brief
+        /// Initialise the group to the empty set of sequence barriers.
+        ///
+        /// \note
+        /// You must add some \ref sequence_barrier items to this
+        /// group before you can wait on it.
+        ///
+        /// \param waitStrategy
+        /// The wait strategy to use for threads waiting on this group.
+        /// The group holds a reference to this object so callers must ensure
+        /// the lifetime of the wait strategy exceeds that of the group.
+        sequence_barrier_any_group(WaitStrategy& waitStrategy)
+        : m_waitStrategy(waitStrategy)
+        {}
+
+        /// \brief
+        /// Add a sequence barrier to the group.
+        ///
+        /// This operation is not thread-safe and must be called prior
+        /// to sharing this object for use on multiple threads.
+        ///
+        /// \param barrier
+        /// The sequence barrier to add to the group.
+        /// This barrier must have been constructed with the same wait strategy
+        /// object that this group was constructed with, and its lifetime
+        /// must exceed that of the group.
+        ///
+        /// \throw std::bad_alloc
+        /// If there was insufficient memory to add the sequence barrier to
+        /// the group.
+        void add(const sequence_barrier<WaitStrategy>& barrier)
+        {
+            assert(&barrier.m_waitStrategy == &m_waitStrategy);
+            m_sequences.push_back(&barrier.m_lastPublished);
+        }
+
+        /// \brief
+        /// Add all sequence barriers in another any-group to this group.
+        ///
+        /// This operation is not thread-safe and must be called prior
+        /// to sharing this object for use on multiple threads.
+        ///
+        /// \throw std::bad_alloc
+        /// If there was insufficient memory to add the sequence barriers to
+        /// the group.
+        void add(const sequence_barrier_any_group<WaitStrategy>& barrierGroup)
+        {
+            m_sequences.insert(
+                m_sequences.end(),
+                barrierGroup.m_sequences.begin(),
+                barrierGroup.m_sequences.end());
+        }
+
+        /// \brief
+        /// Query the sequence number of the most-advanced sequence barrier
+        /// in the group.
+        sequence_t last_published() const
+        {
+            assert(!m_sequences.empty());
+            return maximum_sequence(m_sequences.size(), m_sequences.data());
+        }
+
+        /// \brief
+        /// Block the calling thread until any sequence barrier in the group
+        /// has advanced to at least the specified sequence.
+        ///
+        /// \param sequence
+        /// The sequence number to wait for.
+        ///
+        /// \return
+        /// The sequence number of the most-advanced sequence in the group.
+        /// This is guaranteed to satisfy <tt>difference(result, sequence) >= 0</tt>.
+        ///
+        /// \throw std::exception
+        /// Can throw any exception thrown by the associated
+        /// \c WaitStrategy::wait_until_any_published() method.
+        sequence_t wait_until_published(sequence_t sequence) const
+        {
+            assert(!m_sequences.empty());
+
+            size_t count = m_sequences.size();
+
+            sequence_t current = maximum_sequence(count, m_sequences.data());
+            if (difference(current, sequence) >= 0)
+            {
+                return current;
+            }
+
+            return m_waitStrategy.wait_until_any_published(sequence, count, m_sequences.data());
+        }
+
+        /// \brief
+        /// Block the calling thread until either any sequence barrier in
+        /// the group has advanced to at least the specified sequence or
+        /// a timeout has elapsed.
+        ///
+        /// \param sequence
+        /// The sequence number to wait for.
+        ///
+        /// \param timeout
+        /// The maximum time to block the thread for.
+        ///
+        /// \return
+        /// If the requested \p sequence number was published by any barrier
+        /// then returns the sequence number of the most-advanced of the
+        /// sequence barriers in the group. Otherwise, if the operation timed
+        /// out then returns some sequence number prior to \p sequence.
+        ///
+        /// \throw std::exception
+        /// Can throw any exception thrown by the associated
+        /// \c WaitStrategy::wait_until_any_published() method.
+        template<class Rep, class Period>
+        sequence_t wait_until_published(
+            sequence_t sequence,
+            const std::chrono::duration<Rep, Period>& timeout) const
+        {
+            assert(!m_sequences.empty());
+
+            size_t count = m_sequences.size();
+
+            sequence_t current = maximum_sequence(count, m_sequences.data());
+            if (difference(current, sequence) >= 0)
+            {
+                return current;
+            }
+
+            return m_waitStrategy.wait_until_any_published(sequence, count, m_sequences.data(), timeout);
+        }
+
+        /// \brief
+        /// Block the calling thread until either any sequence barrier in
+        /// the group has advanced to at least the specified sequence or
+        /// a timeout time has passed.
+        ///
+        /// \param sequence
+        /// The sequence number to wait for.
+        ///
+        /// \param timeoutTime
+        /// The time after which this operation times out.
+        ///
+        /// \return
+        /// If the requested \p sequence number was published by any barrier
+        /// then returns the sequence number of the most-advanced of the
+        /// sequence barriers in the group. Otherwise, if the operation timed
+        /// out then returns some sequence number prior to \p sequence.
+        ///
+        /// \throw std::exception
+        /// Can throw any exception thrown by the associated
+        /// \c WaitStrategy::wait_until_any_published() method.
+        template<class Clock, class Duration>
+        sequence_t wait_until_published(
+            sequence_t sequence,
+            const std::chrono::time_point<Clock, Duration>& timeoutTime) const
+        {
+            assert(!m_sequences.empty());
+
+            size_t count = m_sequences.size();
+
+            sequence_t current = maximum_sequence(count, m_sequences.data());
+            if (difference(current, sequence) >= 0)
+            {
+                return current;
+            }
+
+            return m_waitStrategy.wait_until_any_published(sequence, count, m_sequences.data(), timeoutTime);
+        }
+
+    private:
+
+        WaitStrategy& m_waitStrategy;
+        std::vector<const std::atomic<sequence_t>*> m_sequences;
+
+    };
+}
+
+#endif
@@ -0,0 +1,184 @@
+#ifndef DISRUPTORPLUS_SEQUENCE_RECLAIMER_HPP_INCLUDED
+#define DISRUPTORPLUS_SEQUENCE_RECLAIMER_HPP_INCLUDED
+
+#include <disruptorplus/sequence.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace disruptorplus
+{
+    /// \brief
+    /// Defers destruction of objects shared with consumers, such as routing
+    /// tables or configuration snapshots, until the consumers' barriers
+    /// show that they can no longer be referencing them.
+    ///
+    /// A writer swaps a new object into a shared pointer, then retires the
+    /// old one tagged with the last sequence number published to the ring
+    /// at that point. Consumers only process published sequence numbers, so
+    /// once the watched barrier has published the tag every consumer has
+    /// finished with any event during which it could have loaded the old
+    /// pointer. The consumers do no extra work; they simply need to obey
+    /// this rule:
+    ///
+    /// A consumer may only dereference a shared object while processing an
+    /// event it has not yet published, and must not keep a reference to it
+    /// after publishing that event.
+    ///
+    /// Retired objects are freed in batches: the barrier is read once per
+    /// reclaim() and everything it covers is freed together. An idle ring
+    /// does not hold objects back, since consumers that have caught up
+    /// have already published the tag.
+    ///
+    /// Only a single thread may use a given reclaimer.
+    ///
+    /// \tparam GatingBarrier
+    /// The barrier to watch, eg. a sequence_barrier or a
+    /// sequence_barrier_group of every consumer that reads the objects.
+    template<typename GatingBarrier>
+    class sequence_reclaimer
+    {
+    public:
+
+        /// \brief
+        /// Construct a reclaimer that watches \p watched.
+        ///
+        /// \param watched
+        /// The barrier whose progress releases retired objects. Must outlive
+        /// the reclaimer.
+        ///
+        /// \param batchSize
+        /// retire() calls reclaim() once this many objects are pending.
+        sequence_reclaimer(const GatingBarrier& watched, size_t batchSize = 64)
+        : m_watched(watched)
+        , m_batchSize(std::max<size_t>(1, batchSize))
+        , m_head(0)
+        {
+            m_retired.reserve(2 * m_batchSize);
+        }
+
+        /// \brief
+        /// Frees all objects still pending.
+        ///
+        /// The consumers must have stopped using them.
+        ~sequence_reclaimer()
+        {
+            for (size_t i = m_head; i < m_retired.size(); ++i)
+            {
+                m_retired[i].m_deleter(m_retired[i].m_object);
+            }
+        }
+
+        /// \brief
+        /// Retire an object that has been unlinked from the shared structure.
+        ///
+        /// \param object
+        /// The object to delete once it is no longer referenced.
+        ///
+        /// \param tag
+        /// The last sequence number published to consumers when \p object
+        /// was unlinked, eg. single_threaded_claim_strategy::last_published()
+        /// or the result of multi_threaded_claim_strategy::last_published_after().
+        /// Any later sequence number is also safe, only reclaimed later.
+        ///
+        /// \throw std::bad_alloc
+        /// If the pending list could not grow. \p object is then leaked
+        /// unless it was already safe to delete.
+        template<typename U>
+        void retire(U* object, sequence_t tag)
+        {
+            retire(object, &delete_object<U>, tag);
+        }
+
+        /// \brief
+        /// Retire an object that is freed by calling \p deleter.
+        void retire(void* object, void (*deleter)(void*), sequence_t tag)
+        {
+            if (pending() >= m_batchSize)
+            {
+                reclaim();
+            }
+
+            const retired entry = { object, deleter, tag };
+            try
+            {
+                m_retired.push_back(entry);
+            }
+            catch (...)
+            {
+                if (difference(tag, m_watched.last_published()) <= 0)
+                {
+                    deleter(object);
+                }
+                throw;
+            }
+        }
+
+        /// \brief
+        /// Free every retired object whose tag the watched barrier has
+        /// published.
+        ///
+        /// Objects are freed in the order they were retired, so one retired
+        /// with a later tag holds back those retired after it.
+        ///
+        /// \return
+        /// The number of objects freed.
+        size_t reclaim()
+        {
+            const sequence_t passed = m_watched.last_published();
+            const size_t first = m_head;
+            while (m_head < m_retired.size() &&
+                   difference(m_retired[m_head].m_tag, passed) <= 0)
+            {
+                m_retired[m_head].m_deleter(m_retired[m_head].m_object);
+                ++m_head;
+            }
+            const size_t freed = m_head - first;
+
+            // Compact without giving back capacity so that steady-state
+            // retirement does not allocate.
+            if (m_head == m_retired.size())
+            {
+                m_retired.clear();
+                m_head = 0;
+            }
+            else if (m_head >= m_retired.size() / 2)
+            {
+                m_retired.erase(m_retired.begin(), m_retired.begin() + m_head);
+                m_head = 0;
+            }
+            return freed;
+        }
+
+        /// \brief
+        /// The number of retired objects not yet freed.
+        size_t pending() const { return m_retired.size() - m_head; }
+
+    private:
+
+        struct retired
+        {
+            void* m_object;
+            void (*m_deleter)(void*);
+            sequence_t m_tag;
+        };
+
+        template<typename U>
+        static void delete_object(void* object)
+        {
+            delete static_cast<U*>(object);
+        }
+
+        // Disable copy-construction
+        sequence_reclaimer(const sequence_reclaimer&);
+
+        const GatingBarrier& m_watched;
+        const size_t m_batchSize;
+        std::vector<retired> m_retired;
+        size_t m_head;
+
+    };
+}
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef DISRUPTORPLUS_SINGLE_THREADED_CLAIM_STRATEGY_HPP_INCLUDED
 #define DISRUPTORPLUS_SINGLE_THREADED_CLAIM_STRATEGY_HPP_INCLUDED
 
+#include <disruptorplus/config.hpp>
 #include <disruptorplus/sequence_range.hpp>
 #include <disruptorplus/sequence_barrier.hpp>
 #include <disruptorplus/sequence_barrier_group.hpp>
@@ -333,6 +334,21 @@ namespace disruptorplus
             m_readBarrier.publish(sequence);
         }
 
+        /// \brief
+        /// Publishes all sequences up to and including the last sequence
+        /// in \p range.
+        ///
+        /// Equivalent to <tt>publish(range.last())</tt>. Provided so that
+        /// code can publish a claimed range with either claim strategy.
+        ///
+        /// \param range
+        /// The range of sequence numbers to publish. Must not be empty.
+        void publish(const sequence_range& range)
+        {
+            assert(range.size() > 0);
+            publish(range.last());
+        }
+
         /// \brief
         /// Query the last sequence that was published.
         ///
@@ -345,6 +361,18 @@ namespace disruptorplus
             return m_readBarrier.last_published();
         }
 
+        /// \brief
+        /// Query the last sequence that was published.
+        ///
+        /// Equivalent to \ref last_published(). Provided so that code
+        /// written against multi_threaded_claim_strategy::last_published_after()
+        /// works with either claim strategy.
+        sequence_t last_published_after(sequence_t lastKnownPublished) const
+        {
+            (void)lastKnownPublished;
+            return last_published();
+        }
+
         /// \brief
         /// Block the caller until the specified \p sequence has been
         /// published by the writer thread.
@@ -500,6 +528,10 @@ namespace disruptorplus
     private:
     
         const size_t m_bufferSize;
+
+        // Keep the producer's cursors, which are written on every claim,
+        // apart from whatever precedes this object in memory.
+        uint8_t m_pad0[PaddingSize - sizeof(size_t)];
         
         // The next sequence to be claimed (may not yet be available).
         sequence_t m_nextSequenceToClaim;
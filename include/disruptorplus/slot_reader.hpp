@@ -0,0 +1,243 @@
+#ifndef DISRUPTORPLUS_SLOT_READER_HPP_INCLUDED
+#define DISRUPTORPLUS_SLOT_READER_HPP_INCLUDED
+
+#include <disruptorplus/sequence.hpp>
+#include <disruptorplus/sequence_range.hpp>
+#include <disruptorplus/ring_buffer.hpp>
+#include <disruptorplus/io_message.hpp>
+
+#if !defined(__linux__)
+# error "slot_reader is currently only implemented for Linux"
+#endif
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+#include <vector>
+
+namespace disruptorplus
+{
+    /// \brief
+    /// A producer that reads from a file descriptor directly into claimed
+    /// ring buffer slots, avoiding a copy through an intermediate buffer.
+    ///
+    /// A batch of slots is claimed up-front and handed to the kernel as one
+    /// iovec per slot. Only the slots that were filled by a call are
+    /// published. The rest of the claim is kept for the next call so that
+    /// no sequence numbers are wasted; call flush() to tombstone and publish
+    /// the remainder when the producer goes idle.
+    ///
+    /// Unpublished claims hold back consumers of any later sequence numbers.
+    /// With a multi_threaded_claim_strategy that includes other producers'
+    /// events, so flush() before blocking for long.
+    ///
+    /// \tparam T
+    /// The ring buffer element type. Must have a \c uint32_t \c m_size
+    /// member and a \c m_data character array, see io_message.
+    ///
+    /// \tparam ClaimStrategy
+    /// The claim strategy the reader publishes to.
+    template<typename T, typename ClaimStrategy>
+    class slot_reader
+    {
+    public:
+
+        /// \brief
+        /// Construct a reader that claims up to \p batchSize slots at a time.
+        ///
+        /// \p batchSize is limited to the ring buffer size and to the
+        /// number of iovecs the kernel accepts in one call.
+        slot_reader(ClaimStrategy& claimStrategy, ring_buffer<T>& buffer, size_t batchSize = 64)
+        : m_claimStrategy(claimStrategy)
+        , m_buffer(buffer)
+        , m_batchSize(std::max<size_t>(1, std::min<size_t>(std::min(batchSize, buffer.size()), max_iovecs)))
+        , m_iovecs(m_batchSize)
+        , m_messages(m_batchSize)
+        , m_filled(0)
+        , m_eof(false)
+        , m_truncated(0)
+        {}
+
+        /// \brief
+        /// Tombstones any remaining claimed slots so consumers are not
+        /// left waiting on them.
+        ~slot_reader()
+        {
+            flush();
+        }
+
+        /// \brief
+        /// Whether a read has reported end-of-file.
+        bool eof() const { return m_eof; }
+
+        /// \brief
+        /// The number of datagrams that did not fit in a slot and were
+        /// truncated by receive().
+        uint64_t truncated() const { return m_truncated; }
+
+        /// \brief
+        /// The number of slots claimed but not yet filled.
+        size_t pending() const { return m_claimed.size() - m_filled; }
+
+        /// \brief
+        /// Read from a byte stream into consecutive slots with one readv().
+        ///
+        /// Every slot but the last one filled receives a full \c m_data, so
+        /// slot boundaries do not follow any message framing.
+        ///
+        /// \return
+        /// The number of slots published. Zero if a non-blocking \p fd had
+        /// no data or on end-of-file, see eof().
+        ///
+        /// \throw std::system_error
+        /// If readv() fails.
+        size_t read(int fd)
+        {
+            const size_t count = prepare();
+            ssize_t bytes;
+            do
+            {
+                bytes = ::readv(fd, &m_iovecs[m_filled], static_cast<int>(count));
+            } while (bytes < 0 && errno == EINTR);
+
+            if (bytes < 0)
+            {
+                if (errno == EAGAIN || errno == EWOULDBLOCK)
+                {
+                    return 0;
+                }
+                throw std::system_error(errno, std::system_category(), "readv");
+            }
+            if (bytes == 0)
+            {
+                m_eof = true;
+                return 0;
+            }
+
+            size_t remaining = static_cast<size_t>(bytes);
+            size_t slots = 0;
+            while (remaining > 0)
+            {
+                T& message = m_buffer[m_claimed[m_filled + slots]];
+                const size_t n = std::min(remaining, sizeof(message.m_data));
+                message.m_size = static_cast<uint32_t>(n);
+                remaining -= n;
+                ++slots;
+            }
+            return publish(slots);
+        }
+
+        /// \brief
+        /// Receive datagrams into consecutive slots, one per slot, with one
+        /// recvmmsg().
+        ///
+        /// \param flags
+        /// Flags passed to recvmmsg(). The default blocks until at least one
+        /// datagram is available and then takes whatever else is queued.
+        ///
+        /// \return
+        /// The number of slots published. Zero if no datagrams were
+        /// available for a non-blocking receive.
+        ///
+        /// \throw std::system_error
+        /// If recvmmsg() fails.
+        size_t receive(int fd, int flags = MSG_WAITFORONE)
+        {
+            const size_t count = prepare();
+            int received;
+            do
+            {
+                received = ::recvmmsg(fd, &m_messages[m_filled], static_cast<unsigned>(count), flags, nullptr);
+            } while (received < 0 && errno == EINTR);
+
+            if (received < 0)
+            {
+                if (errno == EAGAIN || errno == EWOULDBLOCK)
+                {
+                    return 0;
+                }
+                throw std::system_error(errno, std::system_category(), "recvmmsg");
+            }
+
+            for (int i = 0; i < received; ++i)
+            {
+                const mmsghdr& header = m_messages[m_filled + i];
+                m_buffer[m_claimed[m_filled + i]].m_size = header.msg_len;
+                if ((header.msg_hdr.msg_flags & MSG_TRUNC) != 0)
+                {
+                    ++m_truncated;
+                }
+            }
+            return publish(static_cast<size_t>(received));
+        }
+
+        /// \brief
+        /// Mark the claimed but unfilled slots as tombstones and publish them.
+        void flush()
+        {
+            const size_t count = pending();
+            if (count > 0)
+            {
+                for (size_t i = 0; i < count; ++i)
+                {
+                    m_buffer[m_claimed[m_filled + i]].m_size = io_message_tombstone;
+                }
+                publish(count);
+            }
+        }
+
+    private:
+
+        // Larger vectors are rejected by readv() and recvmmsg().
+        enum { max_iovecs = 1024 };
+
+        // Claim a new batch once the last one is used up, pointing the
+        // iovecs and message headers at the claimed slots.
+        size_t prepare()
+        {
+            if (pending() == 0)
+            {
+                m_claimed = m_claimStrategy.claim(m_batchSize);
+                m_filled = 0;
+                for (size_t i = 0; i < m_claimed.size(); ++i)
+                {
+                    T& message = m_buffer[m_claimed[i]];
+                    m_iovecs[i].iov_base = message.m_data;
+                    m_iovecs[i].iov_len = sizeof(message.m_data);
+                    std::memset(&m_messages[i], 0, sizeof(mmsghdr));
+                    m_messages[i].msg_hdr.msg_iov = &m_iovecs[i];
+                    m_messages[i].msg_hdr.msg_iovlen = 1;
+                }
+            }
+            return pending();
+        }
+
+        size_t publish(size_t count)
+        {
+            m_claimStrategy.publish(sequence_range(m_claimed[m_filled], count));
+            m_filled += count;
+            return count;
+        }
+
+        // Disable copy-construction
+        slot_reader(const slot_reader&);
+
+        ClaimStrategy& m_claimStrategy;
+        ring_buffer<T>& m_buffer;
+        const size_t m_batchSize;
+        std::vector<iovec> m_iovecs;
+        std::vector<mmsghdr> m_messages;
+        sequence_range m_claimed;
+        size_t m_filled;
+        bool m_eof;
+        uint64_t m_truncated;
+
+    };
+}
+
+#endif
@@ -3,6 +3,7 @@
 
 #include <disruptorplus/spin_wait.hpp>
 #include <disruptorplus/sequence.hpp>
+#include <disruptorplus/tsc_clock.hpp>
 
 #include <chrono>
 #include <atomic>
@@ -105,7 +106,7 @@ namespace disruptorplus
                 sequence,
                 count,
                 sequences,
-                std::chrono::high_resolution_clock::now() + timeout);
+                tsc_clock::now() + std::chrono::duration_cast<tsc_clock::duration>(timeout));
         }
 
         /// \brief
@@ -149,9 +150,17 @@ namespace disruptorplus
             assert(count > 0);
             spin_wait spinner;
             sequence_t result = minimum_sequence_after(sequence, count, sequences);
+            if (difference(result, sequence) >= 0)
+            {
+                return result;
+            }
+
+            // Convert the deadline once up-front so that checking it inside
+            // the loop is just a TSC read rather than a call to Clock::now().
+            const tsc_clock::time_point deadline = tsc_clock::from(timeoutTime);
             while (difference(result, sequence) < 0)
             {
-                if (spinner.next_spin_will_yield() && timeoutTime < Clock::now())
+                if (deadline < tsc_clock::now())
                 {
                     // Out of time.
                     return result;
@@ -162,6 +171,107 @@ namespace disruptorplus
             return result;
         }
 
+        /// \brief
+        /// Wait unconditionally until any of the specified sequences
+        /// has published at least the specified sequence value.
+        ///
+        /// \param sequence
+        /// The sequence number to wait for.
+        ///
+        /// \param count
+        /// The number of elements in \p sequences.
+        /// Must be greater than zero.
+        ///
+        /// \param sequences
+        /// An array of \p count pointers to sequence values.
+        /// The call will not return until at least one of these values has
+        /// advanced to the specified \p sequence.
+        ///
+        /// \return
+        /// The value of the most-advanced sequence.
+        /// This value is guaranteed to be at least \p sequence.
+        ///
+        /// \throw std::system_error
+        /// If the system does not have enough resources to perform this operation.
+        sequence_t wait_until_any_published(
+            sequence_t sequence,
+            size_t count,
+            const std::atomic<sequence_t>* const sequences[])
+        {
+            assert(count > 0);
+            spin_wait spinner;
+            sequence_t result = maximum_sequence(count, sequences);
+            while (difference(result, sequence) < 0)
+            {
+                spinner.spin_once();
+                result = maximum_sequence(count, sequences);
+            }
+            return result;
+        }
+
+        /// \brief
+        /// Wait until either any of the specified sequences has published
+        /// at least the specified sequence value or a timeout is reached.
+        ///
+        /// \return
+        /// If the operation timed out then returns some number such
+        /// that <tt>difference(result, sequence) < 0</tt>, otherwise
+        /// returns the most-advanced of all the sequence values read
+        /// from \p sequences, which is guaranteed to satisfy
+        /// <tt>difference(result, sequence) >= 0</tt>.
+        template<typename Rep, typename Period>
+        sequence_t wait_until_any_published(
+            sequence_t sequence,
+            size_t count,
+            const std::atomic<sequence_t>* const sequences[],
+            const std::chrono::duration<Rep, Period>& timeout)
+        {
+            return wait_until_any_published(
+                sequence,
+                count,
+                sequences,
+                tsc_clock::now() + std::chrono::duration_cast<tsc_clock::duration>(timeout));
+        }
+
+        /// \brief
+        /// Wait until either any of the specified sequences has published
+        /// at least the specified sequence value or a timeout time is reached.
+        ///
+        /// \return
+        /// If the operation timed out then returns some number such
+        /// that <tt>difference(result, sequence) < 0</tt>, otherwise
+        /// returns the most-advanced of all the sequence values read
+        /// from \p sequences, which is guaranteed to satisfy
+        /// <tt>difference(result, sequence) >= 0</tt>.
+        template<typename Clock, typename Duration>
+        sequence_t wait_until_any_published(
+            sequence_t sequence,
+            size_t count,
+            const std::atomic<sequence_t>* const sequences[],
+            const std::chrono::time_point<Clock, Duration>& timeoutTime)
+        {
+            assert(count > 0);
+            spin_wait spinner;
+            sequence_t result = maximum_sequence(count, sequences);
+            if (difference(result, sequence) >= 0)
+            {
+                return result;
+            }
+
+            const tsc_clock::time_point deadline = tsc_clock::from(timeoutTime);
+            while (difference(result, sequence) < 0)
+            {
+                if (deadline < tsc_clock::now())
+                {
+                    // Out of time.
+                    return result;
+                }
+                spinner.spin_once();
+                result = maximum_sequence(count, sequences);
+            }
+            return result;
+        }
+
         /// \brief
         /// Notify any waiting threads that one of the sequence values has changed.
         void signal_all_when_blocking()
@@ -0,0 +1,250 @@
+#ifndef DISRUPTORPLUS_STREAMING_COPY_HPP_INCLUDED
+#define DISRUPTORPLUS_STREAMING_COPY_HPP_INCLUDED
+
+#include <disruptorplus/sequence.hpp>
+#include <disruptorplus/sequence_range.hpp>
+#include <disruptorplus/ring_buffer.hpp>
+#include <disruptorplus/intrinsics.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace disruptorplus
+{
+    /// \brief
+    /// The instruction set used by streaming_copy.
+    enum class streaming_copy_kernel
+    {
+        /// Plain memcpy(), on processors without streaming stores.
+        memcpy,
+
+        /// 16-byte SSE2 streaming stores.
+        sse2,
+
+        /// 32-byte AVX2 streaming stores.
+        avx2,
+
+        /// 64-byte AVX-512 streaming stores.
+        avx512
+    };
+
+    /// \brief
+    /// Copies data with non-temporal (streaming) stores that write around
+    /// the cache.
+    ///
+    /// A producer that copies a large payload into a slot and never reads it
+    /// again would otherwise evict its own working set to make room for the
+    /// payload, and then have the lines invalidated when a consumer on
+    /// another core reads them. Streaming stores send the data towards
+    /// memory instead, from where the consumer reads it.
+    ///
+    /// The widest kernel the processor and operating system support is
+    /// chosen on first use. The GCC and Clang builds select between
+    /// AVX-512, AVX2 and SSE2. MSVC builds always use SSE2.
+    ///
+    /// Streaming stores are weakly ordered. Call fence() before publishing
+    /// the data to other threads.
+    class streaming_copy
+    {
+    public:
+
+        /// \brief
+        /// Copies below this many bytes use memcpy() as the cache pollution
+        /// they cause is not worth the cost of bypassing the cache.
+        static const size_t min_streaming_bytes = 256;
+
+        /// \brief
+        /// The kernel selected for this processor.
+        static streaming_copy_kernel kernel()
+        {
+            return dispatch().m_kernel;
+        }
+
+        /// \brief
+        /// Copy \p size bytes from \p source to \p destination.
+        ///
+        /// The regions must not overlap.
+        static void copy(void* destination, const void* source, size_t size)
+        {
+            char* d = static_cast<char*>(destination);
+            const char* s = static_cast<const char*>(source);
+
+            const kernel_table& table = dispatch();
+            if (size < min_streaming_bytes || table.m_copy == nullptr)
+            {
+                std::memcpy(d, s, size);
+                return;
+            }
+
+            // Streaming stores need an aligned destination so copy the
+            // unaligned head and tail normally.
+            const size_t width = table.m_width;
+            const size_t head = (width - (reinterpret_cast<uintptr_t>(d) & (width - 1))) & (width - 1);
+            std::memcpy(d, s, head);
+            d += head;
+            s += head;
+            size -= head;
+
+            const size_t body = size & ~(width - 1);
+            table.m_copy(d, s, body);
+            std::memcpy(d + body, s + body, size - body);
+        }
+
+        /// \brief
+        /// Copy the items for the sequence numbers in \p range from
+        /// \p source into \p buffer, splitting the copy where the range
+        /// wraps around the end of the ring.
+        template<typename T>
+        static void copy(ring_buffer<T>& buffer, const sequence_range& range, const T* source)
+        {
+            static_assert(std::is_trivially_copyable<T>::value,
+                          "streaming copies require trivially copyable items");
+
+            if (range.size() == 0)
+            {
+                return;
+            }
+            const size_t slot = static_cast<size_t>(range.first()) & (buffer.size() - 1);
+            const size_t firstSpan = std::min(range.size(), buffer.size() - slot);
+            copy(&buffer[range.first()], source, firstSpan * sizeof(T));
+            if (firstSpan < range.size())
+            {
+                copy(&buffer[range[firstSpan]], source + firstSpan, (range.size() - firstSpan) * sizeof(T));
+            }
+        }
+
+        /// \brief
+        /// Order all prior streaming stores before any later stores, such as
+        /// the store that publishes the copied data.
+        static void fence()
+        {
+#if DISRUPTORPLUS_X86
+            _mm_sfence();
+#endif
+        }
+
+    private:
+
+        typedef void (*copy_function)(char* destination, const char* source, size_t size);
+
+        struct kernel_table
+        {
+            streaming_copy_kernel m_kernel;
+            copy_function m_copy;
+            size_t m_width;
+        };
+
+        static const kernel_table& dispatch()
+        {
+            static const kernel_table table = select();
+            return table;
+        }
+
+#if DISRUPTORPLUS_X86
+
+        static kernel_table select()
+        {
+            kernel_table table = { streaming_copy_kernel::sse2, &copy_sse2, 16 };
+#if DISRUPTORPLUS_X86_MULTIVERSION
+            switch (widest_x86_vector_isa())
+            {
+            case x86_vector_isa::avx512f:
+                table.m_kernel = streaming_copy_kernel::avx512;
+                table.m_copy = &copy_avx512;
+                table.m_width = 64;
+                break;
+            case x86_vector_isa::avx2:
+                table.m_kernel = streaming_copy_kernel::avx2;
+                table.m_copy = &copy_avx2;
+                table.m_width = 32;
+                break;
+            default:
+                break;
+            }
+#endif
+            return table;
+        }
+
+        // Each kernel requires \p destination to be aligned to its width
+        // and \p size to be a multiple of it.
+
+        static void copy_sse2(char* destination, const char* source, size_t size)
+        {
+            for (size_t i = 0; i < size; i += 16)
+            {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+                _mm_stream_si128(reinterpret_cast<__m128i*>(destination + i), v);
+            }
+        }
+
+#if DISRUPTORPLUS_X86_MULTIVERSION
+
+        __attribute__((target("avx2")))
+        static void copy_avx2(char* destination, const char* source, size_t size)
+        {
+            for (size_t i = 0; i < size; i += 32)
+            {
+                const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i));
+                _mm256_stream_si256(reinterpret_cast<__m256i*>(destination + i), v);
+            }
+        }
+
+        __attribute__((target("avx512f")))
+        static void copy_avx512(char* destination, const char* source, size_t size)
+        {
+            for (size_t i = 0; i < size; i += 64)
+            {
+                const __m512i v = _mm512_loadu_si512(source + i);
+                _mm512_stream_si512(reinterpret_cast<__m512i*>(destination + i), v);
+            }
+        }
+
+#endif
+
+#else
+
+        static kernel_table select()
+        {
+            const kernel_table table = { streaming_copy_kernel::memcpy, nullptr, 1 };
+            return table;
+        }
+
+#endif
+
+    };
+
+    /// \brief
+    /// Claim slots for \p count items from \p claimStrategy, copy the items
+    /// from \p source into them with streaming stores and publish them.
+    ///
+    /// Intended for large items that this thread will not read again, see
+    /// streaming_copy. If fewer than \p count slots can be claimed at once
+    /// the items are copied and published in several batches.
+    ///
+    /// Blocks the caller until all items are published.
+    ///
+    /// \param claimStrategy
+    /// The claim strategy of \p buffer, either a single_threaded_claim_strategy
+    /// or a multi_threaded_claim_strategy.
+    ///
+    /// \param source
+    /// The items to copy. Must be trivially copyable.
+    template<typename ClaimStrategy, typename T>
+    void publish_copy(ClaimStrategy& claimStrategy, ring_buffer<T>& buffer, const T* source, size_t count)
+    {
+        while (count > 0)
+        {
+            const sequence_range range = claimStrategy.claim(count);
+            streaming_copy::copy(buffer, range, source);
+            streaming_copy::fence();
+            claimStrategy.publish(range);
+            source += range.size();
+            count -= range.size();
+        }
+    }
+}
+
+#endif
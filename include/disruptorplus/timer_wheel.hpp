@@ -0,0 +1,737 @@
+#ifndef DISRUPTORPLUS_TIMER_WHEEL_HPP_INCLUDED
+#define DISRUPTORPLUS_TIMER_WHEEL_HPP_INCLUDED
+
+#include <disruptorplus/sequence.hpp>
+#include <disruptorplus/sequence_range.hpp>
+#include <disruptorplus/sequence_barrier.hpp>
+#include <disruptorplus/ring_buffer.hpp>
+#include <disruptorplus/intrinsics.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace disruptorplus
+{
+    /// \brief
+    /// Identifies a timer scheduled with a timer_wheel. Never zero.
+    ///
+    /// A handle stays unique after its timer expires or is cancelled, so
+    /// cancelling a timer that has already fired is harmless.
+    typedef uint64_t timer_handle;
+
+    /// \brief
+    /// The operation a timer_request asks for.
+    enum class timer_request_kind : uint32_t
+    {
+        schedule,
+        cancel
+    };
+
+    /// \brief
+    /// An item of a timer_wheel's input ring buffer.
+    ///
+    /// These are written by timer_wheel::client rather than directly.
+    template<typename T>
+    struct timer_request
+    {
+        timer_request_kind m_kind;
+        timer_handle m_handle;
+        uint64_t m_deadline;
+        T m_value;
+    };
+
+    /// \brief
+    /// An item of a timer_wheel's output ring buffer: a timer that expired.
+    template<typename T>
+    struct timer_expiry
+    {
+        /// The handle returned when the timer was scheduled.
+        timer_handle m_handle;
+
+        /// The tick the timer was scheduled for.
+        uint64_t m_deadline;
+
+        /// The value the timer was scheduled with.
+        T m_value;
+    };
+
+    /// \brief
+    /// A timer service that takes schedule and cancel requests from an
+    /// input ring buffer and publishes expired timers to an output ring
+    /// buffer in batches.
+    ///
+    /// A single thread drives the wheel by calling poll() with the current
+    /// time, measured in ticks of whatever resolution the caller chooses.
+    /// Timers are held in a hierarchical timing wheel of four levels of 64
+    /// slots, so timers up to 2^24 ticks ahead are placed in O(1) and
+    /// cascade down a level at most three times. Timers further ahead wait
+    /// in an overflow list that is rescanned every 2^24 ticks. A timer
+    /// expires on the first poll() whose time is at or after its deadline.
+    ///
+    /// Producers schedule and cancel timers through a client, added with
+    /// add_client() before the producers start. Each client owns a fixed
+    /// quota of timers. Handles are taken from the client's own queue of
+    /// free timers, which the wheel refills as timers expire or are
+    /// cancelled, so a producer knows a timer's handle as soon as it
+    /// schedules it and cancelling by handle is O(1). A client whose quota
+    /// is used up blocks in schedule() until one of its timers is freed.
+    ///
+    /// All storage is allocated up-front; scheduling, cancelling and
+    /// expiring timers neither lock nor allocate.
+    ///
+    /// \tparam T
+    /// The value carried by each timer. Must be default-constructible and
+    /// copy-assignable.
+    ///
+    /// \tparam WaitStrategy
+    /// The wait strategy of the wheel's barriers.
+    ///
+    /// \tparam InputClaimStrategy
+    /// The claim strategy of the input ring buffer. Use
+    /// multi_threaded_claim_strategy if clients are used from more than one
+    /// thread.
+    ///
+    /// \tparam OutputClaimStrategy
+    /// The claim strategy of the output ring buffer.
+    template<typename T, typename WaitStrategy, typename InputClaimStrategy, typename OutputClaimStrategy>
+    class timer_wheel
+    {
+    public:
+
+        typedef timer_request<T> request_type;
+        typedef timer_expiry<T> expiry_type;
+
+        /// \brief
+        /// A producer's handle for scheduling and cancelling timers.
+        ///
+        /// Each client may only be used by one thread at a time.
+        class client
+        {
+        public:
+
+            /// \brief
+            /// The maximum number of this client's timers that may be
+            /// pending at once.
+            size_t quota() const
+            {
+                return m_quota;
+            }
+
+            /// \brief
+            /// The number of timers that may be scheduled without blocking.
+            size_t available() const
+            {
+                return static_cast<size_t>(difference(m_freed.last_published(), m_nextFree) + 1);
+            }
+
+            /// \brief
+            /// Schedule a timer to expire at tick \p deadline carrying
+            /// \p value.
+            ///
+            /// Blocks while all of this client's timers are pending, or
+            /// while the input ring buffer is full.
+            ///
+            /// \return
+            /// The timer's handle, for passing to cancel().
+            timer_handle schedule(uint64_t deadline, const T& value)
+            {
+                m_freed.wait_until_published(m_nextFree);
+                const timer_handle handle = m_free[static_cast<size_t>(m_nextFree) & m_mask];
+                ++m_nextFree;
+
+                const sequence_t seq = m_wheel.m_inputClaimStrategy.claim_one();
+                request_type& request = m_wheel.m_input[seq];
+                request.m_kind = timer_request_kind::schedule;
+                request.m_handle = handle;
+                request.m_deadline = deadline;
+                request.m_value = value;
+                m_wheel.m_inputClaimStrategy.publish(seq);
+                return handle;
+            }
+
+            /// \brief
+            /// Cancel the timer with handle \p handle.
+            ///
+            /// Does nothing if the timer has already expired. The handle may
+            /// belong to another client.
+            void cancel(timer_handle handle)
+            {
+                const sequence_t seq = m_wheel.m_inputClaimStrategy.claim_one();
+                request_type& request = m_wheel.m_input[seq];
+                request.m_kind = timer_request_kind::cancel;
+                request.m_handle = handle;
+                m_wheel.m_inputClaimStrategy.publish(seq);
+            }
+
+        private:
+
+            friend class timer_wheel;
+
+            client(timer_wheel& wheel, WaitStrategy& waitStrategy, uint32_t firstNode, size_t quota)
+            : m_wheel(wheel)
+            , m_quota(quota)
+            , m_mask(quota - 1)
+            , m_free(new timer_handle[quota])
+            , m_freed(waitStrategy)
+            , m_nextFree(0)
+            , m_freedCount(quota)
+            {
+                for (size_t i = 0; i < quota; ++i)
+                {
+                    m_free[i] = make_handle(static_cast<uint32_t>(firstNode + i), 1);
+                }
+                m_freed.publish(static_cast<sequence_t>(quota - 1));
+            }
+
+            // Disable copy-construction
+            client(const client&);
+
+            // Called by the wheel's thread to return a timer to the client.
+            void release(timer_handle handle)
+            {
+                m_free[static_cast<size_t>(m_freedCount) & m_mask] = handle;
+                m_freed.publish(m_freedCount);
+                ++m_freedCount;
+            }
+
+            timer_wheel& m_wheel;
+            const size_t m_quota;
+            const size_t m_mask;
+
+            // Free handles, a single-producer single-consumer queue from the
+            // wheel's thread to the client's.
+            std::unique_ptr<timer_handle[]> m_free;
+            sequence_barrier<WaitStrategy> m_freed;
+
+            // Client state.
+            sequence_t m_nextFree;
+
+            // Wheel state.
+            sequence_t m_freedCount;
+
+        };
+
+        /// \brief
+        /// Construct a timer wheel that reads requests from \p input and
+        /// writes expired timers to \p output.
+        ///
+        /// \param waitStrategy
+        /// The wait strategy used by the consumed() barrier and the clients'
+        /// free queues.
+        ///
+        /// \param inputClaimStrategy
+        /// The claim strategy of \p input, used by the clients to publish
+        /// requests. Add consumed() to it as a claim barrier.
+        ///
+        /// \param input
+        /// The input ring buffer. Must outlive the wheel.
+        ///
+        /// \param outputClaimStrategy
+        /// The claim strategy used to claim slots in \p output.
+        ///
+        /// \param output
+        /// The output ring buffer. Must outlive the wheel.
+        ///
+        /// \param capacity
+        /// The total number of timers shared out between the clients.
+        ///
+        /// \param firstTick
+        /// The time at which the wheel starts.
+        timer_wheel(
+            WaitStrategy& waitStrategy,
+            InputClaimStrategy& inputClaimStrategy,
+            ring_buffer<request_type>& input,
+            OutputClaimStrategy& outputClaimStrategy,
+            ring_buffer<expiry_type>& output,
+            size_t capacity,
+            uint64_t firstTick = 0)
+        : m_waitStrategy(waitStrategy)
+        , m_inputClaimStrategy(inputClaimStrategy)
+        , m_input(input)
+        , m_outputClaimStrategy(outputClaimStrategy)
+        , m_output(output)
+        , m_capacity(capacity)
+        , m_nodes(new node[capacity])
+        , m_allocated(0)
+        , m_now(firstTick)
+        , m_pending(0)
+        , m_expiredHead(no_node)
+        , m_expiredTail(no_node)
+        , m_expiredCount(0)
+        , m_expired(0)
+        , m_cancelled(0)
+        , m_nextSequence(0)
+        , m_lastKnownPublished(static_cast<sequence_t>(-1))
+        , m_consumed(waitStrategy)
+        {
+            assert(capacity > 0 && capacity < no_node);
+            std::fill(m_heads, m_heads + list_count, no_node);
+            std::fill(m_occupied, m_occupied + levels, 0);
+        }
+
+        /// \brief
+        /// Add a client owning \p quota of the wheel's timers.
+        ///
+        /// Must be called before any requests are published.
+        ///
+        /// \param quota
+        /// The number of timers the client may have pending at once. Must
+        /// be a power of two and no more than the timers left unassigned.
+        client& add_client(size_t quota)
+        {
+            // quota must be power-of-two
+            assert(quota > 0 && (quota & (quota - 1)) == 0);
+            assert(quota <= m_capacity - m_allocated);
+
+            const uint32_t firstNode = static_cast<uint32_t>(m_allocated);
+            const uint32_t clientIndex = static_cast<uint32_t>(m_clients.size());
+            for (size_t i = 0; i < quota; ++i)
+            {
+                m_nodes[m_allocated + i].m_handle = make_handle(static_cast<uint32_t>(firstNode + i), 1);
+                m_nodes[m_allocated + i].m_client = clientIndex;
+            }
+            m_allocated += quota;
+            m_clients.emplace_back(new client(*this, m_waitStrategy, firstNode, quota));
+            return *m_clients.back();
+        }
+
+        /// \brief
+        /// The barrier to which the last sequence number of the input ring
+        /// buffer that has been processed is published.
+        sequence_barrier<WaitStrategy>& consumed()
+        {
+            return m_consumed;
+        }
+
+        /// \brief
+        /// The next tick to be processed. Timers with earlier deadlines
+        /// have expired.
+        uint64_t now() const
+        {
+            return m_now;
+        }
+
+        /// \brief
+        /// The number of timers scheduled and neither expired nor cancelled.
+        size_t pending() const
+        {
+            return m_pending;
+        }
+
+        /// \brief
+        /// The number of timers that have expired.
+        uint64_t expired() const
+        {
+            return m_expired;
+        }
+
+        /// \brief
+        /// The number of timers that were cancelled before they expired.
+        uint64_t cancelled() const
+        {
+            return m_cancelled;
+        }
+
+        /// \brief
+        /// Process up to \p maxRequests published requests, then expire
+        /// every timer with a deadline at or before tick \p now and publish
+        /// them to the output ring buffer, in deadline order.
+        ///
+        /// Blocks while the output ring buffer is full. Only one thread may
+        /// call this.
+        ///
+        /// \return
+        /// The number of timers that expired.
+        size_t poll(uint64_t now, size_t maxRequests = 1024)
+        {
+            if (difference(m_lastKnownPublished, m_nextSequence) < 0)
+            {
+                m_lastKnownPublished = m_inputClaimStrategy.last_published_after(m_lastKnownPublished);
+            }
+            const sequence_diff_t available = difference(m_lastKnownPublished, m_nextSequence) + 1;
+            if (available > 0)
+            {
+                const size_t count = std::min(static_cast<size_t>(available), maxRequests);
+                const sequence_t last = static_cast<sequence_t>(m_nextSequence + count - 1);
+                do
+                {
+                    process_request(m_input[m_nextSequence]);
+                } while (m_nextSequence++ != last);
+                m_consumed.publish(last);
+            }
+
+            const uint64_t expiredBefore = m_expired;
+            advance(now);
+            flush();
+            return static_cast<size_t>(m_expired - expiredBefore);
+        }
+
+    private:
+
+        // Disable copy-construction
+        timer_wheel(const timer_wheel&);
+
+        enum : uint32_t
+        {
+            level_bits = 6,
+            slots = 1u << level_bits,
+            slot_mask = slots - 1,
+            levels = 4,
+
+            // The lists are the wheel's slots, level by level, then the
+            // overflow list.
+            overflow_list = levels * slots,
+            list_count = overflow_list + 1,
+
+            no_list = 0xFFFFFFFFu,
+            no_node = 0xFFFFFFFFu
+        };
+
+        enum class node_state : uint8_t
+        {
+            // Held by a client, or its schedule request not yet processed.
+            idle,
+
+            // In one of the wheel's lists.
+            scheduled,
+
+            // Cancelled before its schedule request was processed.
+            cancelled,
+
+            // Expired and waiting to be published. Too late to cancel.
+            expiring
+        };
+
+        struct node
+        {
+            node()
+            : m_handle(0)
+            , m_deadline(0)
+            , m_prev(no_node)
+            , m_next(no_node)
+            , m_list(no_list)
+            , m_client(0)
+            , m_state(node_state::idle)
+            {}
+
+            timer_handle m_handle;
+            uint64_t m_deadline;
+            uint32_t m_prev;
+            uint32_t m_next;
+            uint32_t m_list;
+            uint32_t m_client;
+            node_state m_state;
+            T m_value;
+        };
+
+        static timer_handle make_handle(uint32_t index, uint32_t generation)
+        {
+            return (static_cast<timer_handle>(generation) << 32) | index;
+        }
+
+        void process_request(const request_type& request)
+        {
+            const size_t index = static_cast<size_t>(request.m_handle & 0xFFFFFFFFu);
+            if (index >= m_allocated)
+            {
+                assert(request.m_kind == timer_request_kind::cancel);
+                return;
+            }
+            node& n = m_nodes[index];
+
+            if (request.m_kind == timer_request_kind::schedule)
+            {
+                assert(n.m_handle == request.m_handle && (n.m_state == node_state::idle || n.m_state == node_state::cancelled));
+                if (n.m_state == node_state::cancelled)
+                {
+                    ++m_cancelled;
+                    release(static_cast<uint32_t>(index));
+                    return;
+                }
+                n.m_state = node_state::scheduled;
+                n.m_deadline = request.m_deadline;
+                n.m_value = request.m_value;
+                if (n.m_deadline < m_now)
+                {
+                    // Already due.
+                    append_expired(static_cast<uint32_t>(index));
+                }
+                else
+                {
+                    insert(static_cast<uint32_t>(index));
+                    ++m_pending;
+                }
+                return;
+            }
+
+            if (n.m_handle != request.m_handle)
+            {
+                // Already expired or cancelled.
+                return;
+            }
+            if (n.m_state == node_state::scheduled)
+            {
+                unlink(static_cast<uint32_t>(index));
+                --m_pending;
+                ++m_cancelled;
+                release(static_cast<uint32_t>(index));
+            }
+            else if (n.m_state == node_state::idle)
+            {
+                // Cancelled by another thread before its schedule request
+                // arrived.
+                n.m_state = node_state::cancelled;
+            }
+        }
+
+        // Insert a node into the list for its deadline relative to m_now.
+        //
+        // The level is that of the highest group of level_bits in which the
+        // deadline differs from the current tick, so a node is cascaded to
+        // a lower level once the current tick reaches its slot.
+        void insert(uint32_t index)
+        {
+            const uint64_t deadline = m_nodes[index].m_deadline;
+            assert(deadline >= m_now);
+            const uint64_t differs = deadline ^ m_now;
+            const unsigned level = differs == 0 ? 0 : highest_bit(differs) / level_bits;
+            if (level >= levels)
+            {
+                link(index, overflow_list);
+            }
+            else
+            {
+                const uint32_t slot = static_cast<uint32_t>(deadline >> (level * level_bits)) & slot_mask;
+                link(index, level * slots + slot);
+            }
+        }
+
+        void link(uint32_t index, uint32_t list)
+        {
+            node& n = m_nodes[index];
+            n.m_list = list;
+            n.m_prev = no_node;
+            n.m_next = m_heads[list];
+            if (n.m_next != no_node)
+            {
+                m_nodes[n.m_next].m_prev = index;
+            }
+            m_heads[list] = index;
+            if (list < overflow_list)
+            {
+                m_occupied[list / slots] |= static_cast<uint64_t>(1) << (list & slot_mask);
+            }
+        }
+
+        void unlink(uint32_t index)
+        {
+            node& n = m_nodes[index];
+            if (n.m_prev != no_node)
+            {
+                m_nodes[n.m_prev].m_next = n.m_next;
+            }
+            else
+            {
+                m_heads[n.m_list] = n.m_next;
+                if (n.m_next == no_node && n.m_list < overflow_list)
+                {
+                    m_occupied[n.m_list / slots] &= ~(static_cast<uint64_t>(1) << (n.m_list & slot_mask));
+                }
+            }
+            if (n.m_next != no_node)
+            {
+                m_nodes[n.m_next].m_prev = n.m_prev;
+            }
+            n.m_list = no_list;
+        }
+
+        // Remove every node from a list, returning the first.
+        uint32_t detach(uint32_t list)
+        {
+            const uint32_t first = m_heads[list];
+            m_heads[list] = no_node;
+            if (list < overflow_list)
+            {
+                m_occupied[list / slots] &= ~(static_cast<uint64_t>(1) << (list & slot_mask));
+            }
+            return first;
+        }
+
+        // Expire timers up to and including tick now.
+        void advance(uint64_t now)
+        {
+            while (m_now <= now)
+            {
+                if (m_pending == 0)
+                {
+                    // Nothing to cascade or expire.
+                    m_now = now + 1;
+                    return;
+                }
+
+                const uint32_t slot = static_cast<uint32_t>(m_now) & slot_mask;
+                if (slot == 0)
+                {
+                    cascade();
+                }
+
+                // Skip straight to the next occupied slot of the lowest
+                // level, or to the end of its rotation.
+                const uint64_t occupied = m_occupied[0] >> slot;
+                if (occupied == 0)
+                {
+                    m_now = std::min((m_now | slot_mask) + 1, now + 1);
+                    continue;
+                }
+                const uint64_t next = m_now + lowest_bit(occupied);
+                if (next > now)
+                {
+                    m_now = now + 1;
+                    return;
+                }
+                m_now = next;
+                expire(static_cast<uint32_t>(next) & slot_mask);
+                ++m_now;
+            }
+        }
+
+        // Move the nodes of the slots that the current tick has just
+        // reached on the higher levels down to lower levels, highest level
+        // first.
+        void cascade()
+        {
+            unsigned level = 1;
+            while (level < levels && (m_now & ((static_cast<uint64_t>(1) << (level * level_bits)) - 1)) == 0)
+            {
+                ++level;
+            }
+            if (level == levels && (m_now & ((static_cast<uint64_t>(1) << (levels * level_bits)) - 1)) == 0)
+            {
+                reinsert(overflow_list);
+            }
+            while (--level > 0)
+            {
+                const uint32_t slot = static_cast<uint32_t>(m_now >> (level * level_bits)) & slot_mask;
+                if ((m_occupied[level] >> slot) & 1)
+                {
+                    reinsert(level * slots + slot);
+                }
+            }
+        }
+
+        void reinsert(uint32_t list)
+        {
+            uint32_t index = detach(list);
+            while (index != no_node)
+            {
+                const uint32_t next = m_nodes[index].m_next;
+                insert(index);
+                index = next;
+            }
+        }
+
+        // Move the nodes of a slot of the lowest level to the expired list.
+        void expire(uint32_t slot)
+        {
+            uint32_t index = detach(slot);
+            while (index != no_node)
+            {
+                const uint32_t next = m_nodes[index].m_next;
+                append_expired(index);
+                --m_pending;
+                index = next;
+            }
+        }
+
+        void append_expired(uint32_t index)
+        {
+            node& n = m_nodes[index];
+            n.m_state = node_state::expiring;
+            n.m_list = no_list;
+            n.m_next = no_node;
+            if (m_expiredTail != no_node)
+            {
+                m_nodes[m_expiredTail].m_next = index;
+            }
+            else
+            {
+                m_expiredHead = index;
+            }
+            m_expiredTail = index;
+            ++m_expiredCount;
+        }
+
+        // Publish the expired list to the output ring buffer in batches.
+        void flush()
+        {
+            while (m_expiredCount > 0)
+            {
+                const sequence_range range = m_outputClaimStrategy.claim(m_expiredCount);
+                for (size_t i = 0; i < range.size(); ++i)
+                {
+                    const uint32_t index = m_expiredHead;
+                    const node& n = m_nodes[index];
+                    expiry_type& expiry = m_output[range[i]];
+                    expiry.m_handle = n.m_handle;
+                    expiry.m_deadline = n.m_deadline;
+                    expiry.m_value = n.m_value;
+                    m_expiredHead = n.m_next;
+                    release(index);
+                }
+                m_outputClaimStrategy.publish(range);
+                m_expiredCount -= range.size();
+                m_expired += range.size();
+            }
+            m_expiredTail = no_node;
+        }
+
+        // Give a timer a new handle and return it to its client.
+        void release(uint32_t index)
+        {
+            node& n = m_nodes[index];
+            uint32_t generation = static_cast<uint32_t>(n.m_handle >> 32) + 1;
+            if (generation == 0)
+            {
+                generation = 1;
+            }
+            n.m_handle = make_handle(index, generation);
+            n.m_state = node_state::idle;
+            m_clients[n.m_client]->release(n.m_handle);
+        }
+
+        WaitStrategy& m_waitStrategy;
+        InputClaimStrategy& m_inputClaimStrategy;
+        ring_buffer<request_type>& m_input;
+        OutputClaimStrategy& m_outputClaimStrategy;
+        ring_buffer<expiry_type>& m_output;
+
+        const size_t m_capacity;
+        std::unique_ptr<node[]> m_nodes;
+        size_t m_allocated;
+        std::vector<std::unique_ptr<client>> m_clients;
+
+        uint64_t m_now;
+        size_t m_pending;
+        uint32_t m_heads[list_count];
+        uint64_t m_occupied[levels];
+
+        // Expired timers not yet published.
+        uint32_t m_expiredHead;
+        uint32_t m_expiredTail;
+        size_t m_expiredCount;
+
+        uint64_t m_expired;
+        uint64_t m_cancelled;
+
+        sequence_t m_nextSequence;
+        sequence_t m_lastKnownPublished;
+        sequence_barrier<WaitStrategy> m_consumed;
+
+    };
+}
+
+#endif
@@ -0,0 +1,258 @@
+#ifndef DISRUPTORPLUS_TOPIC_MASKS_HPP_INCLUDED
+#define DISRUPTORPLUS_TOPIC_MASKS_HPP_INCLUDED
+
+#include <disruptorplus/sequence.hpp>
+#include <disruptorplus/intrinsics.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace disruptorplus
+{
+    /// \brief
+    /// A set of up to 32 topics, one bit per topic.
+    typedef uint32_t topic_mask;
+
+    /// \brief
+    /// The mask containing only \p topic, which must be less than 32.
+    inline topic_mask topic_bit(unsigned topic)
+    {
+        assert(topic < 32);
+        return static_cast<topic_mask>(1) << topic;
+    }
+
+    /// \brief
+    /// Routing metadata for a ring buffer: the topics of each slot's item,
+    /// held in a dense array separate from the items.
+    ///
+    /// A consumer interested in a few of many topics would otherwise have to
+    /// read every item to find its type. Scanning the masks instead touches
+    /// one cache line per 16 slots and only the matching items themselves.
+    ///
+    /// The producer calls set() for each sequence before publishing it. The
+    /// consumer waits for sequences to be published as usual, visits the
+    /// matching ones with for_each_matching() and then publishes its
+    /// progress over the whole range, so producers gated on it are
+    /// unaffected by the items it skipped.
+    ///
+    /// The masks are scanned with the widest of AVX-512, AVX2 and SSE2 that
+    /// the processor supports, chosen on first use.
+    class topic_masks
+    {
+    public:
+
+        /// \brief
+        /// Construct the masks for a ring buffer of \p bufferSize slots.
+        ///
+        /// All masks are initially empty.
+        ///
+        /// \param bufferSize
+        /// The size of the ring buffer. Must be a power of two.
+        explicit topic_masks(size_t bufferSize)
+        : m_size(bufferSize)
+        , m_mask(bufferSize - 1)
+        , m_masks(new topic_mask[bufferSize]())
+        {
+            // Check that size was a power-of-two.
+            assert(m_size > 0 && (m_size & m_mask) == 0);
+        }
+
+        /// \brief
+        /// The number of slots, equal to the ring buffer's size.
+        size_t size() const
+        {
+            return m_size;
+        }
+
+        /// \brief
+        /// Set the topics of the item with sequence number \p sequence.
+        ///
+        /// Must be called by the producer that claimed \p sequence before
+        /// it publishes it.
+        void set(sequence_t sequence, topic_mask topics)
+        {
+            m_masks[static_cast<size_t>(sequence) & m_mask] = topics;
+        }
+
+        /// \brief
+        /// The topics of the item with sequence number \p sequence.
+        topic_mask get(sequence_t sequence) const
+        {
+            return m_masks[static_cast<size_t>(sequence) & m_mask];
+        }
+
+        /// \brief
+        /// Call \p func for each sequence from \p first to \p last
+        /// inclusive whose topics include any of \p interest, in sequence
+        /// order.
+        ///
+        /// \param func
+        /// Called as <tt>func(sequence)</tt>.
+        ///
+        /// \return
+        /// The number of matching sequences.
+        template<typename Func>
+        size_t for_each_matching(
+            sequence_t first,
+            sequence_t last,
+            topic_mask interest,
+            Func func) const
+        {
+            size_t matched = 0;
+            size_t remaining = static_cast<size_t>(difference(last, first) + 1);
+            sequence_t seq = first;
+            const kernel_table& table = dispatch();
+            while (remaining > 0)
+            {
+                // Scan up to the end of the array, then wrap around.
+                const size_t slot = static_cast<size_t>(seq) & m_mask;
+                const size_t span = std::min(remaining, m_size - slot);
+                const topic_mask* masks = m_masks.get() + slot;
+
+                size_t i = 0;
+                for (; i + block_size <= span; i += block_size)
+                {
+                    uint64_t bits = table.m_match(masks + i, interest);
+                    while (bits != 0)
+                    {
+                        func(static_cast<sequence_t>(seq + i + lowest_bit(bits)));
+                        bits &= bits - 1;
+                        ++matched;
+                    }
+                }
+                for (; i < span; ++i)
+                {
+                    if ((masks[i] & interest) != 0)
+                    {
+                        func(static_cast<sequence_t>(seq + i));
+                        ++matched;
+                    }
+                }
+
+                seq += static_cast<sequence_t>(span);
+                remaining -= span;
+            }
+            return matched;
+        }
+
+    private:
+
+        // Disable copy-construction
+        topic_masks(const topic_masks&);
+
+        // The number of masks examined by each call to a kernel.
+        enum { block_size = 64 };
+
+        // Returns a bit for each of the block_size masks that intersects
+        // interest, bit 0 for masks[0].
+        typedef uint64_t (*match_function)(const topic_mask* masks, topic_mask interest);
+
+        struct kernel_table
+        {
+            match_function m_match;
+        };
+
+        static const kernel_table& dispatch()
+        {
+            static const kernel_table table = select();
+            return table;
+        }
+
+#if DISRUPTORPLUS_X86
+
+        static kernel_table select()
+        {
+            kernel_table table = { &match_sse2 };
+#if DISRUPTORPLUS_X86_MULTIVERSION
+            switch (widest_x86_vector_isa())
+            {
+            case x86_vector_isa::avx512f:
+                table.m_match = &match_avx512;
+                break;
+            case x86_vector_isa::avx2:
+                table.m_match = &match_avx2;
+                break;
+            default:
+                break;
+            }
+#endif
+            return table;
+        }
+
+        static uint64_t match_sse2(const topic_mask* masks, topic_mask interest)
+        {
+            const __m128i want = _mm_set1_epi32(static_cast<int>(interest));
+            const __m128i zero = _mm_setzero_si128();
+            uint64_t misses = 0;
+            for (size_t i = 0; i < block_size; i += 4)
+            {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(masks + i));
+                const __m128i none = _mm_cmpeq_epi32(_mm_and_si128(v, want), zero);
+                misses |= static_cast<uint64_t>(_mm_movemask_ps(_mm_castsi128_ps(none))) << i;
+            }
+            return ~misses;
+        }
+
+#if DISRUPTORPLUS_X86_MULTIVERSION
+
+        __attribute__((target("avx2")))
+        static uint64_t match_avx2(const topic_mask* masks, topic_mask interest)
+        {
+            const __m256i want = _mm256_set1_epi32(static_cast<int>(interest));
+            const __m256i zero = _mm256_setzero_si256();
+            uint64_t misses = 0;
+            for (size_t i = 0; i < block_size; i += 8)
+            {
+                const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(masks + i));
+                const __m256i none = _mm256_cmpeq_epi32(_mm256_and_si256(v, want), zero);
+                misses |= static_cast<uint64_t>(_mm256_movemask_ps(_mm256_castsi256_ps(none))) << i;
+            }
+            return ~misses;
+        }
+
+        __attribute__((target("avx512f")))
+        static uint64_t match_avx512(const topic_mask* masks, topic_mask interest)
+        {
+            const __m512i want = _mm512_set1_epi32(static_cast<int>(interest));
+            uint64_t bits = 0;
+            for (size_t i = 0; i < block_size; i += 16)
+            {
+                const __m512i v = _mm512_loadu_si512(masks + i);
+                bits |= static_cast<uint64_t>(_mm512_test_epi32_mask(v, want)) << i;
+            }
+            return bits;
+        }
+
+#endif
+
+#else
+
+        static uint64_t match_scalar(const topic_mask* masks, topic_mask interest)
+        {
+            uint64_t bits = 0;
+            for (size_t i = 0; i < block_size; ++i)
+            {
+                bits |= static_cast<uint64_t>((masks[i] & interest) != 0) << i;
+            }
+            return bits;
+        }
+
+        static kernel_table select()
+        {
+            const kernel_table table = { &match_scalar };
+            return table;
+        }
+
+#endif
+
+        const size_t m_size;
+        const size_t m_mask;
+        std::unique_ptr<topic_mask[]> m_masks;
+
+    };
+}
+
+#endif
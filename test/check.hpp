@@ -0,0 +1,74 @@
+#ifndef DISRUPTORPLUS_TEST_CHECK_HPP_INCLUDED
+#define DISRUPTORPLUS_TEST_CHECK_HPP_INCLUDED
+
+#include <iostream>
+
+/// \file
+/// \brief
+/// Minimal checking helpers shared by the test programs.
+///
+/// Unlike assert() the checks are also made in release builds. Each test
+/// program returns report() from main() so that a failed check fails the
+/// program.
+
+namespace test
+{
+    /// \brief
+    /// The number of checks that have failed so far.
+    inline int& failures()
+    {
+        static int count = 0;
+        return count;
+    }
+
+    /// \brief
+    /// Record the result of a check, printing it if it failed.
+    inline void check(bool passed, const char* expression, const char* file, int line)
+    {
+        if (!passed)
+        {
+            ++failures();
+            std::cout << file << "(" << line << "): check failed: " << expression << std::endl;
+        }
+    }
+
+    /// \brief
+    /// Print a summary of the checks.
+    ///
+    /// \return
+    /// The exit code for main(), non-zero if any check failed.
+    inline int report()
+    {
+        if (failures() != 0)
+        {
+            std::cout << failures() << " check(s) failed" << std::endl;
+            return 1;
+        }
+        std::cout << "All checks passed" << std::endl;
+        return 0;
+    }
+}
+
+/// \brief
+/// Check that \p expression is true.
+#define CHECK(expression) \
+    ::test::check((expression), #expression, __FILE__, __LINE__)
+
+/// \brief
+/// Check that \p statement throws an exception of type \p exception_type.
+#define CHECK_THROWS(statement, exception_type) \
+    do \
+    { \
+        bool thrown = false; \
+        try \
+        { \
+            statement; \
+        } \
+        catch (const exception_type&) \
+        { \
+            thrown = true; \
+        } \
+        ::test::check(thrown, #statement " throws " #exception_type, __FILE__, __LINE__); \
+    } while (false)
+
+#endif
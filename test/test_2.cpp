@@ -1,4 +1,5 @@
 #include <disruptorplus/ring_buffer.hpp>
+#include <disruptorplus/tsc_clock.hpp>
 #include <disruptorplus/multi_threaded_claim_strategy.hpp>
 #include <disruptorplus/spin_wait_strategy.hpp>
 #include <disruptorplus/sequence_barrier.hpp>
@@ -19,6 +20,10 @@ struct message
 
 int main(int argc, char* argv[])
 {
+    // Calibrate the clock so that timestamps read the TSC rather than
+    // steady_clock.
+    disruptorplus::tsc_clock::calibrate();
+
     const int itemCount = 500 * 1000 * 1000;
     const size_t bufferSize = size_t(1) << 20;
     const int writerBatchSize = 1;
@@ -34,7 +39,7 @@ int main(int argc, char* argv[])
 
     std::vector<size_t> readerBatchSizes(bufferSize, 0);
 
-    auto start = std::chrono::high_resolution_clock::now();
+    auto start = disruptorplus::tsc_clock::now();
     
     uint64_t result;
     std::thread reader([&]() {
@@ -135,7 +140,7 @@ int main(int argc, char* argv[])
 
     auto totalItemCount = itemCount + 2;
 
-    auto end = std::chrono::high_resolution_clock::now();
+    auto end = disruptorplus::tsc_clock::now_ordered();
     auto dur = (end - start);
     auto durMS = std::chrono::duration_cast<std::chrono::milliseconds>(dur);
     auto durNS = std::chrono::duration_cast<std::chrono::nanoseconds>(dur);
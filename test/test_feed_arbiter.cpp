@@ -0,0 +1,274 @@
+#include <disruptorplus/feed_arbiter.hpp>
+#include <disruptorplus/single_threaded_claim_strategy.hpp>
+#include <disruptorplus/spin_wait_strategy.hpp>
+#include <disruptorplus/sequence_barrier.hpp>
+#include <disruptorplus/ring_buffer.hpp>
+
+#include "check.hpp"
+
+#include <cstdint>
+#include <vector>
+
+using namespace disruptorplus;
+
+namespace
+{
+    struct message
+    {
+        uint64_t m_feedSequence;
+    };
+
+    struct message_feed_sequence
+    {
+        uint64_t operator()(const message& m) const { return m.m_feedSequence; }
+    };
+
+    typedef single_threaded_claim_strategy<spin_wait_strategy> claim_strategy;
+    typedef feed_arbiter<message, spin_wait_strategy, claim_strategy, message_feed_sequence> arbiter;
+
+    typedef std::vector<uint64_t> values;
+
+    const size_t Window = 8;
+
+    // An arbiter fed one scripted message at a time from the test's own
+    // thread.
+    struct fixture
+    {
+        fixture()
+        : lineAClaim(64, waitStrategy)
+        , lineBClaim(64, waitStrategy)
+        , lineA(64)
+        , lineB(64)
+        , outputClaim(64, waitStrategy)
+        , output(64)
+        , outputRead(waitStrategy)
+        , arb(waitStrategy, lineA, lineB, outputClaim, output, Window)
+        , nextToRead(0)
+        {
+            lineAClaim.add_claim_barrier(arb.consumed(arbiter::line_a));
+            lineBClaim.add_claim_barrier(arb.consumed(arbiter::line_b));
+            outputClaim.add_claim_barrier(outputRead);
+        }
+
+        // Publish messages with feed sequence numbers first..last, in
+        // order, to line l and have the arbiter process each in turn.
+        void send(arbiter::line l, uint64_t first, uint64_t last)
+        {
+            claim_strategy& claimStrategy = l == arbiter::line_a ? lineAClaim : lineBClaim;
+            ring_buffer<message>& buffer = l == arbiter::line_a ? lineA : lineB;
+            for (uint64_t feedSequence = first; feedSequence <= last; ++feedSequence)
+            {
+                const sequence_t seq = claimStrategy.claim_one();
+                buffer[seq].m_feedSequence = feedSequence;
+                claimStrategy.publish(seq);
+                arb.process(l, seq);
+            }
+        }
+
+        void send(arbiter::line l, uint64_t feedSequence)
+        {
+            send(l, feedSequence, feedSequence);
+        }
+
+        // The feed sequence numbers emitted since the last call, in the
+        // order they were written to the output.
+        values take()
+        {
+            values emitted;
+            const sequence_t last = outputClaim.last_published();
+            while (difference(last, nextToRead) >= 0)
+            {
+                emitted.push_back(output[nextToRead].m_feedSequence);
+                ++nextToRead;
+            }
+            outputRead.publish(last);
+            return emitted;
+        }
+
+        bool statistics(
+            arbiter::line l,
+            uint64_t received,
+            uint64_t won,
+            uint64_t duplicates,
+            uint64_t gapFills) const
+        {
+            const feed_line_statistics& s = arb.statistics(l);
+            return s.m_received == received &&
+                s.m_won == won &&
+                s.m_duplicates == duplicates &&
+                s.m_gapFills == gapFills;
+        }
+
+        spin_wait_strategy waitStrategy;
+        claim_strategy lineAClaim;
+        claim_strategy lineBClaim;
+        ring_buffer<message> lineA;
+        ring_buffer<message> lineB;
+        claim_strategy outputClaim;
+        ring_buffer<message> output;
+        sequence_barrier<spin_wait_strategy> outputRead;
+        arbiter arb;
+        sequence_t nextToRead;
+    };
+
+    values range(uint64_t first, uint64_t last)
+    {
+        values v;
+        for (uint64_t i = first; i <= last; ++i)
+        {
+            v.push_back(i);
+        }
+        return v;
+    }
+
+    values concat(const values& a, const values& b)
+    {
+        values v = a;
+        v.insert(v.end(), b.begin(), b.end());
+        return v;
+    }
+
+    void TestDuplicates()
+    {
+        fixture f;
+        f.send(arbiter::line_a, 0, 2);
+        f.send(arbiter::line_b, 0, 3);
+        f.send(arbiter::line_a, 3);
+        CHECK(f.take() == range(0, 3));
+
+        CHECK(f.arb.next_feed_sequence() == 4);
+        CHECK(f.arb.emitted() == 4);
+        CHECK(f.arb.gaps() == 0);
+        CHECK(f.arb.lost() == 0);
+        CHECK(f.statistics(arbiter::line_a, 4, 3, 1, 0));
+        CHECK(f.statistics(arbiter::line_b, 4, 1, 3, 0));
+        CHECK(f.arb.next_sequence(arbiter::line_a) == 4);
+        CHECK(f.arb.next_sequence(arbiter::line_b) == 4);
+    }
+
+    void TestGapFilledByOtherLine()
+    {
+        fixture f;
+        f.send(arbiter::line_a, 0);
+        f.send(arbiter::line_a, 2, 3);
+        CHECK(f.take() == range(0, 0));
+        CHECK(f.arb.held() == 2);
+        CHECK(f.arb.gaps() == 1);
+
+        // B fills the gap, releasing the messages A delivered behind it.
+        f.send(arbiter::line_b, 1, 3);
+        CHECK(f.take() == range(1, 3));
+        CHECK(f.arb.held() == 0);
+
+        // A message repeated while held is a duplicate too.
+        f.send(arbiter::line_a, 5);
+        f.send(arbiter::line_b, 5);
+        CHECK(f.take().empty());
+        CHECK(f.arb.gaps() == 2);
+        f.send(arbiter::line_b, 4);
+        CHECK(f.take() == range(4, 5));
+
+        CHECK(f.arb.emitted() == 6);
+        CHECK(f.arb.lost() == 0);
+        CHECK(f.statistics(arbiter::line_a, 4, 4, 0, 0));
+        CHECK(f.statistics(arbiter::line_b, 5, 2, 3, 2));
+    }
+
+    void TestJumpBeyondWindow()
+    {
+        fixture f;
+        f.send(arbiter::line_a, 0);
+        f.send(arbiter::line_a, 2);
+
+        // 12 is more than a window ahead of the missing 1, so 1, 3 and 4
+        // are given up as lost and the held 2 is released. 12 then opens a
+        // new gap at 5.
+        f.send(arbiter::line_a, 12);
+        CHECK(f.take() == concat(range(0, 0), range(2, 2)));
+        CHECK(f.arb.next_feed_sequence() == 5);
+        CHECK(f.arb.lost() == 3);
+        CHECK(f.arb.gaps() == 2);
+        CHECK(f.arb.held() == 1);
+
+        // Messages that were given up as lost are duplicates when they
+        // turn up late.
+        f.send(arbiter::line_b, 1, 12);
+        CHECK(f.take() == range(5, 12));
+
+        CHECK(f.arb.emitted() == 10);
+        CHECK(f.arb.lost() == 3);
+        CHECK(f.arb.held() == 0);
+        CHECK(f.statistics(arbiter::line_a, 3, 3, 0, 0));
+        CHECK(f.statistics(arbiter::line_b, 12, 7, 5, 1));
+    }
+
+    void TestJumpReleasesWholeWindow()
+    {
+        fixture f;
+        f.send(arbiter::line_a, 0);
+        f.send(arbiter::line_a, 2, 8);
+        CHECK(f.take() == range(0, 0));
+        CHECK(f.arb.held() == 7);
+
+        // Giving up on 1 releases 2..8, after which 9 is next in order.
+        f.send(arbiter::line_a, 9);
+        CHECK(f.take() == range(2, 9));
+        CHECK(f.arb.next_feed_sequence() == 10);
+        CHECK(f.arb.held() == 0);
+        CHECK(f.arb.lost() == 1);
+        CHECK(f.arb.gaps() == 1);
+        CHECK(f.statistics(arbiter::line_a, 9, 9, 0, 0));
+
+        // A jump with nothing held loses everything before the window.
+        f.send(arbiter::line_b, 30);
+        CHECK(f.take().empty());
+        CHECK(f.arb.next_feed_sequence() == 23);
+        CHECK(f.arb.lost() == 14);
+        CHECK(f.arb.gaps() == 2);
+        CHECK(f.arb.held() == 1);
+    }
+
+    void TestSkipGap()
+    {
+        fixture f;
+
+        // Nothing is held so there is no gap to skip.
+        f.arb.skip_gap();
+        CHECK(f.arb.next_feed_sequence() == 0);
+
+        f.send(arbiter::line_a, 0);
+        f.send(arbiter::line_a, 3, 4);
+        f.send(arbiter::line_a, 6);
+        CHECK(f.take() == range(0, 0));
+
+        // Skipping gives up on 1 and 2 and releases up to the next gap.
+        f.arb.skip_gap();
+        CHECK(f.take() == range(3, 4));
+        CHECK(f.arb.next_feed_sequence() == 5);
+        CHECK(f.arb.lost() == 2);
+        CHECK(f.arb.held() == 1);
+
+        f.arb.skip_gap();
+        CHECK(f.take() == range(6, 6));
+        CHECK(f.arb.lost() == 3);
+        CHECK(f.arb.held() == 0);
+
+        f.send(arbiter::line_b, 1, 7);
+        CHECK(f.take() == range(7, 7));
+
+        CHECK(f.arb.emitted() == 5);
+        CHECK(f.arb.gaps() == 1);
+        CHECK(f.statistics(arbiter::line_a, 4, 4, 0, 0));
+        CHECK(f.statistics(arbiter::line_b, 7, 1, 6, 0));
+    }
+}
+
+int main()
+{
+    TestDuplicates();
+    TestGapFilledByOtherLine();
+    TestJumpBeyondWindow();
+    TestJumpReleasesWholeWindow();
+    TestSkipGap();
+    return test::report();
+}
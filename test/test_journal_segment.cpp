@@ -0,0 +1,170 @@
+#include <disruptorplus/journal_segment.hpp>
+
+#include "check.hpp"
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+using namespace disruptorplus;
+
+namespace
+{
+    const size_t RecordSize = 64;
+    const sequence_t FirstSequence = 32;
+    const size_t Capacity = 16;
+    const size_t CommittedCount = 5;
+
+    // Offsets of fields in the segment header.
+    const off_t MagicOffset = 0;
+    const off_t CommittedEndOffset = 48;
+
+    off_t FileSize(const std::string& path)
+    {
+        struct stat info;
+        return ::stat(path.c_str(), &info) == 0 ? info.st_size : -1;
+    }
+
+    void WriteHeaderField(const std::string& path, off_t offset, uint64_t value)
+    {
+        const int fd = ::open(path.c_str(), O_WRONLY);
+        const bool written = fd >= 0 && ::pwrite(fd, &value, sizeof(value), offset) == sizeof(value);
+        if (fd >= 0)
+        {
+            ::close(fd);
+        }
+        if (!written)
+        {
+            throw std::runtime_error("failed to write " + path);
+        }
+    }
+
+    // Write a segment holding CommittedCount committed records.
+    void CreateSegment(const std::string& path)
+    {
+        ::unlink(path.c_str());
+        journal_segment segment(path, RecordSize, FirstSequence, Capacity, FirstSequence);
+        for (size_t i = 0; i < CommittedCount; ++i)
+        {
+            for (size_t b = 0; b < RecordSize; ++b)
+            {
+                segment.record(i)[b] = static_cast<unsigned char>(i * 7 + b);
+            }
+        }
+        segment.commit(0, CommittedCount, FirstSequence + CommittedCount, journal_sync::none);
+    }
+
+    // Check that the segment still holds its original layout and records.
+    void CheckSegmentIntact(const std::string& path, off_t size)
+    {
+        CHECK(FileSize(path) == size);
+
+        journal_segment segment(path);
+        CHECK(segment.record_size() == RecordSize);
+        CHECK(segment.first_sequence() == FirstSequence);
+        CHECK(segment.capacity() == Capacity);
+        CHECK(segment.begin_sequence() == FirstSequence);
+        CHECK(segment.committed_end() == FirstSequence + CommittedCount);
+
+        bool recordsIntact = true;
+        for (size_t i = 0; i < CommittedCount; ++i)
+        {
+            for (size_t b = 0; b < RecordSize; ++b)
+            {
+                recordsIntact &= segment.record(i)[b] == static_cast<unsigned char>(i * 7 + b);
+            }
+        }
+        CHECK(recordsIntact);
+    }
+
+    void TestReopenWithSameLayout(const std::string& path)
+    {
+        CreateSegment(path);
+        const off_t size = FileSize(path);
+
+        // The begin sequence only applies to new files.
+        {
+            journal_segment segment(path, RecordSize, FirstSequence, Capacity, FirstSequence + 3);
+            CHECK(segment.begin_sequence() == FirstSequence);
+            CHECK(segment.committed_end() == FirstSequence + CommittedCount);
+        }
+        CheckSegmentIntact(path, size);
+    }
+
+    void TestReopenWithDifferentLayout(const std::string& path)
+    {
+        CreateSegment(path);
+        const off_t size = FileSize(path);
+
+        CHECK_THROWS(journal_segment segment(path, RecordSize / 2, FirstSequence, Capacity, FirstSequence), std::runtime_error);
+        CheckSegmentIntact(path, size);
+
+        CHECK_THROWS(journal_segment segment(path, RecordSize, FirstSequence + Capacity, Capacity, FirstSequence + Capacity), std::runtime_error);
+        CheckSegmentIntact(path, size);
+
+        CHECK_THROWS(journal_segment segment(path, RecordSize, FirstSequence, Capacity / 2, FirstSequence), std::runtime_error);
+        CheckSegmentIntact(path, size);
+
+        CHECK_THROWS(journal_segment segment(path, RecordSize, FirstSequence, Capacity * 2, FirstSequence), std::runtime_error);
+        CheckSegmentIntact(path, size);
+    }
+
+    void TestCorruptedHeader(const std::string& path)
+    {
+        // A committed end beyond the end of the segment.
+        CreateSegment(path);
+        const off_t size = FileSize(path);
+        WriteHeaderField(path, CommittedEndOffset, FirstSequence + Capacity + 1);
+        CHECK_THROWS(journal_segment segment(path), std::runtime_error);
+        CHECK_THROWS(journal_segment segment(path, RecordSize, FirstSequence, Capacity, FirstSequence), std::runtime_error);
+        CHECK(FileSize(path) == size);
+
+        // A committed end before the first record.
+        CreateSegment(path);
+        WriteHeaderField(path, CommittedEndOffset, FirstSequence - 1);
+        CHECK_THROWS(journal_segment segment(path), std::runtime_error);
+        CHECK_THROWS(journal_segment segment(path, RecordSize, FirstSequence, Capacity, FirstSequence), std::runtime_error);
+
+        // Not a journal segment.
+        CreateSegment(path);
+        WriteHeaderField(path, MagicOffset, 0);
+        CHECK_THROWS(journal_segment segment(path), std::runtime_error);
+
+        // Shorter than the header.
+        CreateSegment(path);
+        CHECK(::truncate(path.c_str(), 16) == 0);
+        CHECK_THROWS(journal_segment segment(path), std::runtime_error);
+    }
+}
+
+int main()
+{
+    char directory[] = "/tmp/disruptorplus-test-XXXXXX";
+    if (::mkdtemp(directory) == nullptr)
+    {
+        std::cout << "error: failed to create a temporary directory" << std::endl;
+        return 1;
+    }
+    const std::string path = journal_segment::file_name(directory, FirstSequence);
+
+    try
+    {
+        TestReopenWithSameLayout(path);
+        TestReopenWithDifferentLayout(path);
+        TestCorruptedHeader(path);
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "error: " << e.what() << std::endl;
+        ++test::failures();
+    }
+
+    ::unlink(path.c_str());
+    ::rmdir(directory);
+    return test::report();
+}
@@ -0,0 +1,250 @@
+#include <disruptorplus/timer_wheel.hpp>
+#include <disruptorplus/single_threaded_claim_strategy.hpp>
+#include <disruptorplus/spin_wait_strategy.hpp>
+#include <disruptorplus/sequence_barrier.hpp>
+#include <disruptorplus/ring_buffer.hpp>
+
+#include "check.hpp"
+
+#include <cstdint>
+#include <vector>
+
+using namespace disruptorplus;
+
+namespace
+{
+    typedef single_threaded_claim_strategy<spin_wait_strategy> claim_strategy;
+    typedef timer_wheel<uint32_t, spin_wait_strategy, claim_strategy, claim_strategy> wheel_type;
+
+    typedef std::vector<uint32_t> values;
+
+    const uint64_t OverflowTicks = static_cast<uint64_t>(1) << 24;
+
+    // A wheel driven from the test's own thread with a synthetic clock.
+    struct fixture
+    {
+        explicit fixture(size_t quota, uint64_t firstTick = 0)
+        : inputClaim(64, waitStrategy)
+        , input(64)
+        , outputClaim(64, waitStrategy)
+        , output(64)
+        , outputRead(waitStrategy)
+        , wheel(waitStrategy, inputClaim, input, outputClaim, output, quota, firstTick)
+        , client(wheel.add_client(quota))
+        , nextToRead(0)
+        {
+            inputClaim.add_claim_barrier(wheel.consumed());
+            outputClaim.add_claim_barrier(outputRead);
+        }
+
+        // Poll the wheel at tick now and return the values of the timers
+        // that expired, in the order they were published.
+        values poll(uint64_t now)
+        {
+            wheel.poll(now);
+            values expired;
+            const sequence_t last = outputClaim.last_published();
+            while (difference(last, nextToRead) >= 0)
+            {
+                expired.push_back(output[nextToRead].m_value);
+                ++nextToRead;
+            }
+            outputRead.publish(last);
+            return expired;
+        }
+
+        spin_wait_strategy waitStrategy;
+        claim_strategy inputClaim;
+        ring_buffer<wheel_type::request_type> input;
+        claim_strategy outputClaim;
+        ring_buffer<wheel_type::expiry_type> output;
+        sequence_barrier<spin_wait_strategy> outputRead;
+        wheel_type wheel;
+        wheel_type::client& client;
+        sequence_t nextToRead;
+    };
+
+    values list(uint32_t a)
+    {
+        return values(1, a);
+    }
+
+    values list(uint32_t a, uint32_t b)
+    {
+        values v(1, a);
+        v.push_back(b);
+        return v;
+    }
+
+    values list(uint32_t a, uint32_t b, uint32_t c)
+    {
+        values v = list(a, b);
+        v.push_back(c);
+        return v;
+    }
+
+    void TestExpiresAtDeadline()
+    {
+        fixture f(4);
+        f.client.schedule(10, 1);
+        f.client.schedule(3, 2);
+        f.client.schedule(10, 3);
+        CHECK(f.poll(2).empty());
+        CHECK(f.wheel.pending() == 3);
+        CHECK(f.poll(3) == list(2));
+        CHECK(f.poll(9).empty());
+
+        const values due = f.poll(10);
+        CHECK(due.size() == 2);
+        CHECK(f.wheel.pending() == 0);
+        CHECK(f.wheel.expired() == 3);
+        CHECK(f.wheel.now() == 11);
+    }
+
+    void TestDeadlineBeforeNow()
+    {
+        fixture f(4, 100);
+        CHECK(f.poll(100).empty());
+        CHECK(f.wheel.now() == 101);
+
+        // Overdue timers expire on the next poll, ahead of the timers
+        // that fall due in that poll, even if the poll's time is earlier.
+        f.client.schedule(102, 1);
+        f.client.schedule(50, 2);
+        CHECK(f.poll(102) == list(2, 1));
+
+        f.client.schedule(7, 3);
+        CHECK(f.poll(20) == list(3));
+        CHECK(f.wheel.now() == 103);
+        CHECK(f.wheel.pending() == 0);
+        CHECK(f.wheel.expired() == 3);
+
+        // A deadline of exactly now() is not overdue and expires normally.
+        f.client.schedule(103, 4);
+        CHECK(f.wheel.pending() == 0);
+        CHECK(f.poll(102).empty());
+        CHECK(f.wheel.pending() == 1);
+        CHECK(f.poll(103) == list(4));
+    }
+
+    void TestCancel()
+    {
+        fixture f(4);
+        const timer_handle a = f.client.schedule(10, 1);
+        f.client.schedule(10, 2);
+        CHECK(f.poll(5).empty());
+        f.client.cancel(a);
+        CHECK(f.poll(10) == list(2));
+        CHECK(f.wheel.cancelled() == 1);
+        CHECK(f.wheel.expired() == 1);
+
+        // Cancelled in the same batch of requests as it was scheduled.
+        const timer_handle b = f.client.schedule(20, 3);
+        f.client.cancel(b);
+        CHECK(f.poll(30).empty());
+        CHECK(f.wheel.cancelled() == 2);
+        CHECK(f.wheel.pending() == 0);
+        CHECK(f.client.available() == 4);
+    }
+
+    void TestCancelAfterExpiry()
+    {
+        fixture f(1);
+        const timer_handle a = f.client.schedule(5, 1);
+        CHECK(f.poll(5) == list(1));
+        CHECK(f.client.available() == 1);
+
+        f.client.cancel(a);
+        CHECK(f.poll(6).empty());
+        CHECK(f.wheel.cancelled() == 0);
+        CHECK(f.wheel.expired() == 1);
+        CHECK(f.client.available() == 1);
+    }
+
+    void TestStaleHandle()
+    {
+        // A quota of one makes every timer reuse the same node, so each
+        // new handle differs from the last only in its generation.
+        fixture f(1);
+        const timer_handle a = f.client.schedule(5, 1);
+        CHECK(f.poll(5) == list(1));
+
+        const timer_handle b = f.client.schedule(20, 2);
+        CHECK(b != a);
+        CHECK((b & 0xFFFFFFFFu) == (a & 0xFFFFFFFFu));
+
+        // Cancelling the expired timer's handle leaves its successor be.
+        f.client.cancel(a);
+        CHECK(f.poll(19).empty());
+        CHECK(f.wheel.pending() == 1);
+        CHECK(f.poll(20) == list(2));
+        CHECK(f.wheel.cancelled() == 0);
+
+        // Likewise for the handle of a cancelled timer.
+        const timer_handle c = f.client.schedule(30, 3);
+        f.client.cancel(c);
+        CHECK(f.poll(25).empty());
+        CHECK(f.wheel.cancelled() == 1);
+        const timer_handle d = f.client.schedule(40, 4);
+        CHECK(d != c);
+        f.client.cancel(c);
+        CHECK(f.poll(40) == list(4));
+        CHECK(f.wheel.cancelled() == 1);
+
+        // Handles of timers that were never allocated are ignored.
+        f.client.cancel((static_cast<timer_handle>(1) << 32) | 1000);
+        CHECK(f.poll(41).empty());
+    }
+
+    void TestOverflowRescan()
+    {
+        fixture f(8);
+        f.client.schedule(OverflowTicks + 5, 1);
+        f.client.schedule(2 * OverflowTicks + 3, 2);
+        f.client.schedule(OverflowTicks - 1, 3);
+        f.client.schedule(OverflowTicks, 4);
+        f.client.schedule(3 * OverflowTicks, 5);
+
+        CHECK(f.poll(OverflowTicks - 2).empty());
+        CHECK(f.poll(OverflowTicks - 1) == list(3));
+        CHECK(f.poll(OverflowTicks) == list(4));
+        CHECK(f.poll(OverflowTicks + 4).empty());
+        CHECK(f.poll(OverflowTicks + 5) == list(1));
+        CHECK(f.poll(2 * OverflowTicks + 2).empty());
+        CHECK(f.wheel.pending() == 2);
+        CHECK(f.poll(2 * OverflowTicks + 3) == list(2));
+        CHECK(f.poll(3 * OverflowTicks - 1).empty());
+        CHECK(f.poll(3 * OverflowTicks) == list(5));
+        CHECK(f.wheel.pending() == 0);
+
+        // Cancelling a timer in the overflow list.
+        const timer_handle a = f.client.schedule(5 * OverflowTicks, 6);
+        f.client.cancel(a);
+        CHECK(f.poll(6 * OverflowTicks).empty());
+        CHECK(f.wheel.cancelled() == 1);
+    }
+
+    void TestOverflowRescanInOnePoll()
+    {
+        // Start just short of a boundary so the first rescan comes early.
+        fixture f(4, OverflowTicks - 10);
+        f.client.schedule(3 * OverflowTicks + 1, 1);
+        f.client.schedule(OverflowTicks + 1, 2);
+        f.client.schedule(2 * OverflowTicks, 3);
+        CHECK(f.poll(4 * OverflowTicks) == list(2, 3, 1));
+        CHECK(f.wheel.pending() == 0);
+        CHECK(f.wheel.now() == 4 * OverflowTicks + 1);
+    }
+}
+
+int main()
+{
+    TestExpiresAtDeadline();
+    TestDeadlineBeforeNow();
+    TestCancel();
+    TestCancelAfterExpiry();
+    TestStaleHandle();
+    TestOverflowRescan();
+    TestOverflowRescanInOnePoll();
+    return test::report();
+}